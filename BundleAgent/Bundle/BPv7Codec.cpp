@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BPv7Codec.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the BPv7 codec.
+ */
+
+#include "Bundle/BPv7Codec.h"
+#include <bitset>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "Bundle/BundleTypes.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Utils/CBOR.h"
+#include "Utils/CRC32C.h"
+#include "Utils/SDNV.h"
+
+namespace {
+
+/**
+ * Version of the protocol.
+ */
+const uint64_t VERSION = 7;
+/**
+ * Types of the block CRCs.
+ */
+const uint64_t CRC_NONE = 0;
+const uint64_t CRC_16 = 1;
+const uint64_t CRC_32C = 2;
+/**
+ * Bundle processing flags shared by BPv7 and the RFC 5050: fragment,
+ * administrative record, must not be fragmented, acknowledgement requested,
+ * status time requested, and the reception, forwarding, delivery and
+ * deletion reports.
+ */
+const uint64_t BUNDLE_FLAGS = 0x01 | 0x02 | 0x04 | 0x20 | 0x40 | 0x4000
+    | 0x10000 | 0x20000 | 0x40000;
+/**
+ * Block processing flags shared by BPv7 and the RFC 5050: replicate in every
+ * fragment, report, delete the bundle and discard the block if the block can
+ * not be processed.
+ */
+const uint64_t BLOCK_FLAGS = 0x01 | 0x02 | 0x04 | 0x10;
+/**
+ * Number of the payload block.
+ */
+const uint64_t PAYLOAD_BLOCK_NUMBER = 1;
+/**
+ * Milliseconds of a second, the BPv7 times are in milliseconds.
+ */
+const uint64_t MILLISECONDS = 1000;
+/**
+ * Codes of the endpoint schemes.
+ */
+const uint64_t DTN_SCHEME = 1;
+const uint64_t IPN_SCHEME = 2;
+/**
+ * Endpoint used when a field is empty.
+ */
+const char NULL_ENDPOINT[] = "none";
+/**
+ * Prefix of the ipn endpoints, and of the dtn scheme specific parts.
+ */
+const std::string IPN_PREFIX = "ipn:";
+const std::string DTN_PREFIX = "//";
+
+/**
+ * Reads a string of the given length and moves data after it.
+ */
+std::string readString(const uint8_t *&data, const uint8_t *end,
+                       uint64_t length) {
+  if (length > static_cast<uint64_t>(end - data)) {
+    throw std::out_of_range("[BPv7Codec] String out of the buffer");
+  }
+  std::string value(reinterpret_cast<const char*>(data), length);
+  data += length;
+  return value;
+}
+
+/**
+ * Checks if an endpoint is an ipn one, "ipn:node.service", and gets its
+ * numbers.
+ */
+bool parseIpnEndpoint(const std::string &endpoint, uint64_t &node,
+                      uint64_t &service) {
+  if (endpoint.compare(0, IPN_PREFIX.size(), IPN_PREFIX) != 0
+      || endpoint.find_first_not_of("0123456789.", IPN_PREFIX.size())
+          != std::string::npos) {
+    return false;
+  }
+  size_t dot = endpoint.find('.', IPN_PREFIX.size());
+  if (dot == std::string::npos || dot == IPN_PREFIX.size()
+      || dot + 1 == endpoint.size()
+      || endpoint.find('.', dot + 1) != std::string::npos) {
+    return false;
+  }
+  try {
+    node = std::stoull(endpoint.substr(IPN_PREFIX.size(),
+                                       dot - IPN_PREFIX.size()));
+    service = std::stoull(endpoint.substr(dot + 1));
+  } catch (const std::out_of_range &e) {
+    return false;
+  }
+  return true;
+}
+
+bool isNullEndpoint(const std::string &endpoint) {
+  return endpoint.empty() || endpoint == NULL_ENDPOINT;
+}
+
+void encodeEndpoint(const std::string &endpoint, std::string &buffer) {
+  CBOR::appendHead(buffer, CBOR::ARRAY, 2);
+  uint64_t node, service;
+  if (isNullEndpoint(endpoint)) {
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, DTN_SCHEME);
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 0);
+  } else if (parseIpnEndpoint(endpoint, node, service)) {
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, IPN_SCHEME);
+    CBOR::appendHead(buffer, CBOR::ARRAY, 2);
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, node);
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, service);
+  } else {
+    // The node id and the application, "node:demux", become
+    // "//node/demux".
+    std::string ssp = DTN_PREFIX + endpoint;
+    size_t colon = ssp.find(':');
+    if (colon == std::string::npos) {
+      ssp.push_back('/');
+    } else {
+      ssp[colon] = '/';
+    }
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, DTN_SCHEME);
+    CBOR::appendHead(buffer, CBOR::TEXT_STRING, ssp.size());
+    buffer.append(ssp);
+  }
+}
+
+std::string decodeEndpoint(const uint8_t *&data, const uint8_t *end) {
+  if (CBOR::decodeHead(data, end, CBOR::ARRAY) != 2) {
+    throw std::invalid_argument("[BPv7Codec] Bad endpoint");
+  }
+  uint64_t scheme = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  if (scheme == DTN_SCHEME) {
+    uint8_t type;
+    uint64_t value;
+    data += CBOR::decodeHead(data, end, type, value);
+    if (type == CBOR::UNSIGNED_INTEGER && value == 0) {
+      return NULL_ENDPOINT;
+    }
+    if (type != CBOR::TEXT_STRING) {
+      throw std::invalid_argument("[BPv7Codec] Bad dtn endpoint");
+    }
+    std::string ssp = readString(data, end, value);
+    size_t slash = ssp.find('/', DTN_PREFIX.size());
+    if (ssp.compare(0, DTN_PREFIX.size(), DTN_PREFIX) != 0
+        || slash == std::string::npos || slash == DTN_PREFIX.size()) {
+      throw std::invalid_argument("[BPv7Codec] Bad dtn endpoint");
+    }
+    std::string endpoint = ssp.substr(DTN_PREFIX.size(),
+                                      slash - DTN_PREFIX.size());
+    if (slash + 1 < ssp.size()) {
+      endpoint += ":" + ssp.substr(slash + 1);
+    }
+    return endpoint;
+  } else if (scheme == IPN_SCHEME) {
+    if (CBOR::decodeHead(data, end, CBOR::ARRAY) != 2) {
+      throw std::invalid_argument("[BPv7Codec] Bad ipn endpoint");
+    }
+    uint64_t node = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+    uint64_t service = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+    return IPN_PREFIX + std::to_string(node) + "." + std::to_string(service);
+  }
+  throw std::invalid_argument("[BPv7Codec] Unknown endpoint scheme");
+}
+
+/**
+ * Extends a CRC-16 X.25 like CRC32C::extend does.
+ */
+uint16_t extendCRC16(uint16_t crc, const uint8_t *data, size_t length) {
+  crc = ~crc;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+/**
+ * Appends the CRC-32C field of a block, crc is the one of the block before
+ * the field. The CRC is computed over the block with the field filled with
+ * zeros.
+ */
+void appendCRC32C(uint32_t crc, std::string &buffer) {
+  size_t start = buffer.size();
+  CBOR::appendHead(buffer, CBOR::BYTE_STRING, 4);
+  const char zeros[4] = { 0, 0, 0, 0 };
+  crc = CRC32C::extend(crc, buffer.data() + start, buffer.size() - start);
+  crc = CRC32C::extend(crc, zeros, sizeof(zeros));
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    buffer.push_back(static_cast<char>(crc >> shift));
+  }
+}
+
+/**
+ * Reads the CRC field of the block that starts at blockStart and checks it
+ * against the block, moving data after it.
+ */
+void checkCRC(uint64_t crcType, const uint8_t *blockStart,
+              const uint8_t *&data, const uint8_t *end) {
+  if (crcType == CRC_NONE) {
+    return;
+  }
+  size_t length = crcType == CRC_16 ? 2 : 4;
+  if (CBOR::decodeHead(data, end, CBOR::BYTE_STRING) != length) {
+    throw std::invalid_argument("[BPv7Codec] Bad CRC length");
+  }
+  if (length > static_cast<size_t>(end - data)) {
+    throw std::out_of_range("[BPv7Codec] CRC out of the buffer");
+  }
+  const uint8_t zeros[4] = { 0, 0, 0, 0 };
+  uint32_t crc;
+  if (crcType == CRC_16) {
+    crc = extendCRC16(extendCRC16(0, blockStart, data - blockStart), zeros,
+                      length);
+  } else {
+    crc = CRC32C::extend(
+        CRC32C::compute(reinterpret_cast<const char*>(blockStart),
+                        data - blockStart),
+        reinterpret_cast<const char*>(zeros), length);
+  }
+  uint32_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    value = (value << 8) | data[i];
+  }
+  if (value != crc) {
+    throw std::invalid_argument("[BPv7Codec] The block does not match its CRC");
+  }
+  data += length;
+}
+
+uint64_t decodeCRCType(const uint8_t *&data, const uint8_t *end) {
+  uint64_t crcType = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  if (crcType > CRC_32C) {
+    throw std::invalid_argument("[BPv7Codec] Unknown CRC type");
+  }
+  return crcType;
+}
+
+}  // namespace
+
+bool BPv7Codec::isBPv7(const char *data, size_t size) {
+  // The primary block is an array of 8 to 11 items.
+  return size > 2 && static_cast<uint8_t>(data[0]) == CBOR::INDEFINITE_ARRAY
+      && static_cast<uint8_t>(data[1]) >= 0x88
+      && static_cast<uint8_t>(data[1]) <= 0x8B
+      && static_cast<uint8_t>(data[2]) == VERSION;
+}
+
+void BPv7Codec::encodePrimaryBlock(const PrimaryBlock &primaryBlock,
+                                   std::string &buffer) {
+  /**
+   * Primary Block format
+   *
+   * Array of 9 items, 11 if it is a fragment
+   * Version - unsigned integer, always 7
+   * Proc. Flags - unsigned integer
+   * CRC type - unsigned integer, always CRC-32C
+   * Destination - endpoint
+   * Source - endpoint
+   * ReportTo - endpoint
+   * Creation timestamp - array of 2 unsigned integers, DTN time in
+   *                      milliseconds and seq. number
+   * Lifetime - unsigned integer, in milliseconds
+   * Fragment offset (if IS_FRAGMENT flag is active) - unsigned integer
+   * Application Data length (if IS_FRAGMENT flag is active) - unsigned integer
+   * CRC - byte string
+   */
+  std::bitset<21> procFlags = primaryBlock.getProcFlags();
+  if (!isNullEndpoint(primaryBlock.getCustodian())
+      || procFlags.test(
+          static_cast<uint32_t>(PrimaryBlockControlFlags::CUSTODY_TRANSFER))) {
+    throw std::invalid_argument(
+        "[BPv7Codec] Bundles with custody can not be encoded");
+  }
+  bool fragment = procFlags.test(
+      static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT));
+  size_t start = buffer.size();
+  CBOR::appendHead(buffer, CBOR::ARRAY, fragment ? 11 : 9);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, VERSION);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                   procFlags.to_ulong() & BUNDLE_FLAGS);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, CRC_32C);
+  encodeEndpoint(primaryBlock.getDestination(), buffer);
+  encodeEndpoint(primaryBlock.getSource(), buffer);
+  encodeEndpoint(primaryBlock.getReportTo(), buffer);
+  CBOR::appendHead(buffer, CBOR::ARRAY, 2);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                   primaryBlock.getCreationTimestamp() * MILLISECONDS);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                   primaryBlock.getCreationTimestampSeqNumber());
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                   primaryBlock.getLifetime() * MILLISECONDS);
+  if (fragment) {
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                     primaryBlock.getFragmentOffset());
+    CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                     primaryBlock.getTotalApplicationDataLength());
+  }
+  appendCRC32C(CRC32C::compute(buffer.data() + start, buffer.size() - start),
+               buffer);
+}
+
+size_t BPv7Codec::encodeCanonicalBlockHead(const char *raw, size_t length,
+                                           uint64_t blockNumber,
+                                           std::string &buffer) {
+  /**
+   * Canonical Block format
+   *
+   * Array of 6 items
+   * Block type - unsigned integer, the RFC 5050 one
+   * Block number - unsigned integer
+   * Proc. Flags - unsigned integer
+   * CRC type - unsigned integer, always CRC-32C
+   * Block data - byte string
+   * CRC - byte string
+   */
+  if (length == 0) {
+    throw std::out_of_range("[BPv7Codec] Empty block");
+  }
+  const uint8_t *start = reinterpret_cast<const uint8_t*>(raw);
+  const uint8_t *end = start + length;
+  const uint8_t *position = start + 1;
+  uint64_t value;
+  position += SDNV::decode(position, end, value);
+  std::bitset<7> procFlags(value);
+  if (procFlags.test(
+      static_cast<uint32_t>(CanonicalBlockControlFlags::EID_FIELD))) {
+    throw std::invalid_argument(
+        "[BPv7Codec] Blocks with EID references can not be encoded");
+  }
+  uint64_t dataLength;
+  position += SDNV::decode(position, end, dataLength);
+  if (dataLength != static_cast<uint64_t>(end - position)) {
+    throw std::out_of_range("[BPv7Codec] Bad block length");
+  }
+  CBOR::appendHead(buffer, CBOR::ARRAY, 6);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, start[0]);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, blockNumber);
+  // The last block is marked by the end of the array.
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER,
+                   procFlags.to_ulong() & BLOCK_FLAGS);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, CRC_32C);
+  CBOR::appendHead(buffer, CBOR::BYTE_STRING, dataLength);
+  return position - start;
+}
+
+void BPv7Codec::encodeCanonicalBlockCRC(const char *head, size_t headLength,
+                                        const char *data, size_t dataLength,
+                                        std::string &buffer) {
+  appendCRC32C(CRC32C::extend(CRC32C::compute(head, headLength), data,
+                              dataLength), buffer);
+}
+
+std::shared_ptr<PrimaryBlock> BPv7Codec::decodePrimaryBlock(
+    const uint8_t *&data, const uint8_t *end,
+    const std::shared_ptr<Arena> &arena) {
+  const uint8_t *blockStart = data;
+  uint64_t fields = CBOR::decodeHead(data, end, CBOR::ARRAY);
+  if (CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER) != VERSION) {
+    throw std::invalid_argument("[BPv7Codec] Bad version");
+  }
+  std::bitset<21> procFlags(CBOR::decodeHead(data, end,
+                                             CBOR::UNSIGNED_INTEGER)
+                            & BUNDLE_FLAGS);
+  uint64_t crcType = decodeCRCType(data, end);
+  bool fragment = procFlags.test(
+      static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT));
+  if (fields != 8u + (fragment ? 2 : 0) + (crcType != CRC_NONE ? 1 : 0)) {
+    throw std::invalid_argument("[BPv7Codec] Bad primary block");
+  }
+  std::string destination = decodeEndpoint(data, end);
+  std::string source = decodeEndpoint(data, end);
+  std::string reportTo = decodeEndpoint(data, end);
+  if (CBOR::decodeHead(data, end, CBOR::ARRAY) != 2) {
+    throw std::invalid_argument("[BPv7Codec] Bad creation timestamp");
+  }
+  uint64_t timestamp = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  uint64_t seqNumber = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  uint64_t lifetime = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  std::shared_ptr<PrimaryBlock> primaryBlock = makeShared<PrimaryBlock>(
+      arena, source, destination, timestamp / MILLISECONDS, seqNumber);
+  primaryBlock->setReportTo(reportTo);
+  // The bundle does not expire before its lifetime.
+  primaryBlock->setLifetime(lifetime / MILLISECONDS
+                            + (lifetime % MILLISECONDS != 0 ? 1 : 0));
+  primaryBlock->setProcFlags(procFlags);
+  if (fragment) {
+    uint64_t offset = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+    uint64_t totalLength = CBOR::decodeHead(data, end,
+                                            CBOR::UNSIGNED_INTEGER);
+    primaryBlock->setFragment(offset, totalLength);
+  }
+  checkCRC(crcType, blockStart, data, end);
+  return primaryBlock;
+}
+
+uint64_t BPv7Codec::decodeCanonicalBlock(const uint8_t *&data,
+                                         const uint8_t *end,
+                                         std::string &buffer) {
+  const uint8_t *blockStart = data;
+  uint64_t fields = CBOR::decodeHead(data, end, CBOR::ARRAY);
+  uint64_t blockType = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  if (blockType == 0 || blockType > 0xFF) {
+    throw std::invalid_argument("[BPv7Codec] Bad block type");
+  }
+  uint64_t blockNumber = CBOR::decodeHead(data, end, CBOR::UNSIGNED_INTEGER);
+  if (blockNumber == 0
+      || (blockNumber == PAYLOAD_BLOCK_NUMBER)
+          != (blockType == static_cast<uint8_t>(
+              CanonicalBlockTypes::PAYLOAD_BLOCK))) {
+    throw std::invalid_argument("[BPv7Codec] Bad block number");
+  }
+  std::bitset<7> procFlags(CBOR::decodeHead(data, end,
+                                            CBOR::UNSIGNED_INTEGER)
+                           & BLOCK_FLAGS);
+  uint64_t crcType = decodeCRCType(data, end);
+  if (fields != (crcType != CRC_NONE ? 6u : 5u)) {
+    throw std::invalid_argument("[BPv7Codec] Bad canonical block");
+  }
+  uint64_t dataLength = CBOR::decodeHead(data, end, CBOR::BYTE_STRING);
+  if (dataLength > static_cast<uint64_t>(end - data)) {
+    throw std::out_of_range("[BPv7Codec] Block data out of the buffer");
+  }
+  const uint8_t *blockData = data;
+  data += dataLength;
+  checkCRC(crcType, blockStart, data, end);
+  procFlags.set(static_cast<uint32_t>(CanonicalBlockControlFlags::LAST_BLOCK),
+                data < end && *data == CBOR::BREAK);
+  buffer.push_back(static_cast<char>(blockType));
+  buffer.append(SDNV::encode(procFlags.to_ulong()));
+  buffer.append(SDNV::encode(dataLength));
+  buffer.append(reinterpret_cast<const char*>(blockData), dataLength);
+  return blockNumber;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BPv7Codec.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the functions that convert the blocks to and from the
+ * BPv7 encoding of the RFC 9171.
+ */
+#ifndef BUNDLEAGENT_BUNDLE_BPV7CODEC_H_
+#define BUNDLEAGENT_BUNDLE_BPV7CODEC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Utils/Arena.h"
+
+class PrimaryBlock;
+
+/**
+ * A BPv7 bundle is an indefinite length CBOR array with the primary block
+ * followed by the canonical blocks, as described into the RFC 9171.
+ *
+ * The primary block has the version 7, no dictionary and a CRC-32C. The
+ * endpoints are encoded with the dtn scheme, "node:demux" as
+ * "dtn://node/demux", or with the ipn scheme if they start with "ipn:". The
+ * times are in milliseconds, the blocks keep seconds. The processing flags
+ * that BPv7 shares with the RFC 5050 are kept, the priority, the singleton
+ * and the custody flags are not. BPv7 has no custody transfer, so the bundles
+ * with a custodian can not be encoded.
+ *
+ * The canonical blocks keep their types and data, and carry a block number,
+ * 1 for the payload block, and a CRC-32C. The payload block goes last. The
+ * IntegrityMEB is not encoded, its checksums are of the RFC 5050 blocks, the
+ * CRCs of the blocks are checked instead when they are decoded. The blocks
+ * are decoded into RFC 5050 raw format, the CRC types 0, CRC-16 and CRC-32C
+ * are accepted.
+ *
+ * All the functions throw std::out_of_range or std::invalid_argument if the
+ * data can not be encoded or decoded.
+ */
+namespace BPv7Codec {
+  /**
+   * Length of the CRC field of a block, the head of the byte string and the
+   * CRC-32C.
+   */
+  const size_t CRC_FIELD_LENGTH = 5;
+  /**
+   * @brief Checks if a raw bundle is encoded in BPv7.
+   *
+   * The RFC 5050 bundles start with the version byte 0x06, the BPv7 ones
+   * with the start of an indefinite length array, 0x9F, the head of the
+   * primary block array and the version 0x07.
+   *
+   * @param data The raw bundle.
+   * @param size The length of the raw bundle.
+   * @return True if it is a BPv7 bundle.
+   */
+  bool isBPv7(const char *data, size_t size);
+  /**
+   * @brief Appends the BPv7 encoding of a primary block, with its CRC.
+   *
+   * @param primaryBlock The block to encode.
+   * @param buffer The buffer to append to.
+   */
+  void encodePrimaryBlock(const PrimaryBlock &primaryBlock,
+                          std::string &buffer);
+  /**
+   * @brief Appends the BPv7 head of a canonical block.
+   *
+   * The head is formed by all the fields before the block data and the head
+   * of the byte string with the block data, that is not copied. The CRC goes
+   * after the block data, it is appended with encodeCanonicalBlockCRC().
+   *
+   * @param raw The block in RFC 5050 raw format.
+   * @param length The length of the raw block.
+   * @param blockNumber The number of the block into the bundle.
+   * @param buffer The buffer to append to.
+   * @return The position of the block data into the raw block.
+   */
+  size_t encodeCanonicalBlockHead(const char *raw, size_t length,
+                                  uint64_t blockNumber, std::string &buffer);
+  /**
+   * @brief Appends the CRC field of a canonical block.
+   *
+   * @param head The head of the block, from encodeCanonicalBlockHead().
+   * @param headLength The length of the head.
+   * @param data The block data.
+   * @param dataLength The length of the block data.
+   * @param buffer The buffer to append to.
+   */
+  void encodeCanonicalBlockCRC(const char *head, size_t headLength,
+                               const char *data, size_t dataLength,
+                               std::string &buffer);
+  /**
+   * @brief Decodes a BPv7 primary block and checks its CRC.
+   *
+   * @param data Pointer to the first byte of the block, moved after it.
+   * @param end Pointer past the last readable byte.
+   * @param arena The arena to allocate from, or nullptr to use the heap.
+   * @return The decoded block.
+   */
+  std::shared_ptr<PrimaryBlock> decodePrimaryBlock(
+      const uint8_t *&data, const uint8_t *end,
+      const std::shared_ptr<Arena> &arena = nullptr);
+  /**
+   * @brief Decodes a BPv7 canonical block into RFC 5050 raw format and checks
+   * its CRC.
+   *
+   * The block is marked as the last one if the bundle ends after it.
+   *
+   * @param data Pointer to the first byte of the block, moved after it.
+   * @param end Pointer past the last readable byte.
+   * @param buffer The buffer where the raw block is appended.
+   * @return The number of the block.
+   */
+  uint64_t decodeCanonicalBlock(const uint8_t *&data, const uint8_t *end,
+                                std::string &buffer);
+}
+
+#endif  // BUNDLEAGENT_BUNDLE_BPV7CODEC_H_
@@ -25,24 +25,97 @@
 #include "Bundle/Block.h"
 
 #include <string>
+#include <memory>
+#include <utility>
 #include "Utils/SDNV.h"
 #include "Utils/Logger.h"
 
 Block::Block()
-    : m_raw("") {
+    : m_rawBuffer(std::make_shared<const std::string>()),
+      m_rawOffset(0),
+      m_rawLength(0),
+      m_dirty(true) {
 }
 
 Block::Block(std::string rawData)
-    : m_raw(rawData) {
+    : m_rawBuffer(),
+      m_rawOffset(0),
+      m_rawLength(0),
+      m_dirty(false) {
+  setRaw(std::move(rawData));
+}
+
+Block::Block(const std::shared_ptr<const std::string> &buffer, size_t offset,
+             size_t length)
+    : m_rawBuffer(buffer),
+      m_rawOffset(offset),
+      m_rawLength(length),
+      m_dirty(false) {
 }
 
 Block::~Block() {
 }
 
 std::string Block::getRaw() {
-  return m_raw;
+  return std::string(getRawData(), m_rawLength);
 }
 
 size_t Block::getLength() {
-  return m_raw.size();
+  return m_rawLength;
+}
+
+void Block::setRaw(std::string raw) {
+  m_rawLength = raw.size();
+  m_rawOffset = 0;
+  m_rawBuffer = std::make_shared<const std::string>(std::move(raw));
+  m_rawFile.reset();
+  m_dirty = false;
+}
+
+void Block::setRaw(const std::shared_ptr<const std::string> &buffer,
+                   size_t offset, size_t length) {
+  m_rawBuffer = buffer;
+  m_rawFile.reset();
+  m_rawOffset = offset;
+  m_rawLength = length;
+  m_dirty = false;
+}
+
+void Block::setRaw(const std::shared_ptr<const MappedFile> &file,
+                   size_t offset, size_t length) {
+  m_rawBuffer.reset();
+  m_rawFile = file;
+  m_rawOffset = offset;
+  m_rawLength = length;
+  m_dirty = false;
+}
+
+RawSegment Block::getRawSegment() const {
+  return RawSegment { m_rawBuffer, m_rawOffset, m_rawLength, m_rawFile };
+}
+
+void Block::updateRaw() {
+  toRaw();
+}
+
+void Block::shareRaw(const std::shared_ptr<const std::string> &buffer,
+                     size_t offset) {
+  if (!m_dirty) {
+    setRaw(buffer, offset, m_rawLength);
+  }
+}
+
+bool Block::isDirty() const {
+  return m_dirty;
+}
+
+void Block::setDirty() {
+  m_dirty = true;
+}
+
+const char* Block::getRawData() const {
+  if (m_rawFile) {
+    return m_rawFile->data() + m_rawOffset;
+  }
+  return m_rawBuffer->data() + m_rawOffset;
 }
@@ -27,8 +27,10 @@
 #include <cstdint>
 #include <bitset>
 #include <string>
+#include <memory>
 #include <stdexcept>
 #include "Bundle/BundleTypes.h"
+#include "Utils/MappedFile.h"
 
 class BlockConstructionException : public std::runtime_error {
  public:
@@ -37,6 +39,37 @@ class BlockConstructionException : public std::runtime_error {
   }
 };
 
+/**
+ * Piece of raw data inside a shared buffer, the buffer keeps the bytes alive
+ * while the segment is in use.
+ */
+struct RawSegment {
+  /**
+   * Buffer that holds the bytes.
+   */
+  std::shared_ptr<const std::string> buffer;
+  /**
+   * Position of the first byte into the buffer.
+   */
+  size_t offset;
+  /**
+   * Number of bytes.
+   */
+  size_t length;
+  /**
+   * Mapped file that holds the bytes instead of the buffer, if any.
+   */
+  std::shared_ptr<const MappedFile> file;
+  /**
+   * @brief Returns a pointer to the first byte of the segment.
+   *
+   * @return The pointer to the bytes.
+   */
+  const char* data() const {
+    return (file ? file->data() : buffer->data()) + offset;
+  }
+};
+
 /**
  * CLASS Block
  * This class represents a block as described into the RFC 5050.
@@ -58,10 +91,48 @@ class Block {
    * @param rawData
    */
   explicit Block(std::string rawData);
+  /**
+   * @brief View constructor.
+   *
+   * Generates a block whose raw bytes are a view of the given buffer.
+   *
+   * @param buffer The buffer that holds the raw bytes.
+   * @param offset The position of the block into the buffer.
+   * @param length The length of the block.
+   */
+  Block(const std::shared_ptr<const std::string> &buffer, size_t offset,
+        size_t length);
   /**
    * Destructor of the class.
    */
   virtual ~Block();
+  /**
+   * @brief Function to know if the block has changed since its raw format was
+   * generated.
+   *
+   * @return True if the block needs to be converted to raw again.
+   */
+  bool isDirty() const;
+  /**
+   * @brief Function to get the block in raw format without copying it.
+   *
+   * Like getRaw() it provides the last raw version of the block.
+   *
+   * @return the segment of the buffer that holds the raw block.
+   */
+  RawSegment getRawSegment() const;
+  /**
+   * @brief Moves the raw block into another buffer.
+   *
+   * The buffer must hold a copy of the current raw block at the given
+   * position. The block becomes a view of it and its own raw is released, so
+   * the blocks of a bundle can share one buffer. Changed blocks are not moved.
+   *
+   * @param buffer The buffer that holds the raw block.
+   * @param offset The position of the block into the buffer.
+   */
+  void shareRaw(const std::shared_ptr<const std::string> &buffer,
+                size_t offset);
   /**
    * @brief Function to get the block in raw format.
    *
@@ -81,6 +152,13 @@ class Block {
    * @return the block in raw format.
    */
   virtual std::string toRaw() = 0;
+  /**
+   * @brief Function to update the block in raw format without returning it.
+   *
+   * Like toRaw(), but the raw block is only kept into the block, so blocks
+   * with big data can avoid the copy of the returned string.
+   */
+  virtual void updateRaw();
   /**
    * @brief Returns the size of this block.
    *
@@ -96,9 +174,67 @@ class Block {
 
  protected:
   /**
-   * Byte array containing the piece of raw bundle that corresponds to this block.
+   * @brief Sets a new raw for the block.
+   *
+   * The block takes the ownership of the raw, and stops sharing the buffer
+   * it was parsed from. The block is no longer dirty.
+   *
+   * @param raw The new raw.
+   */
+  void setRaw(std::string raw);
+  /**
+   * @brief Sets the raw of the block as a view of a shared buffer.
+   * The block is no longer dirty.
+   *
+   * @param buffer The buffer that holds the raw bytes.
+   * @param offset The position of the block into the buffer.
+   * @param length The length of the block.
+   */
+  void setRaw(const std::shared_ptr<const std::string> &buffer, size_t offset,
+              size_t length);
+  /**
+   * @brief Sets the raw of the block as a view of a mapped file.
+   * The block is no longer dirty.
+   *
+   * @param file The mapped file that holds the raw bytes.
+   * @param offset The position of the block into the file.
+   * @param length The length of the block.
+   */
+  void setRaw(const std::shared_ptr<const MappedFile> &file, size_t offset,
+              size_t length);
+  /**
+   * @brief Returns a pointer to the first raw byte of the block.
+   *
+   * @return The pointer to the raw bytes.
+   */
+  const char* getRawData() const;
+  /**
+   * @brief Marks the block as changed, so its raw must be generated again.
+   *
+   * Every function that modifies the block must call it.
+   */
+  void setDirty();
+  /**
+   * Buffer containing the piece of raw bundle that corresponds to this block.
+   * It can be shared with the bundle and the other blocks parsed from it.
+   */
+  std::shared_ptr<const std::string> m_rawBuffer;
+  /**
+   * Mapped file containing the raw block instead of the raw buffer, if any.
+   */
+  std::shared_ptr<const MappedFile> m_rawFile;
+  /**
+   * Position of the block into the raw buffer.
+   */
+  size_t m_rawOffset;
+  /**
+   * Length of the block into the raw buffer.
+   */
+  size_t m_rawLength;
+  /**
+   * True if the block has changed since its raw was set.
    */
-  std::string m_raw;
+  bool m_dirty;
 };
 
 #endif  // BUNDLEAGENT_BUNDLE_BLOCK_H_
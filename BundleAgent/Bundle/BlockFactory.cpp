@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BlockFactory.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the BlockFactory class.
+ */
+
+#include "Bundle/BlockFactory.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "Bundle/BundleTypes.h"
+#include "Bundle/CanonicalBlock.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/CodeDataCarrierMEB.h"
+#include "Bundle/FrameworkMEB.h"
+#include "Bundle/CompressionMEB.h"
+#include "Bundle/IntegrityMEB.h"
+#include "Utils/Logger.h"
+
+BlockFactory* BlockFactory::getInstance() {
+  static BlockFactory instance;
+  return &instance;
+}
+
+BlockFactory::BlockFactory() {
+  for (size_t i = 0; i < NUM_TYPES; ++i) {
+    m_canonicalParsers[i] = nullptr;
+    m_metadataParsers[i] = nullptr;
+  }
+  m_canonicalParsers[static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)] =
+      &parse<PayloadBlock>;
+  m_canonicalParsers[static_cast<uint8_t>(
+      CanonicalBlockTypes::METADATA_EXTENSION_BLOCK)] =
+      &parse<MetadataExtensionBlock>;
+  registerMetadataBlock<RoutingSelectionMEB>(
+      static_cast<uint8_t>(MetadataTypes::ROUTING_SELECTION_MEB));
+  registerMetadataBlock<ForwardingMEB>(
+      static_cast<uint8_t>(MetadataTypes::FORWARDING_MEB));
+  registerMetadataBlock<RouteReportingMEB>(
+      static_cast<uint8_t>(MetadataTypes::ROUTE_REPORTING_MEB));
+  registerMetadataBlock<CodeDataCarrierMEB>(
+      static_cast<uint8_t>(MetadataTypes::CODE_DATA_CARRIER_MEB));
+  registerMetadataBlock<FrameworkMEB>(
+      static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB));
+  registerMetadataBlock<CompressionMEB>(
+      static_cast<uint8_t>(MetadataTypes::COMPRESSION_MEB));
+  registerMetadataBlock<IntegrityMEB>(
+      static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB));
+}
+
+BlockFactory::~BlockFactory() {
+}
+
+std::shared_ptr<CanonicalBlock> BlockFactory::create(
+    uint8_t blockType, uint8_t metadataType,
+    const std::shared_ptr<const std::string> &buffer, size_t offset,
+    const std::shared_ptr<Arena> &arena) const {
+  BlockParser parser = nullptr;
+  if (blockType
+      == static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK)) {
+    LOG(81) << "Generating Metadata Extension Block of type "
+            << static_cast<int>(metadataType);
+    parser = m_metadataParsers[metadataType].load(std::memory_order_acquire);
+  }
+  if (parser == nullptr) {
+    LOG(81) << "Generating Block of type " << static_cast<int>(blockType);
+    parser = m_canonicalParsers[blockType].load(std::memory_order_acquire);
+  }
+  if (parser == nullptr) {
+    parser = &parse<CanonicalBlock>;
+  }
+  return parser(buffer, offset, arena);
+}
+
+void BlockFactory::registerCanonicalBlock(uint8_t blockType,
+                                          BlockParser parser) {
+  if (blockType == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)
+      || blockType
+          == static_cast<uint8_t>(
+              CanonicalBlockTypes::METADATA_EXTENSION_BLOCK)) {
+    throw std::invalid_argument(
+        "[BlockFactory] The payload and metadata parsers can not be replaced");
+  }
+  m_canonicalParsers[blockType].store(parser, std::memory_order_release);
+}
+
+void BlockFactory::registerMetadataBlock(uint8_t metadataType,
+                                         BlockParser parser) {
+  m_metadataParsers[metadataType].store(parser, std::memory_order_release);
+}
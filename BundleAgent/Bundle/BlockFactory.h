@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BlockFactory.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the class BlockFactory.
+ */
+#ifndef BUNDLEAGENT_BUNDLE_BLOCKFACTORY_H_
+#define BUNDLEAGENT_BUNDLE_BLOCKFACTORY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Utils/Arena.h"
+
+class CanonicalBlock;
+
+/**
+ * Function that generates a block from the raw block that starts at the given
+ * offset of the buffer. The block is taken from the arena if there is one.
+ */
+typedef std::shared_ptr<CanonicalBlock> (*BlockParser)(
+    const std::shared_ptr<const std::string> &buffer, size_t offset,
+    const std::shared_ptr<Arena> &arena);
+
+/**
+ * CLASS BlockFactory
+ * This class is a singleton that holds the parser of each block type.
+ *
+ * Canonical blocks are looked up by CanonicalBlockTypes and metadata extension
+ * blocks by MetadataTypes, both in constant time. The blocks known by the
+ * library are registered when the factory is created, plugins can register
+ * their own metadata extension blocks without modifying the Bundle class.
+ */
+class BlockFactory {
+ public:
+  /**
+   * @brief Singleton instance
+   *
+   * Function to get a reference to the singleton class.
+   *
+   * @return A pointer to the singleton.
+   */
+  static BlockFactory* getInstance();
+  /**
+   * Destructor of the class.
+   */
+  virtual ~BlockFactory();
+  /**
+   * @brief Generates a block.
+   *
+   * Unknown canonical block types generate a CanonicalBlock and unknown
+   * metadata types a MetadataExtensionBlock.
+   *
+   * @param blockType The canonical block type.
+   * @param metadataType The metadata type, only used for metadata extension
+   *                     blocks.
+   * @param buffer The buffer that holds the raw block.
+   * @param offset The position of the block into the buffer.
+   * @param arena The arena of the bundle, or nullptr to use the heap.
+   * @return The generated block.
+   */
+  std::shared_ptr<CanonicalBlock> create(
+      uint8_t blockType, uint8_t metadataType,
+      const std::shared_ptr<const std::string> &buffer, size_t offset,
+      const std::shared_ptr<Arena> &arena = nullptr) const;
+  /**
+   * @brief Registers the parser of a canonical block type.
+   *
+   * The payload and the metadata extension block types can not be replaced.
+   *
+   * @param blockType The canonical block type.
+   * @param parser The parser, or nullptr to remove it.
+   */
+  void registerCanonicalBlock(uint8_t blockType, BlockParser parser);
+  /**
+   * @brief Registers the parser of a metadata extension block type.
+   *
+   * @param metadataType The metadata type.
+   * @param parser The parser, or nullptr to remove it.
+   */
+  void registerMetadataBlock(uint8_t metadataType, BlockParser parser);
+  /**
+   * @brief Registers a canonical block class.
+   *
+   * The class must have a (buffer, offset) constructor.
+   *
+   * @param blockType The canonical block type.
+   */
+  template<class T>
+  void registerCanonicalBlock(uint8_t blockType) {
+    registerCanonicalBlock(blockType, &parse<T>);
+  }
+  /**
+   * @brief Registers a metadata extension block class.
+   *
+   * The class must have a (buffer, offset) constructor.
+   *
+   * @param metadataType The metadata type.
+   */
+  template<class T>
+  void registerMetadataBlock(uint8_t metadataType) {
+    registerMetadataBlock(metadataType, &parse<T>);
+  }
+  /**
+   * @brief Generic parser, constructs the block in place.
+   */
+  template<class T>
+  static std::shared_ptr<CanonicalBlock> parse(
+      const std::shared_ptr<const std::string> &buffer, size_t offset,
+      const std::shared_ptr<Arena> &arena) {
+    return makeShared<T>(arena, buffer, offset);
+  }
+
+ private:
+  /**
+   * Constructor of the BlockFactory, registers the library blocks.
+   */
+  BlockFactory();
+  /**
+   * Number of possible types.
+   */
+  static const size_t NUM_TYPES = 256;
+  /**
+   * Parsers of the canonical blocks, indexed by type.
+   */
+  std::atomic<BlockParser> m_canonicalParsers[NUM_TYPES];
+  /**
+   * Parsers of the metadata extension blocks, indexed by metadata type.
+   */
+  std::atomic<BlockParser> m_metadataParsers[NUM_TYPES];
+};
+
+#endif  // BUNDLEAGENT_BUNDLE_BLOCKFACTORY_H_
@@ -28,106 +28,173 @@
 #include <utility>
 #include <sstream>
 #include <map>
+#include <algorithm>
+#include <bitset>
+#include <set>
 #include "Bundle/BundleTypes.h"
 #include "Bundle/Block.h"
+#include "Bundle/BlockFactory.h"
 #include "Bundle/PrimaryBlock.h"
 #include "Bundle/CanonicalBlock.h"
 #include "Bundle/MetadataExtensionBlock.h"
-#include "Bundle/RoutingSelectionMEB.h"
-#include "Bundle/ForwardingMEB.h"
-#include "Bundle/RouteReportingMEB.h"
-#include "Bundle/CodeDataCarrierMEB.h"
 #include "Bundle/PayloadBlock.h"
 #include "Utils/TimestampManager.h"
+#include "Utils/Arena.h"
 #include "Utils/SDNV.h"
 #include "Utils/Logger.h"
+#include "Utils/CRC32C.h"
 #include "Bundle/FrameworkMEB.h"
 #include "Bundle/FrameworkExtension.h"
+#include "Bundle/CompressionMEB.h"
+#include "Bundle/IntegrityMEB.h"
+#include "Bundle/BPv7Codec.h"
+#include "Utils/CBOR.h"
 
 Bundle::Bundle(const std::string &rawData)
-    : m_raw(rawData),
+    : Bundle(rawData, nullptr) {
+}
+
+Bundle::Bundle(const std::string &rawData, const std::shared_ptr<Arena> &arena)
+    : Bundle(std::string(rawData), arena) {
+}
+
+Bundle::Bundle(std::string &&rawData, const std::shared_ptr<Arena> &arena)
+    : m_arena(arena),
+      m_raw(nullptr),
       m_primaryBlock(nullptr),
-      m_payloadBlock(nullptr) {
+      m_payloadBlock(nullptr),
+      m_convertedBlocks(0),
+      m_changed(false) {
   /**
    * A bundle is formed by a PrimaryBlock, and other blocks.
    * In this other blocks one of it must be a PayloadBlock.
+   * All the blocks are views of the same raw buffer, so the bundle data is
+   * not copied while parsing. Only the primary block is generated here, the
+   * other blocks are indexed and generated when requested.
+   * If the bundle has an arena the blocks are taken from it.
    */
   LOG(81) << "New Bundle from raw Data";
   // First generate a PrimaryBlock with the data.
   LOG(81) << "Generating Primary Block";
   try {
-    m_primaryBlock = std::shared_ptr<PrimaryBlock>(new PrimaryBlock(rawData));
-    m_blocks.push_back(m_primaryBlock);
+    if (BPv7Codec::isBPv7(rawData.data(), rawData.size())) {
+      parseBPv7(rawData.data(), rawData.size());
+      return;
+    }
+    m_raw = makeShared<const std::string>(m_arena, std::move(rawData));
+    const std::string &data = *m_raw;
+    m_primaryBlock = makeShared<PrimaryBlock>(m_arena, m_raw, 0);
+    m_blockIndex.reserve(INDEX_RESERVE);
+    m_blockIndex.push_back(BlockIndex { 0, 0, 0, m_primaryBlock->getLength() });
     // Skip the PrimaryBlock
-    std::string data = rawData.substr(m_primaryBlock->getLength());
-    // We now can start to generate the known blocks.
-    std::shared_ptr<Block> b;
-    while (data.size() != 0) {
-      switch (static_cast<CanonicalBlockTypes>(data[0])) {
-        case CanonicalBlockTypes::PAYLOAD_BLOCK: {
-          // Check if another payload block is present
-          if (m_payloadBlock == nullptr) {
-            LOG(81) << "Generating Payload Block";
-            b = std::shared_ptr<PayloadBlock>(new PayloadBlock(data, true));
-            m_payloadBlock = std::static_pointer_cast<PayloadBlock>(b);
-          } else {
-            throw BundleCreationException(
-                "[Bundle] More than one payload found");
-          }
-          break;
-        }
-        case CanonicalBlockTypes::METADATA_EXTENSION_BLOCK: {
-          // This is an abstraction of the metadata block, so we need to create
-          // a derived block of it.
-          LOG(81) << "Generating Metadata Extension Block";
-          auto m = MetadataExtensionBlock(data);
-          LOG(81) << std::to_string(m.getMetadataType());
-          switch (static_cast<MetadataTypes>(m.getMetadataType())) {
-            case MetadataTypes::ROUTING_SELECTION_MEB: {
-              b = std::make_shared<RoutingSelectionMEB>(
-                  RoutingSelectionMEB(data));
-              break;
-            }
-            case MetadataTypes::FORWARDING_MEB: {
-              LOG(81) << "Generating ForwardingMEB Block.";
-              b = std::make_shared<ForwardingMEB>(ForwardingMEB(data, true));
-              break;
-            }
-            case MetadataTypes::ROUTE_REPORTING_MEB: {
-              LOG(81) << "Generating RouteReporting Metadata Extension Block";
-              b = std::make_shared<RouteReportingMEB>(RouteReportingMEB(data));
-              break;
-            }
-            case MetadataTypes::CODE_DATA_CARRIER_MEB: {
-              LOG(81) << "Generating New Metadata Extension Block";
-              b = std::make_shared<CodeDataCarrierMEB>(
-                  CodeDataCarrierMEB(data));
-              break;
-            }
-            case MetadataTypes::FRAMEWORK_MEB: {
-              LOG(81) << "Generating New Framework Metadata Extension Block";
-              b = std::make_shared<FrameworkMEB>(FrameworkMEB(data));
-              break;
-            }
-          }
-          break;
+    size_t offset = m_primaryBlock->getLength();
+    bool payloadFound = false;
+    bool lastBlock = false;
+    // We now can start to index the blocks.
+    while (offset < data.size()) {
+      BlockIndex index = indexBlock(data.data(), data.size(), offset,
+                                    lastBlock);
+      if (index.blockType
+          == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+        // Check if another payload block is present
+        if (payloadFound) {
+          throw BundleCreationException("[Bundle] More than one payload found");
         }
-        default: {
-          LOG(81) << "Generating Canonical Block";
-          b = std::shared_ptr<CanonicalBlock>(new CanonicalBlock(data));
-          break;
+        payloadFound = true;
+      }
+      m_blockIndex.push_back(index);
+      offset += index.length;
+    }
+    if (!lastBlock) {
+      throw BundleCreationException("[Bundle] Last block not marked as such");
+    }
+    m_blocks.resize(m_blockIndex.size());
+    m_blocks[0] = m_primaryBlock;
+    updateFragmentKey();
+  } catch (const BundleCreationException &e) {
+    throw;
+  } catch (const BlockConstructionException &e) {
+    throw BundleCreationException(e.what());
+  } catch (const std::exception &e) {
+    throw BundleCreationException("[Bundle] Bad raw format");
+  }
+}
+
+Bundle::Bundle(const std::shared_ptr<const MappedFile> &file,
+               const std::shared_ptr<Arena> &arena)
+    : m_arena(arena),
+      m_raw(nullptr),
+      m_primaryBlock(nullptr),
+      m_payloadBlock(nullptr),
+      m_convertedBlocks(0),
+      m_changed(false) {
+  /**
+   * The bundle is indexed from the file, the primary block and the canonical
+   * blocks are copied into a raw buffer that does not contain the payload
+   * block. The payload block is generated at once as a view of the file, it
+   * is not into the raw buffer so its index length is 0.
+   */
+  LOG(81) << "New Bundle from mapped file";
+  try {
+    const char *data = file->data();
+    size_t size = file->size();
+    if (size == 0) {
+      throw std::out_of_range("[Bundle] Empty file");
+    }
+    if (BPv7Codec::isBPv7(data, size)) {
+      parseBPv7(data, size);
+      return;
+    }
+    // The primary block has a version, the flags and the length of the rest.
+    const uint8_t *position = reinterpret_cast<const uint8_t*>(data) + 1;
+    const uint8_t *end = reinterpret_cast<const uint8_t*>(data) + size;
+    uint64_t value;
+    position += SDNV::decode(position, end, value);
+    position += SDNV::decode(position, end, value);
+    if (value > static_cast<uint64_t>(end - position)) {
+      throw std::out_of_range("[Bundle] Primary block out of the file");
+    }
+    size_t offset = position - reinterpret_cast<const uint8_t*>(data) + value;
+    std::string raw(data, offset);
+    m_blockIndex.reserve(INDEX_RESERVE);
+    m_blockIndex.push_back(BlockIndex { 0, 0, 0, offset });
+    std::shared_ptr<PayloadBlock> payloadBlock;
+    size_t payloadPosition = 0;
+    bool lastBlock = false;
+    while (offset < size) {
+      BlockIndex index = indexBlock(data, size, offset, lastBlock);
+      if (index.blockType
+          == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+        // Check if another payload block is present
+        if (payloadBlock != nullptr) {
+          throw BundleCreationException("[Bundle] More than one payload found");
         }
+        payloadBlock = makeShared<PayloadBlock>(m_arena, file, offset);
+        payloadPosition = m_blockIndex.size();
+        offset += index.length;
+        index.offset = 0;
+        index.length = 0;
+      } else {
+        offset += index.length;
+        index.offset = raw.size();
+        raw.append(data + offset - index.length, index.length);
       }
-      m_blocks.push_back(b);
-      size_t blockSize = b->getLength();
-      data = data.substr(blockSize);
-    }
-    std::vector<std::shared_ptr<Block>>::reverse_iterator finalBlock = m_blocks
-        .rbegin();
-    if (!std::static_pointer_cast<CanonicalBlock>(*finalBlock)->checkProcFlag(
-        CanonicalBlockControlFlags::LAST_BLOCK)) {
+      m_blockIndex.push_back(index);
+    }
+    if (!lastBlock) {
       throw BundleCreationException("[Bundle] Last block not marked as such");
     }
+    m_raw = makeShared<const std::string>(m_arena, std::move(raw));
+    m_primaryBlock = makeShared<PrimaryBlock>(m_arena, m_raw, 0);
+    m_blocks.resize(m_blockIndex.size());
+    m_blocks[0] = m_primaryBlock;
+    if (payloadBlock != nullptr) {
+      m_payloadBlock = payloadBlock;
+      m_blocks[payloadPosition] = payloadBlock;
+    }
+    updateFragmentKey();
+  } catch (const BundleCreationException &e) {
+    throw;
   } catch (const BlockConstructionException &e) {
     throw BundleCreationException(e.what());
   } catch (const std::exception &e) {
@@ -136,7 +203,10 @@ Bundle::Bundle(const std::string &rawData)
 }
 
 Bundle::Bundle(std::string origin, std::string destination, std::string payload)
-    : m_raw() {
+    : m_arena(nullptr),
+      m_raw(std::make_shared<const std::string>()),
+      m_convertedBlocks(0),
+      m_changed(false) {
   LOG(82) << "Generating new bundle with parameters [Source: " << origin
           << "][Destination: " << destination << "][Payload: " << payload
           << "]";
@@ -145,72 +215,670 @@ Bundle::Bundle(std::string origin, std::string destination, std::string payload)
   m_primaryBlock = std::shared_ptr<PrimaryBlock>(
       new PrimaryBlock(origin, destination, timestampValue.first,
                        timestampValue.second));
-  m_payloadBlock = std::shared_ptr<PayloadBlock>(new PayloadBlock(payload));
+  m_payloadBlock = std::shared_ptr<PayloadBlock>(new PayloadBlock(std::move(payload)));
   m_blocks.push_back(m_primaryBlock);
   m_blocks.push_back(m_payloadBlock);
+  m_blockIndex.push_back(BlockIndex { 0, 0, 0, 0 });
+  m_blockIndex.push_back(
+      BlockIndex { m_payloadBlock->getBlockType(), 0, 0, 0 });
 }
 
 Bundle::~Bundle() {
   LOG(83) << "Deleting Bundle";
 }
 
-std::string Bundle::getRaw() {
-  return m_raw;
+const std::string& Bundle::getRaw() {
+  return *m_raw;
 }
 
-std::string Bundle::toRaw() {
+const std::string& Bundle::toRaw() {
   LOG(81) << "Generating bundle in raw format";
-  std::string raw = m_raw;
-  std::stringstream ss;
-  LOG(81) << "Getting the primary block in raw";
-  std::vector<std::shared_ptr<Block>>::reverse_iterator finalBlock = m_blocks
-      .rbegin();
-  std::static_pointer_cast<CanonicalBlock>(*finalBlock)->setProcFlag(
-      CanonicalBlockControlFlags::LAST_BLOCK);
-  for (std::vector<std::shared_ptr<Block>>::iterator it = m_blocks.begin();
-      it != m_blocks.end(); ++it) {
-    ss << (*it)->toRaw();
+  std::vector<RawSegment> segments = getBlockSegments();
+  bool changed = false;
+  size_t length = 0;
+  for (auto &segment : segments) {
+    changed = changed || segment.buffer != m_raw || segment.file;
+    length += segment.length;
+  }
+  if (!changed) {
+    LOG(81) << "Bundle not changed, using the last raw format";
+    return *m_raw;
+  }
+  std::string raw;
+  raw.reserve(length);
+  for (size_t i = 0; i < segments.size(); ++i) {
+    m_blockIndex[i].offset = raw.size();
+    m_blockIndex[i].length = segments[i].length;
+    raw.append(segments[i].data(), segments[i].length);
+  }
+  m_raw = makeShared<const std::string>(m_arena, std::move(raw));
+  // The blocks become views of the new raw bundle and release their own raw.
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (m_blocks[i] != nullptr && !segments[i].file) {
+      m_blocks[i]->shareRaw(m_raw, m_blockIndex[i].offset);
+    }
+  }
+  return *m_raw;
+}
+
+std::string Bundle::toRaw(BundleEncoding encoding) {
+  if (encoding != BundleEncoding::BPV7) {
+    return toRaw();
+  }
+  std::vector<RawSegment> segments = toRawSegments(encoding);
+  size_t length = 0;
+  for (auto &segment : segments) {
+    length += segment.length;
+  }
+  std::string raw;
+  raw.reserve(length);
+  for (auto &segment : segments) {
+    raw.append(segment.data(), segment.length);
   }
-  raw = ss.str();
-  m_raw = raw;
   return raw;
 }
 
+std::vector<RawSegment> Bundle::toRawSegments(
+    BundleEncoding encoding) const {
+  if (encoding != BundleEncoding::BPV7) {
+    return toRawSegments();
+  }
+  LOG(81) << "Generating bundle in BPv7 raw segments";
+  // The primary block is encoded from its fields, without the dictionary.
+  std::string heads(1, static_cast<char>(CBOR::INDEFINITE_ARRAY));
+  std::vector<RawSegment> blockSegments;
+  std::vector<size_t> headEnds;
+  try {
+    BPv7Codec::encodePrimaryBlock(*m_primaryBlock, heads);
+    // The payload block goes last, and the IntegrityMEB is left out as its
+    // checksums are replaced by the CRCs of the blocks.
+    std::vector<RawSegment> segments = getBlockSegments(1);
+    std::vector<size_t> order;
+    size_t payload = segments.size();
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (m_blockIndex[i + 1].blockType
+          == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+        payload = i;
+      } else if (!isIntegrityBlock(i + 1)) {
+        order.push_back(i);
+      }
+    }
+    if (payload < segments.size()) {
+      order.push_back(payload);
+    }
+    uint64_t blockNumber = 2;
+    for (size_t position : order) {
+      RawSegment segment = segments[position];
+      size_t headStart = heads.size();
+      size_t dataOffset = BPv7Codec::encodeCanonicalBlockHead(
+          segment.data(), segment.length,
+          position == payload ? 1 : blockNumber++, heads);
+      // The segment is left with the block data, the CRC goes after it.
+      segment.offset += dataOffset;
+      segment.length -= dataOffset;
+      headEnds.push_back(heads.size());
+      BPv7Codec::encodeCanonicalBlockCRC(heads.data() + headStart,
+                                         heads.size() - headStart,
+                                         segment.data(), segment.length,
+                                         heads);
+      blockSegments.push_back(segment);
+    }
+  } catch (const std::exception &e) {
+    throw BundleException(e.what());
+  }
+  heads.push_back(static_cast<char>(CBOR::BREAK));
+  std::shared_ptr<const std::string> buffer = makeShared<const std::string>(
+      m_arena, std::move(heads));
+  std::vector<RawSegment> segments;
+  size_t headStart = 0;
+  for (size_t i = 0; i < blockSegments.size(); ++i) {
+    segments.push_back(RawSegment { buffer, headStart,
+        headEnds[i] - headStart, nullptr });
+    if (blockSegments[i].length > 0) {
+      segments.push_back(blockSegments[i]);
+    }
+    headStart = headEnds[i];
+  }
+  segments.push_back(RawSegment { buffer, headStart,
+      buffer->size() - headStart, nullptr });
+  return segments;
+}
+
+std::vector<RawSegment> Bundle::toRawSegments() const {
+  LOG(81) << "Generating bundle in raw segments";
+  std::vector<RawSegment> segments;
+  for (auto &segment : getBlockSegments()) {
+    // Join the segments that are contiguous into the same buffer.
+    if (!segments.empty() && segments.back().buffer == segment.buffer
+        && segments.back().file == segment.file
+        && segments.back().offset + segments.back().length
+            == segment.offset) {
+      segments.back().length += segment.length;
+    } else {
+      segments.push_back(segment);
+    }
+  }
+  return segments;
+}
+
+std::shared_ptr<const WireImage> Bundle::toWireImage(
+    BundleEncoding encoding) const {
+  return std::make_shared<const WireImage>(toRawSegments(encoding));
+}
+
+size_t Bundle::getRawLength() const {
+  size_t length = 0;
+  for (auto &segment : getBlockSegments()) {
+    length += segment.length;
+  }
+  return length;
+}
+
+std::vector<RawSegment> Bundle::getBlockSegments(size_t first) const {
+  if (m_blocks.size() > 1 && m_blocks.back() != nullptr) {
+    std::shared_ptr<CanonicalBlock> finalBlock = std::static_pointer_cast<
+        CanonicalBlock>(m_blocks.back());
+    if (!finalBlock->checkProcFlag(CanonicalBlockControlFlags::LAST_BLOCK)) {
+      finalBlock->setProcFlag(CanonicalBlockControlFlags::LAST_BLOCK);
+    }
+  }
+  // The changed blocks are converted and, like the blocks that are not into
+  // the raw bundle, taken from their own raw. The others are taken from the
+  // last raw bundle. The blocks not generated yet are always into the raw
+  // bundle, the last one already has the last block flag as it has been
+  // checked while parsing.
+  std::vector<RawSegment> segments;
+  for (size_t i = first; i < m_blocks.size(); ++i) {
+    if (m_blocks[i] != nullptr
+        && (m_blocks[i]->isDirty() || m_blockIndex[i].length == 0)) {
+      if (m_blocks[i]->isDirty()) {
+        m_blocks[i]->updateRaw();
+        ++m_convertedBlocks;
+        m_changed = m_changed || !isIntegrityBlock(i);
+      }
+      // The block is no longer into the raw bundle.
+      m_blockIndex[i].length = 0;
+      segments.push_back(m_blocks[i]->getRawSegment());
+    } else {
+      segments.push_back(RawSegment { m_raw, m_blockIndex[i].offset,
+          m_blockIndex[i].length, nullptr });
+    }
+  }
+  return segments;
+}
+
+uint64_t Bundle::getConvertedBlocks() const {
+  return m_convertedBlocks;
+}
+
+bool Bundle::isDirty() const {
+  if (m_changed) {
+    return true;
+  }
+  for (size_t i = 0; i < m_blocks.size(); ++i) {
+    if (m_blocks[i] != nullptr && m_blocks[i]->isDirty()
+        && !isIntegrityBlock(i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Bundle::isIntegrityBlock(size_t position) const {
+  return m_blockIndex[position].blockType
+      == static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK)
+      && m_blockIndex[position].metadataType
+          == static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB);
+}
+
 std::shared_ptr<PrimaryBlock> Bundle::getPrimaryBlock() {
   return m_primaryBlock;
 }
 
+std::shared_ptr<const PrimaryBlock> Bundle::getPrimaryBlock() const {
+  return m_primaryBlock;
+}
+
 std::shared_ptr<PayloadBlock> Bundle::getPayloadBlock() {
+  static_cast<const Bundle&>(*this).getPayloadBlock();
+  return m_payloadBlock;
+}
+
+std::shared_ptr<const PayloadBlock> Bundle::getPayloadBlock() const {
+  if (m_payloadBlock == nullptr) {
+    for (size_t i = 1; i < m_blockIndex.size(); ++i) {
+      if (m_blockIndex[i].blockType
+          == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+        materialize(i);
+        break;
+      }
+    }
+  }
   return m_payloadBlock;
 }
 
 std::vector<std::shared_ptr<Block>> Bundle::getBlocks() {
+  for (size_t i = 1; i < m_blocks.size(); ++i) {
+    materialize(i);
+  }
   return m_blocks;
 }
 
+std::vector<std::shared_ptr<const Block>> Bundle::getBlocks() const {
+  for (size_t i = 1; i < m_blocks.size(); ++i) {
+    materialize(i);
+  }
+  getBlockSegments();
+  return std::vector<std::shared_ptr<const Block>>(m_blocks.begin(),
+                                                   m_blocks.end());
+}
+
 void Bundle::addBlock(std::shared_ptr<CanonicalBlock> newBlock) {
 // Check if the block type is a PayloadBlock
 // only one can be present into a bundle.
   LOG(81) << "Adding new Block to the bundle";
   if (newBlock->getBlockType()
       != static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+    uint8_t metadataType = 0;
+    if (static_cast<CanonicalBlockTypes>(newBlock->getBlockType())
+        == CanonicalBlockTypes::METADATA_EXTENSION_BLOCK) {
+      metadataType = std::static_pointer_cast<MetadataExtensionBlock>(newBlock)
+          ->getMetadataType();
+    }
     m_blocks.push_back(newBlock);
+    m_blockIndex.push_back(
+        BlockIndex { newBlock->getBlockType(), metadataType, 0, 0 });
+    m_changed = true;
   } else {
     LOG(5) << "Some one is trying to add another Payload block";
     throw BundleException("[Bundle] a paylod block is present");
   }
 }
 
-std::string Bundle::getId() {
-  std::stringstream ss;
-  ss << m_primaryBlock->getSource() << "_"
-     << m_primaryBlock->getCreationTimestamp() << "_"
-     << m_primaryBlock->getCreationTimestampSeqNumber();
-  return ss.str();
+std::vector<BlockIndex> Bundle::getBlockIndex() {
+  return m_blockIndex;
+}
+
+BlockIndex Bundle::indexBlock(const char *data, size_t size, size_t offset,
+                              bool &lastBlock) {
+  const uint8_t *start = reinterpret_cast<const uint8_t*>(data + offset);
+  const uint8_t *end = reinterpret_cast<const uint8_t*>(data + size);
+  BlockIndex index { *start, 0, offset, 0 };
+  const uint8_t *position = start + 1;
+  uint64_t value;
+  position += SDNV::decode(position, end, value);
+  std::bitset<7> procFlags = std::bitset<7>(value);
+  lastBlock = procFlags.test(
+      static_cast<uint32_t>(CanonicalBlockControlFlags::LAST_BLOCK));
+  if (procFlags.test(
+      static_cast<uint32_t>(CanonicalBlockControlFlags::EID_FIELD))) {
+    uint64_t numberOfEID;
+    position += SDNV::decode(position, end, numberOfEID);
+    for (uint64_t i = 0; i < numberOfEID; ++i) {
+      position += SDNV::decode(position, end, value);
+      position += SDNV::decode(position, end, value);
+    }
+  }
+  uint64_t blockDataSize;
+  position += SDNV::decode(position, end, blockDataSize);
+  if (blockDataSize > static_cast<uint64_t>(end - position)) {
+    throw std::out_of_range("[Bundle] Block out of the buffer");
+  }
+  index.length = position - start + blockDataSize;
+  if (index.blockType
+      == static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK)) {
+    position += SDNV::decode(position, end, value);
+    index.metadataType = static_cast<uint8_t>(value);
+    if (static_cast<size_t>(position - start) > index.length) {
+      throw std::out_of_range("[Bundle] Metadata type out of the block");
+    }
+  }
+  return index;
+}
+
+void Bundle::parseBPv7(const char *data, size_t size) {
+  LOG(81) << "Decoding BPv7 bundle";
+  // Skip the start of the array.
+  const uint8_t *position = reinterpret_cast<const uint8_t*>(data) + 1;
+  const uint8_t *end = reinterpret_cast<const uint8_t*>(data) + size;
+  m_primaryBlock = BPv7Codec::decodePrimaryBlock(position, end, m_arena);
+  m_blockIndex.reserve(INDEX_RESERVE);
+  m_blockIndex.push_back(BlockIndex { 0, 0, 0, 0 });
+  std::string raw;
+  raw.reserve(end - position);
+  std::set<uint64_t> blockNumbers;
+  bool payloadFound = false;
+  bool lastBlock = false;
+  while (position < end && *position != CBOR::BREAK) {
+    size_t offset = raw.size();
+    if (!blockNumbers.insert(BPv7Codec::decodeCanonicalBlock(position, end,
+                                                             raw)).second) {
+      throw BundleCreationException("[Bundle] Repeated block number");
+    }
+    BlockIndex index = indexBlock(raw.data(), raw.size(), offset, lastBlock);
+    if (index.blockType
+        == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+      payloadFound = true;
+    }
+    m_blockIndex.push_back(index);
+  }
+  if (position == end || position + 1 != end) {
+    throw BundleCreationException("[Bundle] Bad end of BPv7 bundle");
+  }
+  if (!lastBlock) {
+    throw BundleCreationException("[Bundle] BPv7 bundle without blocks");
+  }
+  if (!payloadFound) {
+    throw BundleCreationException("[Bundle] BPv7 bundle without payload");
+  }
+  m_raw = makeShared<const std::string>(m_arena, std::move(raw));
+  m_blocks.resize(m_blockIndex.size());
+  m_blocks[0] = m_primaryBlock;
+  updateFragmentKey();
+}
+
+void Bundle::updateFragmentKey() {
+  if (!m_primaryBlock->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::IS_FRAGMENT)) {
+    return;
+  }
+  std::shared_ptr<const PayloadBlock> payload = getPayloadBlock();
+  if (payload != nullptr) {
+    m_primaryBlock->setFragmentLength(payload->getPayloadSegment().length);
+  }
+}
+
+std::shared_ptr<Block> Bundle::materialize(size_t position) const {
+  if (m_blocks[position] != nullptr) {
+    return m_blocks[position];
+  }
+  const BlockIndex &index = m_blockIndex[position];
+  std::shared_ptr<Block> b;
+  try {
+    b = BlockFactory::getInstance()->create(index.blockType,
+                                            index.metadataType, m_raw,
+                                            index.offset, m_arena);
+  } catch (const BlockConstructionException &e) {
+    throw BundleException(e.what());
+  }
+  if (index.blockType
+      == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+    m_payloadBlock = std::static_pointer_cast<PayloadBlock>(b);
+  }
+  m_blocks[position] = b;
+  return b;
+}
+
+std::vector<std::unique_ptr<Bundle>> Bundle::fragment(size_t maxSize) {
+  std::vector<std::unique_ptr<Bundle>> fragments;
+  std::vector<RawSegment> segments = getBlockSegments();
+  size_t length = 0;
+  for (auto &segment : segments) {
+    length += segment.length;
+  }
+  std::shared_ptr<const PayloadBlock> payload = getPayloadBlock();
+  if (length <= maxSize || payload == nullptr
+      || m_primaryBlock->checkPrimaryProcFlag(
+          PrimaryBlockControlFlags::NOT_FRAGMENTED)) {
+    return fragments;
+  }
+  LOG(81) << "Fragmenting bundle " << getId() << " of length " << length;
+  // Positions of the blocks that go before and after the payload, into the
+  // first and last fragment or into every fragment.
+  std::vector<size_t> before, beforeReplicated, after, afterReplicated;
+  size_t beforeLength = 0, beforeReplicatedLength = 0;
+  size_t afterLength = 0, afterReplicatedLength = 0;
+  bool payloadFound = false;
+  size_t integrityPosition = findMetadataBlock(MetadataTypes::INTEGRITY_MEB);
+  for (size_t i = 1; i < m_blocks.size(); ++i) {
+    if (m_blocks[i] == payload) {
+      payloadFound = true;
+      continue;
+    }
+    // The checksums of the bundle are not valid for the fragments.
+    if (i == integrityPosition) {
+      continue;
+    }
+    bool replicate = std::static_pointer_cast<CanonicalBlock>(materialize(i))
+        ->checkProcFlag(CanonicalBlockControlFlags::REPLICATE_FRAGMENT);
+    if (payloadFound) {
+      after.push_back(i);
+      afterLength += segments[i].length;
+      if (replicate) {
+        afterReplicated.push_back(i);
+        afterReplicatedLength += segments[i].length;
+      }
+    } else {
+      before.push_back(i);
+      beforeLength += segments[i].length;
+      if (replicate) {
+        beforeReplicated.push_back(i);
+        beforeReplicatedLength += segments[i].length;
+      }
+    }
+  }
+  RawSegment payloadData = payload->getPayloadSegment();
+  std::bitset<7> payloadFlags = payload->getProcFlags();
+  uint64_t baseOffset = m_primaryBlock->getFragmentOffset();
+  uint64_t totalLength = payloadData.length;
+  if (m_primaryBlock->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::IS_FRAGMENT)) {
+    totalLength = m_primaryBlock->getTotalApplicationDataLength();
+  }
+  // The space left for the payload is computed with the longest primary block
+  // and payload header.
+  PrimaryBlock primary(std::string(segments[0].data(), segments[0].length));
+  primary.setFragment(totalLength, totalLength);
+  size_t overhead = primary.toRaw().size()
+      + PayloadBlock::encodeHeader(payloadFlags, payloadData.length).size();
+  size_t offset = 0;
+  while (offset < payloadData.length) {
+    size_t remaining = payloadData.length - offset;
+    size_t fragmentOverhead = overhead
+        + (offset == 0 ? beforeLength : beforeReplicatedLength);
+    size_t fragmentLength = remaining;
+    bool last = true;
+    if (fragmentOverhead + afterLength + remaining > maxSize) {
+      if (fragmentOverhead + afterReplicatedLength >= maxSize) {
+        throw BundleException("[Bundle] Fragment size too small");
+      }
+      fragmentLength = std::min(
+          remaining, maxSize - fragmentOverhead - afterReplicatedLength);
+      last = fragmentLength == remaining;
+    }
+    const std::vector<size_t> &blocksBefore =
+        offset == 0 ? before : beforeReplicated;
+    const std::vector<size_t> &blocksAfter = last ? after : afterReplicated;
+    primary.setFragment(baseOffset + offset, totalLength);
+    std::bitset<7> flags = payloadFlags;
+    flags.set(static_cast<uint32_t>(CanonicalBlockControlFlags::LAST_BLOCK),
+              blocksAfter.empty());
+    std::string raw = primary.toRaw();
+    for (auto i : blocksBefore) {
+      raw.append(segments[i].data(), segments[i].length);
+    }
+    raw.append(PayloadBlock::encodeHeader(flags, fragmentLength));
+    raw.append(payloadData.data() + offset, fragmentLength);
+    size_t lastBlockOffset = 0;
+    for (auto i : blocksAfter) {
+      lastBlockOffset = raw.size();
+      raw.append(segments[i].data(), segments[i].length);
+    }
+    if (!blocksAfter.empty()) {
+      // The last block of the fragment may not be the last of the bundle.
+      setLastBlockFlag(raw, lastBlockOffset);
+    }
+    fragments.push_back(std::unique_ptr<Bundle>(new Bundle(std::move(raw))));
+    offset += fragmentLength;
+  }
+  return fragments;
+}
+
+std::unique_ptr<Bundle> Bundle::compressPayload(int level) {
+  std::shared_ptr<const PayloadBlock> payload = getPayloadBlock();
+  if (payload == nullptr
+      || findMetadataBlock(MetadataTypes::COMPRESSION_MEB) != 0
+      || m_primaryBlock->checkPrimaryProcFlag(
+          PrimaryBlockControlFlags::IS_FRAGMENT)) {
+    return nullptr;
+  }
+  RawSegment data = payload->getPayloadSegment();
+  std::string compressed = CompressionMEB::compress(
+      CompressionAlgorithms::DEFLATE, data.data(), data.length, level);
+  std::string compressionBlock = CompressionMEB(
+      CompressionAlgorithms::DEFLATE, data.length).toRaw();
+  if (compressed.size() + compressionBlock.size() >= data.length) {
+    LOG(81) << "The payload of bundle " << getId() << " does not compress";
+    return nullptr;
+  }
+  std::vector<RawSegment> segments = getBlockSegments();
+  std::string raw;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (m_blocks[i] == payload) {
+      raw.append(compressionBlock);
+      raw.append(PayloadBlock::encodeHeader(payload->getProcFlags(),
+                                            compressed.size()));
+      raw.append(compressed);
+    } else {
+      raw.append(segments[i].data(), segments[i].length);
+    }
+  }
+  LOG(81) << "Compressed the payload of bundle " << getId() << " from "
+          << data.length << " to " << compressed.size() << " bytes";
+  return std::unique_ptr<Bundle>(new Bundle(std::move(raw)));
+}
+
+std::unique_ptr<Bundle> Bundle::decompressPayload() const {
+  size_t position = findMetadataBlock(MetadataTypes::COMPRESSION_MEB);
+  std::shared_ptr<const PayloadBlock> payload = getPayloadBlock();
+  if (position == 0 || payload == nullptr) {
+    return nullptr;
+  }
+  std::shared_ptr<CompressionMEB> compression =
+      std::static_pointer_cast<CompressionMEB>(materialize(position));
+  RawSegment data = payload->getPayloadSegment();
+  std::string original = compression->decompress(data.data(), data.length);
+  std::vector<RawSegment> segments = getBlockSegments();
+  std::string raw;
+  size_t lastBlockOffset = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (i == position) {
+      continue;
+    }
+    lastBlockOffset = raw.size();
+    if (m_blocks[i] == payload) {
+      raw.append(PayloadBlock::encodeHeader(payload->getProcFlags(),
+                                            original.size()));
+      raw.append(original);
+    } else {
+      raw.append(segments[i].data(), segments[i].length);
+    }
+  }
+  if (position == segments.size() - 1) {
+    setLastBlockFlag(raw, lastBlockOffset);
+  }
+  return std::unique_ptr<Bundle>(new Bundle(std::move(raw)));
+}
+
+void Bundle::addChecksums() {
+  size_t position = findMetadataBlock(MetadataTypes::INTEGRITY_MEB);
+  std::shared_ptr<IntegrityMEB> integrity;
+  if (position == 0) {
+    // The block goes after the primary block, so the last block does not
+    // change.
+    integrity = makeShared<IntegrityMEB>(m_arena);
+    position = 1;
+    m_blocks.insert(m_blocks.begin() + position, integrity);
+    m_blockIndex.insert(
+        m_blockIndex.begin() + position,
+        BlockIndex { integrity->getBlockType(), integrity->getMetadataType(),
+            0, 0 });
+  } else {
+    integrity = std::static_pointer_cast<IntegrityMEB>(materialize(position));
+  }
+  std::vector<RawSegment> segments = getBlockSegments();
+  std::vector<uint32_t> checksums;
+  checksums.reserve(segments.size() - 1);
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (i != position) {
+      checksums.push_back(
+          CRC32C::compute(segments[i].data(), segments[i].length));
+    }
+  }
+  integrity->setChecksums(checksums);
+  m_changed = false;
+}
+
+bool Bundle::hasChecksums() const {
+  return findMetadataBlock(MetadataTypes::INTEGRITY_MEB) != 0;
+}
+
+bool Bundle::verifyChecksums() const {
+  size_t position = findMetadataBlock(MetadataTypes::INTEGRITY_MEB);
+  if (position == 0) {
+    return true;
+  }
+  std::shared_ptr<IntegrityMEB> integrity;
+  try {
+    integrity = std::static_pointer_cast<IntegrityMEB>(materialize(position));
+  } catch (const BundleException &e) {
+    LOG(3) << "Bad integrity block in bundle " << getId();
+    return false;
+  }
+  std::vector<RawSegment> segments = getBlockSegments();
+  const std::vector<uint32_t> &checksums = integrity->getChecksums();
+  if (checksums.size() != segments.size() - 1) {
+    LOG(3) << "The integrity block of bundle " << getId()
+           << " does not match the number of blocks";
+    return false;
+  }
+  size_t checksum = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (i == position) {
+      continue;
+    }
+    if (CRC32C::compute(segments[i].data(), segments[i].length)
+        != checksums[checksum++]) {
+      LOG(3) << "Block " << i << " of bundle " << getId()
+             << " does not match its checksum";
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t Bundle::findMetadataBlock(MetadataTypes type) const {
+  for (size_t i = 1; i < m_blockIndex.size(); ++i) {
+    if (static_cast<CanonicalBlockTypes>(m_blockIndex[i].blockType)
+        == CanonicalBlockTypes::METADATA_EXTENSION_BLOCK
+        && static_cast<MetadataTypes>(m_blockIndex[i].metadataType) == type) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+void Bundle::setLastBlockFlag(std::string &raw, size_t blockOffset) {
+  // The flag is in the last byte of the flags SDNV, after the block type.
+  size_t flagsEnd = blockOffset + 1;
+  while (raw[flagsEnd] & 0x80) {
+    ++flagsEnd;
+  }
+  raw[flagsEnd] |= 1 << static_cast<uint32_t>(
+      CanonicalBlockControlFlags::LAST_BLOCK);
+}
+
+std::string Bundle::getId() const {
+  return m_primaryBlock->getKey().toString();
+}
+
+const BundleKey& Bundle::getKey() const {
+  return m_primaryBlock->getKey();
 }
 
 std::string Bundle::toString() {
   std::stringstream ss;
+  getBlocks();
   for (size_t i = 0; i < m_blocks.size(); ++i) {
     ss << m_blocks[i]->toString();
   }
@@ -218,18 +886,15 @@ std::string Bundle::toString() {
 }
 
 std::shared_ptr<FrameworkMEB> Bundle::getFwk(uint8_t fwkId) {
-  auto it = m_blocks.begin();
-  for (++it; it != m_blocks.end(); ++it) {
-    auto cb = std::static_pointer_cast<CanonicalBlock>(*it);
-    if (static_cast<CanonicalBlockTypes>(cb->getBlockType())
-        == CanonicalBlockTypes::METADATA_EXTENSION_BLOCK) {
-      auto meb = std::static_pointer_cast<MetadataExtensionBlock>(cb);
-      if (static_cast<MetadataTypes>(meb->getMetadataType())
-          == MetadataTypes::FRAMEWORK_MEB) {
-        auto fmeb = std::static_pointer_cast<FrameworkMEB>(meb);
-        if (fmeb->getFwkId() == fwkId) {
-          return fmeb;
-        }
+  // Only the framework blocks are generated.
+  for (size_t i = 1; i < m_blockIndex.size(); ++i) {
+    if (static_cast<CanonicalBlockTypes>(m_blockIndex[i].blockType)
+        == CanonicalBlockTypes::METADATA_EXTENSION_BLOCK
+        && static_cast<MetadataTypes>(m_blockIndex[i].metadataType)
+            == MetadataTypes::FRAMEWORK_MEB) {
+      auto fmeb = std::static_pointer_cast<FrameworkMEB>(materialize(i));
+      if (fmeb->getFwkId() == fwkId) {
+        return fmeb;
       }
     }
   }
@@ -29,10 +29,14 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include "Bundle/Block.h"
+#include "Bundle/BundleKey.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/WireImage.h"
+#include "Utils/Arena.h"
 
 class PrimaryBlock;
 class PayloadBlock;
-class Block;
 class CanonicalBlock;
 class FrameworkExtension;
 class FrameworkMEB;
@@ -58,9 +62,35 @@ class FrameworkNotFoundException : public std::runtime_error {
   }
 };
 
+/**
+ * Position and type of a block inside the raw bundle.
+ */
+struct BlockIndex {
+  /**
+   * Type of the block, 0 for the primary block.
+   */
+  uint8_t blockType;
+  /**
+   * Metadata type if the block is a metadata extension block, 0 otherwise.
+   */
+  uint8_t metadataType;
+  /**
+   * Position of the block into the raw bundle.
+   */
+  size_t offset;
+  /**
+   * Length of the block in raw format.
+   */
+  size_t length;
+};
+
 /**
  * CLASS Bundle
  * This class represents a Bundle as defined into the RFC 5050.
+ *
+ * The bundles can also be encoded and decoded in BPv7, as defined into the
+ * RFC 9171, the blocks keep the RFC 5050 format in memory. The raw
+ * constructors detect the encoding of the raw bundle.
  */
 class Bundle {
  public:
@@ -68,10 +98,49 @@ class Bundle {
    * @brief Raw constructor.
    **
    * This constructor will take a raw bundle and reconstruct the bundle from it.
+   * Only the primary block is parsed, the canonical blocks are indexed and
+   * generated the first time they are requested.
+   * The raw bundle can be in RFC 5050 or in BPv7 format.
    *
    * @param rawData the bundle in raw to convert to a Bundle class.
    */
   explicit Bundle(const std::string &rawData);
+  /**
+   * @brief Raw constructor with an arena.
+   *
+   * Same as the raw constructor, but the buffer and the blocks are allocated
+   * from the arena, that is released when the bundle and all its blocks are
+   * destroyed.
+   *
+   * @param rawData the bundle in raw to convert to a Bundle class.
+   * @param arena the arena to allocate from, or nullptr to use the heap.
+   */
+  Bundle(const std::string &rawData, const std::shared_ptr<Arena> &arena);
+  /**
+   * @brief Raw constructor that takes the raw bundle.
+   *
+   * Same as the raw constructor with an arena, but the raw bundle is moved
+   * into the bundle instead of copied. The blocks are views of it, so the
+   * bundle holds its data once.
+   *
+   * @param rawData the bundle in raw to convert to a Bundle class.
+   * @param arena the arena to allocate from, or nullptr to use the heap.
+   */
+  explicit Bundle(std::string &&rawData,
+                  const std::shared_ptr<Arena> &arena = nullptr);
+  /**
+   * @brief Mapped file constructor.
+   *
+   * This constructor will reconstruct the bundle from a raw bundle stored into
+   * a mapped file. Only the payload block is kept into the file, the other
+   * blocks are copied into memory, so big payloads do not need to fit into
+   * it. BPv7 bundles are copied into memory.
+   *
+   * @param file the mapped file that holds the bundle in raw.
+   * @param arena the arena to allocate from, or nullptr to use the heap.
+   */
+  explicit Bundle(const std::shared_ptr<const MappedFile> &file,
+                  const std::shared_ptr<Arena> &arena = nullptr);
   /**
    * @brief Constructs a bundle with the provided information.
    *
@@ -86,23 +155,110 @@ class Bundle {
    * Destructor of the class.
    */
   virtual ~Bundle();
+  /**
+   * The bundles can only be moved, the copies would share the blocks and
+   * parse them again, use toWireImage() to share a bundle.
+   */
+  Bundle(const Bundle&) = delete;
+  Bundle& operator=(const Bundle&) = delete;
+  Bundle(Bundle&&) = default;
+  Bundle& operator=(Bundle&&) = default;
   /**
    * @brief Function to get the bundle in raw format.
    *
    * This function will provide the last raw version of the bundle.
    * Notice that it may not be up to date.
    *
-   * @return the bundle in raw format.
+   * @return the bundle in raw format, valid until the bundle is changed.
    */
-  std::string getRaw();
+  const std::string& getRaw();
   /**
    * @brief Function to update the bundle raw format.
    *
    * This function will generate a raw version of the current bundle.
+   * Only the blocks that have changed since the last call are converted, the
+   * others are copied from the last raw version.
+   * A payload that lives into a mapped file is copied into memory, use
+   * toRawSegments() to send big bundles.
+   * The generated blocks are moved into the new raw bundle, so their data is
+   * not kept twice.
+   *
+   * @return the bundle in raw format, valid until the bundle is changed.
+   */
+  const std::string& toRaw();
+  /**
+   * @brief Function to get the number of blocks converted to raw.
    *
+   * This function returns how many blocks toRaw() has converted since the
+   * bundle was created, the blocks copied from the last raw are not counted.
+   *
+   * @return the number of converted blocks.
+   */
+  uint64_t getConvertedBlocks() const;
+  /**
+   * @brief Function to know if a block has changed since the bundle was parsed
+   * or its checksums were added.
+   *
+   * The IntegrityMEB is not taken into account.
+   *
+   * @return True if the checksums must be added again.
+   */
+  bool isDirty() const;
+  /**
+   * @brief Function to get the bundle in raw format as a list of segments.
+   *
+   * Like toRaw() it converts the changed blocks, but instead of copying all
+   * the blocks into a new raw bundle it returns the segments of the buffers
+   * that hold them, in order. The segments keep the buffers alive, so they
+   * can be sent after the bundle is destroyed.
+   *
+   * @return the segments that form the raw bundle.
+   */
+  std::vector<RawSegment> toRawSegments() const;
+  /**
+   * @brief Function to get the bundle in raw format of the given encoding.
+   *
+   * Like toRaw(), but the bundle is encoded in the given encoding.
+   * Throws a BundleException if the bundle can not be encoded.
+   *
+   * @param encoding The encoding of the raw bundle.
    * @return the bundle in raw format.
    */
-  std::string toRaw();
+  std::string toRaw(BundleEncoding encoding);
+  /**
+   * @brief Function to get the bundle as a list of segments of the given
+   * encoding.
+   *
+   * Like toRawSegments(), in BPv7 the heads and CRCs of the blocks are
+   * generated into a new buffer and the block data is taken from the buffers
+   * that hold the blocks, so it is not copied.
+   * Throws a BundleException if the bundle can not be encoded.
+   *
+   * @param encoding The encoding of the raw bundle.
+   * @return the segments that form the raw bundle.
+   */
+  std::vector<RawSegment> toRawSegments(BundleEncoding encoding) const;
+  /**
+   * @brief Function to get the bundle ready to be sent in the given encoding.
+   *
+   * Like toRawSegments(), but the segments are kept into an immutable image
+   * that can be shared between all the receivers of the bundle.
+   * Throws a BundleException if the bundle can not be encoded.
+   *
+   * @param encoding The encoding of the raw bundle.
+   * @return the image of the raw bundle.
+   */
+  std::shared_ptr<const WireImage> toWireImage(
+      BundleEncoding encoding = BundleEncoding::RFC5050) const;
+  /**
+   * @brief Returns the length of the bundle in raw format.
+   *
+   * Like toRawSegments() it converts the changed blocks, but the raw bundle
+   * is not generated.
+   *
+   * @return the length in bytes.
+   */
+  size_t getRawLength() const;
   /**
    * @brief Function to get the PrimaryBlock.
    *
@@ -111,22 +267,49 @@ class Bundle {
    * @return a pointer to the primary block.
    */
   std::shared_ptr<PrimaryBlock> getPrimaryBlock();
+  /**
+   * @brief Function to get the PrimaryBlock to read it.
+   *
+   * @return a pointer to the primary block.
+   */
+  std::shared_ptr<const PrimaryBlock> getPrimaryBlock() const;
   /**
    * @brief Function to get the PayloadBlock.
    *
    * This function returns a pointer to the payload block of the bundle.
+   * Throws a BundleException if the block can not be generated.
    *
    * @return a pointer to the payload block.
    */
   std::shared_ptr<PayloadBlock> getPayloadBlock();
+  /**
+   * @brief Function to get the PayloadBlock to read it.
+   *
+   * Throws a BundleException if the block can not be generated.
+   *
+   * @return a pointer to the payload block.
+   */
+  std::shared_ptr<const PayloadBlock> getPayloadBlock() const;
   /**
    * @brief Function to get all the bundle blocks.
    *
-   * This function returns all the blocks that the bundle holds.
+   * This function returns all the blocks that the bundle holds, generating
+   * the ones that have not been requested yet.
+   * Throws a BundleException if a block can not be generated.
    *
    * @return a vector with all the blocks.
    */
   std::vector<std::shared_ptr<Block>> getBlocks();
+  /**
+   * @brief Function to get all the bundle blocks to read them.
+   *
+   * The changed blocks are converted too, so the raw segment of every
+   * returned block is up to date.
+   * Throws a BundleException if a block can not be generated.
+   *
+   * @return a vector with all the blocks.
+   */
+  std::vector<std::shared_ptr<const Block>> getBlocks() const;
   /**
    * @brief Function to add a canonical block to the bundle.
    *
@@ -136,6 +319,16 @@ class Bundle {
    * @param A pointer to the block.
    */
   void addBlock(std::shared_ptr<CanonicalBlock> newBlock);
+  /**
+   * @brief Function to get the index of the bundle blocks.
+   *
+   * This function returns the type and position of all the blocks without
+   * generating them. The first entry is the primary block.
+   * The position of the blocks added after the last toRaw() is 0.
+   *
+   * @return a vector with the index of all the blocks.
+   */
+  std::vector<BlockIndex> getBlockIndex();
   /**
    * @brief Gets the bundle id
    *
@@ -143,7 +336,16 @@ class Bundle {
    * creationTimestamp and creationTimestampSeqNumber.
    *
    */
-  std::string getId();
+  std::string getId() const;
+  /**
+   * @brief Gets the bundle key
+   *
+   * This function returns the compact key that identifies the bundle, use it
+   * instead of the id to compare or index bundles.
+   *
+   * @return The bundle key.
+   */
+  const BundleKey& getKey() const;
   /**
    * @brief Returns an string with a nice view of the bundle information.
    *
@@ -157,12 +359,149 @@ class Bundle {
                                                 uint8_t fwkExtId);
 
   std::shared_ptr<FrameworkMEB> getFwk(uint8_t fwkId);
+  /**
+   * @brief Splits the bundle into fragments as described into the RFC 5050.
+   *
+   * Every fragment carries a piece of the payload, the blocks before the
+   * payload go into the first fragment and the ones after it into the last
+   * fragment, unless they must be replicated in every fragment. A fragment
+   * can be fragmented again, the offsets always refer to the original
+   * payload. The fragments are not bigger than maxSize, unless the blocks that
+   * go into the last one do not fit. The IntegrityMEB is not copied into
+   * the fragments.
+   * Throws a BundleException if maxSize does not leave space for the payload.
+   *
+   * @param maxSize The maximum size of a fragment in raw format.
+   * @return The fragments, empty if the bundle fits into maxSize or must not
+   *         be fragmented.
+   */
+  std::vector<std::unique_ptr<Bundle>> fragment(size_t maxSize);
+  /**
+   * @brief Generates a copy of the bundle with the payload compressed.
+   *
+   * A CompressionMEB is added before the payload. Throws a
+   * CompressionException if the payload can not be compressed.
+   *
+   * @param level The compression level, from 1 (fastest) to 9 (smallest).
+   * @return The compressed bundle, nullptr if the bundle is already
+   *         compressed, is a fragment or the compressed bundle is not smaller.
+   */
+  std::unique_ptr<Bundle> compressPayload(int level);
+  /**
+   * @brief Generates a copy of the bundle with the original payload.
+   *
+   * The CompressionMEB is removed. Throws a CompressionException if the
+   * payload can not be decompressed.
+   *
+   * @return The decompressed bundle, nullptr if the payload is not compressed.
+   */
+  std::unique_ptr<Bundle> decompressPayload() const;
+  /**
+   * @brief Stores the CRC32C of every block into an IntegrityMEB.
+   *
+   * The block is added after the primary block if the bundle has none. It
+   * must be called after the last change of the bundle blocks.
+   */
+  void addChecksums();
+  /**
+   * @brief Tells if the bundle has an IntegrityMEB.
+   *
+   * @return True if the checksums of the blocks have been added.
+   */
+  bool hasChecksums() const;
+  /**
+   * @brief Checks the CRC32C of every block against the IntegrityMEB.
+   *
+   * Only the integrity block is generated, the others are checked in raw
+   * format.
+   *
+   * @return False if a block does not match its checksum, true if all of them
+   *         match or the bundle has no IntegrityMEB.
+   */
+  bool verifyChecksums() const;
 
  private:
   /**
-   * Byte array containing the raw bundle.
+   * @brief Adds the payload length of a fragment to its key.
+   *
+   * The payload block is generated if the bundle is a fragment.
    */
-  std::string m_raw;
+  void updateFragmentKey();
+  /**
+   * @brief Reads the header of the canonical block at the given offset.
+   *
+   * @param data The first byte of the raw bundle.
+   * @param size The size of the raw bundle.
+   * @param offset The position of the block into the raw bundle.
+   * @param lastBlock Set to true if the block has the last block flag.
+   * @return The index of the block.
+   */
+  static BlockIndex indexBlock(const char *data, size_t size, size_t offset,
+                               bool &lastBlock);
+  /**
+   * @brief Converts the changed blocks and returns one segment for each block.
+   *
+   * The index length of the blocks that are not taken from the raw bundle is
+   * set to 0.
+   *
+   * @param first The position of the first block to convert.
+   * @return the segment of every block from the first one.
+   */
+  std::vector<RawSegment> getBlockSegments(size_t first = 0) const;
+  /**
+   * @brief Generates the bundle from a raw bundle in BPv7 format.
+   *
+   * The primary block is decoded and the canonical blocks are converted into
+   * a new raw buffer, without the primary block, and indexed. The CRCs of the
+   * blocks are checked.
+   *
+   * @param data The first byte of the raw bundle.
+   * @param size The size of the raw bundle.
+   */
+  void parseBPv7(const char *data, size_t size);
+  /**
+   * @brief Generates the block at the given position if it is not generated.
+   *
+   * @param position The position of the block into the blocks vector.
+   * @return a pointer to the block.
+   */
+  std::shared_ptr<Block> materialize(size_t position) const;
+  /**
+   * @brief Finds the first metadata extension block of the given type.
+   *
+   * @param type The metadata type.
+   * @return The position of the block, 0 if there is none.
+   */
+  size_t findMetadataBlock(MetadataTypes type) const;
+  /**
+   * @brief Tells if the block at the given position is the IntegrityMEB.
+   *
+   * @param position The position of the block.
+   * @return True if the block is the IntegrityMEB.
+   */
+  bool isIntegrityBlock(size_t position) const;
+  /**
+   * @brief Sets the last block flag of the raw block at the given offset.
+   *
+   * @param raw The raw bundle.
+   * @param blockOffset The position of the block into the raw bundle.
+   */
+  static void setLastBlockFlag(std::string &raw, size_t blockOffset);
+  /**
+   * Number of block index entries reserved when parsing, enough for the
+   * usual bundles to avoid growing the index.
+   */
+  static const size_t INDEX_RESERVE = 8;
+  /**
+   * Arena where the blocks are allocated, nullptr to use the heap.
+   */
+  std::shared_ptr<Arena> m_arena;
+  /**
+   * Byte array containing the raw bundle, shared with the parsed blocks.
+   * The blocks are generated and converted on demand, also when the bundle
+   * is only read, so the members that cache them are mutable.
+   */
+  mutable std::shared_ptr<const std::string> m_raw;
   /**
    * Pointer to the primary block of the bundle.
    */
@@ -170,11 +509,25 @@ class Bundle {
   /**
    * Pointer to the payload block of the bundle.
    */
-  std::shared_ptr<PayloadBlock> m_payloadBlock;
+  mutable std::shared_ptr<PayloadBlock> m_payloadBlock;
   /**
    * Vector containing the pointers to all the blocks that the bundle holds.
+   * The blocks not generated yet are nullptr.
+   */
+  mutable std::vector<std::shared_ptr<Block>> m_blocks;
+  /**
+   * Vector containing the index of every block in m_blocks.
+   */
+  mutable std::vector<BlockIndex> m_blockIndex;
+  /**
+   * Number of blocks converted to raw by toRaw().
+   */
+  mutable uint64_t m_convertedBlocks;
+  /**
+   * True if a block has been changed since the bundle was parsed or its
+   * checksums were added.
    */
-  std::vector<std::shared_ptr<Block>> m_blocks;
+  mutable bool m_changed;
 };
 
 #endif  // BUNDLEAGENT_BUNDLE_BUNDLE_H_
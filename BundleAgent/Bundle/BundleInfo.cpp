@@ -33,25 +33,30 @@
 const uint64_t g_timeFrom2000 = 946684800;
 
 BundleInfo::BundleInfo(Bundle &bundle)
-    : m_id(bundle.getId()),
+    : m_key(bundle.getKey()),
       m_destination(bundle.getPrimaryBlock()->getDestination()),
       m_source(bundle.getPrimaryBlock()->getSource()),
       m_creationTimestamp(bundle.getPrimaryBlock()->getCreationTimestamp()),
       m_creationTimestampSeqNumber(
           bundle.getPrimaryBlock()->getCreationTimestampSeqNumber()),
       m_lifetime(bundle.getPrimaryBlock()->getLifetime()),
-      m_size(bundle.toRaw().length()) {
-  std::vector<std::shared_ptr<Block>> blocks = bundle.getBlocks();
+      m_priority(0),
+      m_size(bundle.getRawLength()) {
+  if (bundle.getPrimaryBlock()->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::PRIORITY_EXPEDITED)) {
+    m_priority = 2;
+  } else if (bundle.getPrimaryBlock()->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::PRIORITY_NORMAL)) {
+    m_priority = 1;
+  }
+  // The index is enough to know the block types, so no block is generated.
+  std::vector<BlockIndex> blocks = bundle.getBlockIndex();
   blocks.erase(blocks.begin());
-  for (auto c : blocks) {
-    std::shared_ptr<CanonicalBlock> canonical_block = std::static_pointer_cast<
-        CanonicalBlock>(c);
-    m_canoniclaTypeBlocks.insert(canonical_block->getBlockType());
-    if (static_cast<CanonicalBlockTypes>(canonical_block->getBlockType())
+  for (auto &index : blocks) {
+    m_canoniclaTypeBlocks.insert(index.blockType);
+    if (static_cast<CanonicalBlockTypes>(index.blockType)
         == CanonicalBlockTypes::METADATA_EXTENSION_BLOCK) {
-      std::shared_ptr<MetadataExtensionBlock> meb = std::static_pointer_cast<
-                MetadataExtensionBlock>(canonical_block);
-      m_metadataTypeBlocks.insert(meb->getMetadataType());
+      m_metadataTypeBlocks.insert(index.metadataType);
     }
   }
 }
@@ -60,7 +65,11 @@ BundleInfo::~BundleInfo() {
 }
 
 std::string BundleInfo::getId() const {
-  return m_id;
+  return m_key.toString();
+}
+
+const BundleKey& BundleInfo::getKey() const {
+  return m_key;
 }
 
 std::string BundleInfo::getDestination() const {
@@ -91,6 +100,14 @@ uint64_t BundleInfo::getSize() const {
   return m_size;
 }
 
+uint8_t BundleInfo::getPriority() const {
+  return m_priority;
+}
+
+uint64_t BundleInfo::getDeadline() const {
+  return m_creationTimestamp + m_lifetime;
+}
+
 bool BundleInfo::hasMetadataTypeBlock(uint8_t type) const {
   auto it = m_metadataTypeBlocks.find(type);
   return (it != m_metadataTypeBlocks.end());
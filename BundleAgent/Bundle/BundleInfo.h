@@ -50,6 +50,11 @@ class BundleInfo {
    * @return The id.
    */
   std::string getId() const;
+  /**
+   * Returns the key of the bundle.
+   * @return The key.
+   */
+  const BundleKey& getKey() const;
   /**
    * Returns the destination of the bundle.
    * @return The destination.
@@ -85,6 +90,17 @@ class BundleInfo {
    * @return The bytes size
    */
   uint64_t getSize() const;
+  /**
+   * Returns the priority class of the bundle.
+   * @return The priority, 0 for bulk, 1 for normal and 2 for expedited.
+   */
+  uint8_t getPriority() const;
+  /**
+   * Returns the time when the bundle expires, in seconds since the year 2000
+   * like the creation timestamp.
+   * @return The deadline.
+   */
+  uint64_t getDeadline() const;
   /**
    * Returns if the bundle has one metadata block of the specified type.
    * @param type The type to search.
@@ -100,9 +116,9 @@ class BundleInfo {
 
  private:
   /**
-   * Variable to hold the bundle id.
+   * Variable to hold the bundle key.
    */
-  std::string m_id;
+  BundleKey m_key;
   /**
    * Variable to hold the destination.
    */
@@ -123,6 +139,10 @@ class BundleInfo {
    * Variable to hold the lifetime.
    */
   uint64_t m_lifetime;
+  /**
+   * Variable to hold the priority class.
+   */
+  uint8_t m_priority;
   /**
    * Variable to hold the bundle size.
    */
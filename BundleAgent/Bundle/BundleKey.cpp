@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleKey.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the BundleKey class.
+ */
+
+#include "Bundle/BundleKey.h"
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+/**
+ * Table of interned sources. The ids are never released, a node only sees a
+ * limited number of source endpoints.
+ */
+struct SourceTable {
+  std::mutex mutex;
+  std::unordered_map<std::string, uint32_t> ids;
+  std::deque<std::string> sources;
+};
+
+SourceTable& getSourceTable() {
+  static SourceTable table;
+  return table;
+}
+
+/**
+ * Final mixing step of splitmix64.
+ */
+inline uint64_t mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+}  // namespace
+
+const uint32_t BundleKey::INVALID_SOURCE;
+const uint64_t BundleKey::NOT_FRAGMENT;
+
+BundleKey::BundleKey()
+    : m_sourceId(INVALID_SOURCE),
+      m_creationTimestamp(0),
+      m_creationTimestampSeqNumber(0),
+      m_fragmentOffset(NOT_FRAGMENT),
+      m_fragmentLength(0) {
+}
+
+BundleKey::BundleKey(const std::string &source, uint64_t timestamp,
+                     uint64_t seqNumber)
+    : m_sourceId(intern(source)),
+      m_creationTimestamp(timestamp),
+      m_creationTimestampSeqNumber(seqNumber),
+      m_fragmentOffset(NOT_FRAGMENT),
+      m_fragmentLength(0) {
+}
+
+BundleKey::BundleKey(const std::string &source, uint64_t timestamp,
+                     uint64_t seqNumber, uint64_t fragmentOffset,
+                     uint64_t fragmentLength)
+    : m_sourceId(intern(source)),
+      m_creationTimestamp(timestamp),
+      m_creationTimestampSeqNumber(seqNumber),
+      m_fragmentOffset(fragmentOffset),
+      m_fragmentLength(fragmentLength) {
+}
+
+BundleKey::~BundleKey() {
+}
+
+uint32_t BundleKey::intern(const std::string &source) {
+  SourceTable &table = getSourceTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  auto it = table.ids.find(source);
+  if (it != table.ids.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(table.sources.size());
+  table.sources.push_back(source);
+  table.ids.emplace(source, id);
+  return id;
+}
+
+std::string BundleKey::getSource() const {
+  if (!isValid()) {
+    return "";
+  }
+  SourceTable &table = getSourceTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  return table.sources[m_sourceId];
+}
+
+uint32_t BundleKey::getSourceId() const {
+  return m_sourceId;
+}
+
+uint64_t BundleKey::getCreationTimestamp() const {
+  return m_creationTimestamp;
+}
+
+uint64_t BundleKey::getCreationTimestampSeqNumber() const {
+  return m_creationTimestampSeqNumber;
+}
+
+bool BundleKey::isFragment() const {
+  return m_fragmentOffset != NOT_FRAGMENT;
+}
+
+uint64_t BundleKey::getFragmentOffset() const {
+  return isFragment() ? m_fragmentOffset : 0;
+}
+
+uint64_t BundleKey::getFragmentLength() const {
+  return m_fragmentLength;
+}
+
+BundleKey BundleKey::getWholeBundleKey() const {
+  BundleKey key = *this;
+  key.m_fragmentOffset = NOT_FRAGMENT;
+  key.m_fragmentLength = 0;
+  return key;
+}
+
+bool BundleKey::isValid() const {
+  return m_sourceId != INVALID_SOURCE;
+}
+
+size_t BundleKey::hash() const {
+  uint64_t h = mix(m_creationTimestamp ^ (uint64_t(m_sourceId) << 32));
+  h = mix(h ^ m_creationTimestampSeqNumber);
+  if (isFragment()) {
+    h = mix(h ^ m_fragmentOffset);
+    h = mix(h ^ m_fragmentLength);
+  }
+  return static_cast<size_t>(h);
+}
+
+std::string BundleKey::toString() const {
+  if (!isValid()) {
+    return "";
+  }
+  std::stringstream ss;
+  ss << getSource() << "_" << m_creationTimestamp << "_"
+     << m_creationTimestampSeqNumber;
+  if (isFragment()) {
+    ss << "_" << m_fragmentOffset << "_" << m_fragmentLength;
+  }
+  return ss.str();
+}
+
+bool BundleKey::operator==(const BundleKey &other) const {
+  return m_sourceId == other.m_sourceId
+      && m_creationTimestamp == other.m_creationTimestamp
+      && m_creationTimestampSeqNumber == other.m_creationTimestampSeqNumber
+      && m_fragmentOffset == other.m_fragmentOffset
+      && m_fragmentLength == other.m_fragmentLength;
+}
+
+bool BundleKey::operator!=(const BundleKey &other) const {
+  return !(*this == other);
+}
+
+bool BundleKey::operator<(const BundleKey &other) const {
+  if (m_sourceId != other.m_sourceId) {
+    return m_sourceId < other.m_sourceId;
+  }
+  if (m_creationTimestamp != other.m_creationTimestamp) {
+    return m_creationTimestamp < other.m_creationTimestamp;
+  }
+  if (m_creationTimestampSeqNumber != other.m_creationTimestampSeqNumber) {
+    return m_creationTimestampSeqNumber < other.m_creationTimestampSeqNumber;
+  }
+  if (m_fragmentOffset != other.m_fragmentOffset) {
+    return m_fragmentOffset < other.m_fragmentOffset;
+  }
+  return m_fragmentLength < other.m_fragmentLength;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleKey.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the class BundleKey.
+ */
+#ifndef BUNDLEAGENT_BUNDLE_BUNDLEKEY_H_
+#define BUNDLEAGENT_BUNDLE_BUNDLEKEY_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+ * CLASS BundleKey
+ * This class identifies a bundle by its source, creation timestamp and
+ * creation timestamp sequence number. Fragments are also identified by their
+ * fragment offset and their payload length, as described into the RFC 5050.
+ *
+ * The source is interned into a numeric id, so the key is small, cheap to
+ * compare and cheap to hash. The string form is only generated for logging
+ * and file names.
+ */
+class BundleKey {
+ public:
+  /**
+   * @brief Empty constructor.
+   *
+   * Generates an invalid key, that does not match any bundle.
+   */
+  BundleKey();
+  /**
+   * @brief Generates the key of a bundle.
+   *
+   * @param source The source of the bundle.
+   * @param timestamp The creation timestamp of the bundle.
+   * @param seqNumber The creation timestamp sequence number of the bundle.
+   */
+  BundleKey(const std::string &source, uint64_t timestamp,
+            uint64_t seqNumber);
+  /**
+   * @brief Generates the key of a fragment.
+   *
+   * @param source The source of the bundle.
+   * @param timestamp The creation timestamp of the bundle.
+   * @param seqNumber The creation timestamp sequence number of the bundle.
+   * @param fragmentOffset The offset of the fragment into the payload of the
+   *                       original bundle.
+   * @param fragmentLength The payload length of the fragment.
+   */
+  BundleKey(const std::string &source, uint64_t timestamp, uint64_t seqNumber,
+            uint64_t fragmentOffset, uint64_t fragmentLength);
+  /**
+   * Destructor of the class.
+   */
+  ~BundleKey();
+  /**
+   * @brief Returns the source of the key.
+   *
+   * @return The source, or an empty string if the key is not valid.
+   */
+  std::string getSource() const;
+  /**
+   * @brief Returns the interned id of the source.
+   *
+   * @return The source id.
+   */
+  uint32_t getSourceId() const;
+  /**
+   * @brief Returns the creation timestamp of the key.
+   *
+   * @return The creation timestamp.
+   */
+  uint64_t getCreationTimestamp() const;
+  /**
+   * @brief Returns the creation timestamp sequence number of the key.
+   *
+   * @return The creation timestamp sequence number.
+   */
+  uint64_t getCreationTimestampSeqNumber() const;
+  /**
+   * @brief Tells if the key identifies a fragment.
+   *
+   * @return True if the key has a fragment offset.
+   */
+  bool isFragment() const;
+  /**
+   * @brief Returns the fragment offset of the key.
+   *
+   * @return The fragment offset, 0 if the key is not a fragment.
+   */
+  uint64_t getFragmentOffset() const;
+  /**
+   * @brief Returns the fragment length of the key.
+   *
+   * @return The payload length of the fragment, 0 if the key is not a
+   * fragment.
+   */
+  uint64_t getFragmentLength() const;
+  /**
+   * @brief Returns the key of the bundle the fragment belongs to.
+   *
+   * @return The key without the fragment offset and length.
+   */
+  BundleKey getWholeBundleKey() const;
+  /**
+   * @brief Tells if the key identifies a bundle.
+   *
+   * @return True if the key has been generated from a bundle.
+   */
+  bool isValid() const;
+  /**
+   * @brief Returns the hash of the key.
+   *
+   * @return The hash value.
+   */
+  size_t hash() const;
+  /**
+   * @brief Returns the string form of the key.
+   *
+   * The format is source_timestamp_seqNumber, fragments add
+   * _fragmentOffset_fragmentLength.
+   *
+   * @return The key as a string, or an empty string if the key is not valid.
+   */
+  std::string toString() const;
+
+  bool operator==(const BundleKey &other) const;
+  bool operator!=(const BundleKey &other) const;
+  bool operator<(const BundleKey &other) const;
+
+ private:
+  /**
+   * @brief Returns the id of the given source, assigning a new one if the
+   * source has not been seen before.
+   *
+   * @param source The source to intern.
+   * @return The source id.
+   */
+  static uint32_t intern(const std::string &source);
+  /**
+   * Interned source id.
+   */
+  uint32_t m_sourceId;
+  /**
+   * Creation timestamp.
+   */
+  uint64_t m_creationTimestamp;
+  /**
+   * Creation timestamp sequence number.
+   */
+  uint64_t m_creationTimestampSeqNumber;
+  /**
+   * Fragment offset, NOT_FRAGMENT if the key is not a fragment.
+   */
+  uint64_t m_fragmentOffset;
+  /**
+   * Payload length of the fragment, 0 if the key is not a fragment.
+   */
+  uint64_t m_fragmentLength;
+  /**
+   * Value used as source id of the invalid keys.
+   */
+  static const uint32_t INVALID_SOURCE = UINT32_MAX;
+  /**
+   * Value used as fragment offset of the keys that are not fragments.
+   */
+  static const uint64_t NOT_FRAGMENT = UINT64_MAX;
+};
+
+namespace std {
+template<>
+struct hash<BundleKey> {
+  size_t operator()(const BundleKey &key) const {
+    return key.hash();
+  }
+};
+}  // namespace std
+
+#endif  // BUNDLEAGENT_BUNDLE_BUNDLEKEY_H_
@@ -26,6 +26,11 @@
 
 #include <cstdint>
 
+enum class BundleEncoding : uint8_t {
+  RFC5050 = 0x00,
+  BPV7 = 0x01
+};
+
 enum class PrimaryBlockControlFlags : uint32_t {
   IS_FRAGMENT = 0,
   IS_ADMINISTRATIVE_RECORD = 1,
@@ -63,7 +68,9 @@ enum class MetadataTypes : uint8_t {
   FORWARDING_MEB = 0x03,
   ROUTE_REPORTING_MEB = 0x04,
   CODE_DATA_CARRIER_MEB = 0x05,
-  FRAMEWORK_MEB = 0x06
+  FRAMEWORK_MEB = 0x06,
+  COMPRESSION_MEB = 0x07,
+  INTEGRITY_MEB = 0x08
 };
 
 enum class RoutingAlgorithms : uint8_t {
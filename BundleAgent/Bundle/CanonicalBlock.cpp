@@ -26,6 +26,7 @@
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <memory>
 #include "Utils/SDNV.h"
 #include "Utils/Logger.h"
 
@@ -36,7 +37,13 @@ CanonicalBlock::CanonicalBlock()
 }
 
 CanonicalBlock::CanonicalBlock(const std::string &rawData)
+    : CanonicalBlock(std::make_shared<const std::string>(rawData), 0) {
+}
+
+CanonicalBlock::CanonicalBlock(const std::shared_ptr<const std::string> &buffer,
+                               size_t offset)
     : m_blockType(0),
+      m_bodyDataIndex(0),
       m_procFlags() {
   /**
    * The canonical block contains
@@ -46,62 +53,74 @@ CanonicalBlock::CanonicalBlock(const std::string &rawData)
    * Block Length as SDNV
    * BodyDataContent variable length
    */
-  initFromRaw(rawData);
+  initFromRaw(buffer, offset);
 }
 
 CanonicalBlock::~CanonicalBlock() {
 }
 
-void CanonicalBlock::initFromRaw(const std::string &rawData) {
+void CanonicalBlock::initFromRaw(
+    const std::shared_ptr<const std::string> &buffer, size_t offset) {
   LOG(83) << "Generating canonicalblock from raw data";
-  // Get the Block Type
   try {
-    m_blockType = static_cast<uint8_t>(rawData[0]);
-    size_t blockLength = 1;
-    std::string data = rawData.substr(1);
-    // Get the proc flags.
-    size_t dataSize = SDNV::getLength(data);
-    blockLength += dataSize;
-    uint64_t procFlags = SDNV::decode(data);
-    m_procFlags = std::bitset<7>(procFlags);
-    data = data.substr(dataSize);
-    if (m_procFlags.test(
-        static_cast<uint32_t>(CanonicalBlockControlFlags::EID_FIELD))) {
-      dataSize = SDNV::getLength(data);
-      blockLength += dataSize;
-      int numberOfEID = SDNV::decode(data);
-      data = data.substr(dataSize);
-      for (int i = 0; i < numberOfEID; ++i) {
-        // Every EID consists of two SDNV fields
-        dataSize = SDNV::getLength(data);
-        blockLength += dataSize;
-        data = data.substr(dataSize);
-        dataSize = SDNV::getLength(data);
-        blockLength += dataSize;
-        data = data.substr(dataSize);
-      }
-    }
-    // Block data Length
-    dataSize = SDNV::getLength(data);
-    blockLength += dataSize;
-    m_bodyDataIndex = blockLength;
-    uint64_t blockDataSize = SDNV::decode(data);
-    blockLength += blockDataSize;
-    m_raw = rawData.substr(0, blockLength);
+    setRaw(buffer, offset, parseHeader(buffer->data(), buffer->size(), offset));
+  } catch (...) {
+    throw BlockConstructionException("[CanonicalBlock] Bad raw format");
+  }
+}
+
+void CanonicalBlock::initFromFile(const std::shared_ptr<const MappedFile> &file,
+                                  size_t offset) {
+  LOG(83) << "Generating canonicalblock from mapped file";
+  try {
+    setRaw(file, offset, parseHeader(file->data(), file->size(), offset));
   } catch (...) {
     throw BlockConstructionException("[CanonicalBlock] Bad raw format");
   }
 }
 
+size_t CanonicalBlock::parseHeader(const char *data, size_t size,
+                                   size_t offset) {
+  if (offset >= size) {
+    throw std::out_of_range("[CanonicalBlock] Block out of the buffer");
+  }
+  const uint8_t *position = reinterpret_cast<const uint8_t*>(data + offset);
+  const uint8_t *end = reinterpret_cast<const uint8_t*>(data + size);
+  // Get the Block Type
+  m_blockType = *position++;
+  // Get the proc flags.
+  uint64_t value;
+  position += SDNV::decode(position, end, value);
+  m_procFlags = std::bitset<7>(value);
+  if (m_procFlags.test(
+      static_cast<uint32_t>(CanonicalBlockControlFlags::EID_FIELD))) {
+    uint64_t numberOfEID;
+    position += SDNV::decode(position, end, numberOfEID);
+    for (uint64_t i = 0; i < numberOfEID; ++i) {
+      // Every EID consists of two SDNV fields
+      position += SDNV::decode(position, end, value);
+      position += SDNV::decode(position, end, value);
+    }
+  }
+  // Block data Length
+  uint64_t blockDataSize;
+  position += SDNV::decode(position, end, blockDataSize);
+  m_bodyDataIndex = position - reinterpret_cast<const uint8_t*>(data + offset);
+  if (blockDataSize > static_cast<uint64_t>(end - position)) {
+    throw std::out_of_range("[CanonicalBlock] Body out of the buffer");
+  }
+  return m_bodyDataIndex + blockDataSize;
+}
+
 std::string CanonicalBlock::toRaw() {
   std::stringstream ss;
   ss << m_blockType;
   ss << SDNV::encode(m_procFlags.to_ulong());
-  std::string data = m_raw.substr(m_bodyDataIndex);
-  ss << SDNV::encode(data.size());
-  ss << data;
-  m_raw = ss.str();
-  return m_raw;
+  ss << SDNV::encode(m_rawLength - m_bodyDataIndex);
+  ss.write(getRawData() + m_bodyDataIndex, m_rawLength - m_bodyDataIndex);
+  std::string raw = ss.str();
+  setRaw(raw);
+  return raw;
 }
 
 uint8_t CanonicalBlock::getBlockType() {
@@ -109,11 +128,13 @@ uint8_t CanonicalBlock::getBlockType() {
 }
 
 void CanonicalBlock::setProcFlag(CanonicalBlockControlFlags procFlag) {
+  setDirty();
   LOG(83) << "Setting Flag " << static_cast<int>(procFlag);
   m_procFlags.set(static_cast<uint32_t>(procFlag));
 }
 
 void CanonicalBlock::unsetProcFlag(CanonicalBlockControlFlags procFlag) {
+  setDirty();
   LOG(83) << "Clearing Flag " << static_cast<int>(procFlag);
   m_procFlags.reset(static_cast<uint32_t>(procFlag));
 }
@@ -123,6 +144,10 @@ bool CanonicalBlock::checkProcFlag(CanonicalBlockControlFlags procFlag) {
   return m_procFlags.test(static_cast<uint32_t>(procFlag));
 }
 
+std::bitset<7> CanonicalBlock::getProcFlags() const {
+  return m_procFlags;
+}
+
 std::string CanonicalBlock::toString() {
   std::stringstream ss;
   ss << "\tBlock processing control flags" << std::endl
@@ -26,6 +26,7 @@
 
 #include <cstdint>
 #include <bitset>
+#include <memory>
 #include <string>
 #include "Bundle/BundleTypes.h"
 #include "Bundle/Block.h"
@@ -51,6 +52,17 @@ class CanonicalBlock : public Block {
    * @param raw data of this block.
    */
   explicit CanonicalBlock(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * Generates the canonical block that starts at the given offset of the
+   * buffer, without copying it.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  CanonicalBlock(const std::shared_ptr<const std::string> &buffer,
+                 size_t offset);
   /**
    * Destructor of the class.
    */
@@ -101,6 +113,12 @@ class CanonicalBlock : public Block {
    * @sa BlockControlFlags
    */
   bool checkProcFlag(CanonicalBlockControlFlags procFlag);
+  /**
+   * @brief Returns all the processing control flags.
+   *
+   * @return The flags, indexed by CanonicalBlockControlFlags.
+   */
+  std::bitset<7> getProcFlags() const;
   /**
    * @brief Returns an string with a nice view of the block information.
    *
@@ -113,11 +131,23 @@ class CanonicalBlock : public Block {
    * @brief Parses a Canonical Block from raw.
    *
    * This function parses a canonical block from raw.
-   * Saving the raw data into the block.
+   * The block keeps a view of the buffer as its raw data.
    *
-   * @param rawData Raw data to parse.
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
    */
-  void initFromRaw(const std::string &rawData);
+  void initFromRaw(const std::shared_ptr<const std::string> &buffer,
+                   size_t offset);
+  /**
+   * @brief Parses a Canonical Block from a mapped file.
+   *
+   * Like initFromRaw(), but the block keeps a view of the file as its raw data.
+   *
+   * @param file The mapped file that holds the raw bundle.
+   * @param offset The position of the block into the file.
+   */
+  void initFromFile(const std::shared_ptr<const MappedFile> &file,
+                    size_t offset);
   /**
    * Variable that holds the Block Type value.
    */
@@ -125,11 +155,22 @@ class CanonicalBlock : public Block {
   /**
    * Variable that hold the bodyDataIndex of the rawData
    */
-  int m_bodyDataIndex;
+  size_t m_bodyDataIndex;
   /**
    * Block processing control flags, as described into the RFC 5050.
    */
   std::bitset<7> m_procFlags;
+
+ private:
+  /**
+   * @brief Parses the fields of the block that precede its body.
+   *
+   * @param data The first byte of the raw bundle.
+   * @param size The size of the raw bundle.
+   * @param offset The position of the block into the raw bundle.
+   * @return The length of the whole block.
+   */
+  size_t parseHeader(const char *data, size_t size, size_t offset);
 };
 
 #endif  // BUNDLEAGENT_BUNDLE_CANONICALBLOCK_H_
@@ -26,6 +26,7 @@
 #include <sstream>
 #include <iostream>
 #include <vector>
+#include <memory>
 
 #include "Bundle/CodeDataCarrierMEB.h"
 #include "Bundle/BundleTypes.h"
@@ -49,9 +50,14 @@ CodeDataCarrierMEB::CodeDataCarrierMEB(std::string code, std::string data)
   }
 }
 
-CodeDataCarrierMEB::CodeDataCarrierMEB(const std::string& rawData) {
+CodeDataCarrierMEB::CodeDataCarrierMEB(const std::string& rawData)
+    : CodeDataCarrierMEB(std::make_shared<const std::string>(rawData), 0) {
+}
+
+CodeDataCarrierMEB::CodeDataCarrierMEB(
+    const std::shared_ptr<const std::string> &buffer, size_t offset) {
   try {
-    initFromRaw(rawData);
+    initFromRaw(buffer, offset);
   } catch (...) {
     throw BlockConstructionException("[CodeDataCarrierMEB] Bad raw format");
   }
@@ -60,8 +66,9 @@ CodeDataCarrierMEB::CodeDataCarrierMEB(const std::string& rawData) {
 CodeDataCarrierMEB::~CodeDataCarrierMEB() {
 }
 
-void CodeDataCarrierMEB::initFromRaw(const std::string& rawData) {
-  MetadataExtensionBlock::initFromRaw(rawData);
+void CodeDataCarrierMEB::initFromRaw(
+    const std::shared_ptr<const std::string> &buffer, size_t offset) {
+  MetadataExtensionBlock::initFromRaw(buffer, offset);
   try {
     std::stringstream ss(m_metadata);
     ss >> m_codeLength;
@@ -87,8 +94,9 @@ std::string CodeDataCarrierMEB::toRaw() {
   ss << SDNV::encode(SDNV::getLength(m_metadataType) + m_metadata.length());
   ss << SDNV::encode(m_metadataType);
   ss << m_metadata;
-  m_raw = ss.str();
-  return m_raw;
+  std::string raw = ss.str();
+  setRaw(raw);
+  return raw;
 }
 
 uint16_t CodeDataCarrierMEB::getCodeLength() {
@@ -104,6 +112,7 @@ nlohmann::json CodeDataCarrierMEB::getData() {
 }
 
 void CodeDataCarrierMEB::setData(std::string data) {
+  setDirty();
   try {
     m_data = nlohmann::json::parse(data);
   } catch (std::invalid_argument& e) {
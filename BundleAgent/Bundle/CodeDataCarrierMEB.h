@@ -26,6 +26,7 @@
 #ifndef BUNDLEAGENT_BUNDLE_CODEDATACARRIERMEB_H_
 #define BUNDLEAGENT_BUNDLE_CODEDATACARRIERMEB_H_
 
+#include <memory>
 #include <string>
 
 #include "MetadataExtensionBlock.h"
@@ -57,6 +58,16 @@ class CodeDataCarrierMEB : public MetadataExtensionBlock {
    * @param rawData The raw data that contains the CodeDataCarrierMEB.
    */
   explicit CodeDataCarrierMEB(const std::string& rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate a CodeDataCarrierMEB from the raw bundle buffer, starting at the
+   * given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  CodeDataCarrierMEB(const std::shared_ptr<const std::string> &buffer, size_t offset);
   /**
    * Destructor of the class.
    */
@@ -66,9 +77,11 @@ class CodeDataCarrierMEB : public MetadataExtensionBlock {
    *
    * This function parses a NewMeb from raw saving the raw data into the block.
    *
-   * @param rawData Raw data to parse.
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
    */
-  void initFromRaw(const std::string& rawData);
+  void initFromRaw(const std::shared_ptr<const std::string> &buffer,
+                   size_t offset);
   /**
    * Converts the CodeDataCarrierMEB in raw format.
    *
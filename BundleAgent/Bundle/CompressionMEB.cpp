@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CompressionMEB.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the Compression MEB.
+ */
+
+#include "Bundle/CompressionMEB.h"
+#include <zlib.h>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "Bundle/BundleTypes.h"
+#include "Utils/SDNV.h"
+
+CompressionMEB::CompressionMEB(CompressionAlgorithms algorithm,
+                               uint64_t originalLength)
+    : MetadataExtensionBlock(),
+      m_algorithm(algorithm),
+      m_originalLength(originalLength) {
+  m_blockType =
+      static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK);
+  m_metadataType = static_cast<uint8_t>(MetadataTypes::COMPRESSION_MEB);
+  m_metadata = std::string(1, static_cast<char>(algorithm))
+      + SDNV::encode(originalLength);
+}
+
+CompressionMEB::CompressionMEB(const std::string &rawData)
+    : MetadataExtensionBlock() {
+  try {
+    initFromRaw(std::make_shared<const std::string>(rawData), 0);
+    decodeMetadata();
+  } catch (...) {
+    throw BlockConstructionException("[CompressionMEB] Bad raw format");
+  }
+}
+
+CompressionMEB::CompressionMEB(const std::shared_ptr<const std::string> &buffer,
+                               size_t offset)
+    : MetadataExtensionBlock() {
+  try {
+    initFromRaw(buffer, offset);
+    decodeMetadata();
+  } catch (...) {
+    throw BlockConstructionException("[CompressionMEB] Bad raw format");
+  }
+}
+
+CompressionMEB::~CompressionMEB() {
+}
+
+void CompressionMEB::decodeMetadata() {
+  if (m_metadata.empty()) {
+    throw std::out_of_range("Empty metadata");
+  }
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(m_metadata.data());
+  const uint8_t *end = data + m_metadata.size();
+  m_algorithm = static_cast<CompressionAlgorithms>(*data);
+  SDNV::decode(data + 1, end, m_originalLength);
+}
+
+CompressionAlgorithms CompressionMEB::getAlgorithm() {
+  return m_algorithm;
+}
+
+uint64_t CompressionMEB::getOriginalLength() {
+  return m_originalLength;
+}
+
+std::string CompressionMEB::compress(CompressionAlgorithms algorithm,
+                                     const char *data, size_t length,
+                                     int level) {
+  if (algorithm != CompressionAlgorithms::DEFLATE) {
+    throw CompressionException("[CompressionMEB] Unknown algorithm");
+  }
+  uLongf compressedLength = compressBound(length);
+  std::string compressed(compressedLength, '\0');
+  int result = compress2(reinterpret_cast<Bytef*>(&compressed[0]),
+                         &compressedLength,
+                         reinterpret_cast<const Bytef*>(data), length, level);
+  if (result != Z_OK) {
+    throw CompressionException(
+        "[CompressionMEB] Cannot compress the payload, error "
+            + std::to_string(result));
+  }
+  compressed.resize(compressedLength);
+  return compressed;
+}
+
+std::string CompressionMEB::decompress(const char *data, size_t length) {
+  if (m_algorithm != CompressionAlgorithms::DEFLATE) {
+    throw CompressionException("[CompressionMEB] Unknown algorithm");
+  }
+  std::string payload(m_originalLength, '\0');
+  uLongf payloadLength = m_originalLength;
+  int result = uncompress(reinterpret_cast<Bytef*>(&payload[0]),
+                          &payloadLength,
+                          reinterpret_cast<const Bytef*>(data), length);
+  if (result != Z_OK || payloadLength != m_originalLength) {
+    throw CompressionException(
+        "[CompressionMEB] Cannot decompress the payload, error "
+            + std::to_string(result));
+  }
+  return payload;
+}
+
+std::string CompressionMEB::toString() {
+  std::stringstream ss;
+  ss << "Compression block:" << std::endl << MetadataExtensionBlock::toString()
+     << "\tAlgorithm: " << static_cast<int>(m_algorithm) << std::endl
+     << "\tOriginal length: " << m_originalLength << std::endl;
+  return ss.str();
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CompressionMEB.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the Compression MEB.
+ */
+
+#ifndef BUNDLEAGENT_BUNDLE_COMPRESSIONMEB_H_
+#define BUNDLEAGENT_BUNDLE_COMPRESSIONMEB_H_
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "Bundle/MetadataExtensionBlock.h"
+
+class CompressionException : public std::runtime_error {
+ public:
+  explicit CompressionException(const std::string &what)
+      : runtime_error(what) {
+  }
+};
+
+/**
+ * Algorithms used to compress the payload.
+ */
+enum class CompressionAlgorithms : uint8_t {
+  DEFLATE = 0x01
+};
+
+/**
+ * CLASS CompressionMEB
+ * This block marks the payload of the bundle as compressed.
+ *
+ * The metadata holds the algorithm, one byte, followed by the SDNV length of
+ * the original payload. The relays forward the bundle as it is, the payload
+ * is only decompressed when it is delivered.
+ */
+class CompressionMEB : public MetadataExtensionBlock {
+ public:
+  /**
+   * @brief Constructor.
+   *
+   * @param algorithm The algorithm used to compress the payload.
+   * @param originalLength The length of the payload before compressing it.
+   */
+  CompressionMEB(CompressionAlgorithms algorithm, uint64_t originalLength);
+  /**
+   * @brief Raw constructor.
+   *
+   * @param rawData The raw data that contains the Compression MEB.
+   */
+  explicit CompressionMEB(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate a Compression MEB from the raw bundle buffer, starting
+   * at the given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  CompressionMEB(const std::shared_ptr<const std::string> &buffer,
+                 size_t offset);
+  /**
+   * Destructor of the class.
+   */
+  virtual ~CompressionMEB();
+  /**
+   * @brief Returns the algorithm used to compress the payload.
+   *
+   * @return The algorithm.
+   */
+  CompressionAlgorithms getAlgorithm();
+  /**
+   * @brief Returns the length of the payload before compressing it.
+   *
+   * @return The length in bytes.
+   */
+  uint64_t getOriginalLength();
+  /**
+   * @brief Compresses the given data.
+   *
+   * Throws a CompressionException if the data can not be compressed.
+   *
+   * @param algorithm The algorithm to use.
+   * @param data The data to compress.
+   * @param length The length of the data.
+   * @param level The compression level, from 1 (fastest) to 9 (smallest).
+   * @return The compressed data.
+   */
+  static std::string compress(CompressionAlgorithms algorithm,
+                              const char *data, size_t length, int level);
+  /**
+   * @brief Decompresses a payload compressed as described by this block.
+   *
+   * Throws a CompressionException if the data is not valid or its length is
+   * not the original length.
+   *
+   * @param data The compressed data.
+   * @param length The length of the compressed data.
+   * @return The original payload.
+   */
+  std::string decompress(const char *data, size_t length);
+  /**
+   * @brief Returns an string with a nice view of the block information.
+   *
+   * @return The string with the block information.
+   */
+  std::string toString();
+
+ private:
+  /**
+   * Parses the algorithm and the original length from the metadata.
+   */
+  void decodeMetadata();
+  /**
+   * Algorithm used to compress the payload.
+   */
+  CompressionAlgorithms m_algorithm;
+  /**
+   * Length of the payload before compressing it.
+   */
+  uint64_t m_originalLength;
+};
+
+#endif  // BUNDLEAGENT_BUNDLE_COMPRESSIONMEB_H_
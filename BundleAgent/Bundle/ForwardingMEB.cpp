@@ -22,6 +22,7 @@
  * This file contains the implementation of Forwarding MEB.
  */
 
+#include <memory>
 #include <string>
 #include <sstream>
 #include "Bundle/ForwardingMEB.h"
@@ -31,7 +32,7 @@ ForwardingMEB::ForwardingMEB(const std::string &softCode, bool isRaw)
     : MetadataExtensionBlock() {
   if (isRaw) {
     try {
-      initFromRaw(softCode);
+      initFromRaw(std::make_shared<const std::string>(softCode), 0);
       m_softCode = m_metadata;
     } catch (...) {
       throw BlockConstructionException("[ForwardingMEB] Bad raw format");
@@ -45,6 +46,17 @@ ForwardingMEB::ForwardingMEB(const std::string &softCode, bool isRaw)
   }
 }
 
+ForwardingMEB::ForwardingMEB(const std::shared_ptr<const std::string> &buffer,
+                             size_t offset)
+    : MetadataExtensionBlock() {
+  try {
+    initFromRaw(buffer, offset);
+    m_softCode = m_metadata;
+  } catch (...) {
+    throw BlockConstructionException("[ForwardingMEB] Bad raw format");
+  }
+}
+
 ForwardingMEB::~ForwardingMEB() {
 }
 
@@ -26,6 +26,7 @@
 #ifndef BUNDLEAGENT_BUNDLE_FORWARDINGMEB_H_
 #define BUNDLEAGENT_BUNDLE_FORWARDINGMEB_H_
 
+#include <memory>
 #include <string>
 #include "Bundle/MetadataExtensionBlock.h"
 
@@ -37,6 +38,16 @@ class ForwardingMEB : public MetadataExtensionBlock {
    * This will generate a new Forwarding MEB.
    */
   explicit ForwardingMEB(const std::string &softCode, bool isRaw = false);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate the Forwarding MEB that starts at the given offset of the
+   * buffer.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  ForwardingMEB(const std::shared_ptr<const std::string> &buffer, size_t offset);
 
   /**
    * Destructor of the class.
@@ -38,6 +38,8 @@
 #include "Utils/Logger.h"
 #include "Utils/SDNV.h"
 
+const uint8_t FrameworkMEB::BINARY_FORMAT_VERSION;
+
 FrameworkMEB::FrameworkMEB(
     uint8_t fwkId,
     std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions,
@@ -46,15 +48,8 @@ FrameworkMEB::FrameworkMEB(
       m_fwkId(fwkId),
       m_fwkExts(extensions),
       m_bundleState(state) {
-  std::stringstream ss;
   m_metadataType = static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB);
-  ss << m_fwkId << std::to_string(static_cast<uint8_t>(m_fwkExts.size()));
-  for (auto& ext : m_fwkExts) {
-    ss << ext.second->getFwkExtId() << ext.second->getCodeLength()
-       << ext.second->getSwSrcCode();
-  }
-  ss << m_bundleState;
-  m_metadata = ss.str();
+  m_metadata = encodeMetadata();
 }
 
 FrameworkMEB::FrameworkMEB(uint8_t fkwId)
@@ -62,27 +57,89 @@ FrameworkMEB::FrameworkMEB(uint8_t fkwId)
       m_fwkId(fkwId),
       m_fwkExts(),
       m_bundleState() {
-  std::stringstream ss;
   m_metadataType = static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB);
-  ss << m_fwkId << std::to_string(static_cast<uint8_t>(m_fwkExts.size()));
-  for (auto& ext : m_fwkExts) {
-    ss << ext.second->getFwkExtId() << ext.second->getCodeLength()
-       << ext.second->getSwSrcCode();
-  }
-  ss << m_bundleState;
-  m_metadata = ss.str();
+  m_metadata = encodeMetadata();
+}
+
+FrameworkMEB::FrameworkMEB(const std::string& rawData)
+    : FrameworkMEB(std::make_shared<const std::string>(rawData), 0) {
 }
 
-FrameworkMEB::FrameworkMEB(const std::string& rawData) {
+FrameworkMEB::FrameworkMEB(const std::shared_ptr<const std::string> &buffer,
+                           size_t offset) {
   try {
-    initFromRaw(rawData);
+    initFromRaw(buffer, offset);
   } catch (const std::out_of_range& e) {
     throw BlockConstructionException("[Framework MEB] Bad raw format");
   }
 }
 
-void FrameworkMEB::initFromRaw(const std::string& rawData) {
-  MetadataExtensionBlock::initFromRaw(rawData);
+void FrameworkMEB::initFromRaw(
+    const std::shared_ptr<const std::string> &buffer, size_t offset) {
+  MetadataExtensionBlock::initFromRaw(buffer, offset);
+  if (m_metadata.size() > 1
+      && static_cast<uint8_t>(m_metadata[1]) == BINARY_FORMAT_VERSION) {
+    decodeBinaryMetadata();
+  } else {
+    decodeTextMetadata();
+  }
+}
+
+std::string FrameworkMEB::encodeMetadata() {
+  std::string metadata;
+  metadata.push_back(static_cast<char>(m_fwkId));
+  metadata.push_back(static_cast<char>(BINARY_FORMAT_VERSION));
+  metadata += SDNV::encode(m_fwkExts.size());
+  for (auto &ext : m_fwkExts) {
+    metadata += SDNV::encode(ext.second->getFwkExtId());
+    metadata += SDNV::encode(ext.second->getCodeLength());
+    metadata += ext.second->getSwSrcCode();
+  }
+  std::vector<uint8_t> state = nlohmann::json::to_cbor(m_bundleState);
+  metadata += SDNV::encode(state.size());
+  metadata.append(state.begin(), state.end());
+  return metadata;
+}
+
+void FrameworkMEB::decodeBinaryMetadata() {
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(m_metadata.data());
+  const uint8_t *end = data + m_metadata.size();
+  m_fwkId = data[0];
+  data += 2;
+  try {
+    uint64_t numExtensions;
+    data += SDNV::decode(data, end, numExtensions);
+    for (uint64_t i = 0; i < numExtensions; ++i) {
+      uint64_t extensionId;
+      uint64_t codeLength;
+      data += SDNV::decode(data, end, extensionId);
+      data += SDNV::decode(data, end, codeLength);
+      if (codeLength > static_cast<uint64_t>(end - data)) {
+        throw BlockConstructionException("[FrameworkMEB] Bad raw format");
+      }
+      std::string code(reinterpret_cast<const char*>(data), codeLength);
+      data += codeLength;
+      m_fwkExts[static_cast<uint8_t>(extensionId)] = std::make_shared<
+          FrameworkExtension>(static_cast<uint8_t>(extensionId), code);
+    }
+    uint64_t stateLength;
+    data += SDNV::decode(data, end, stateLength);
+    if (stateLength > static_cast<uint64_t>(end - data)) {
+      throw BlockConstructionException("[FrameworkMEB] Bad raw format");
+    }
+    try {
+      m_bundleState = nlohmann::json::from_cbor(
+          std::vector<uint8_t>(data, data + stateLength));
+    } catch (const std::exception &e) {
+      throw BlockConstructionException(
+          "[FrameworkMEB] Bad Bundle State format");
+    }
+  } catch (const std::out_of_range &e) {
+    throw BlockConstructionException("[FrameworkMEB] Bad raw format");
+  }
+}
+
+void FrameworkMEB::decodeTextMetadata() {
   try {
     std::stringstream ss(m_metadata);
     ss >> m_fwkId;
@@ -138,22 +195,16 @@ FrameworkMEB::~FrameworkMEB() {
 
 std::string FrameworkMEB::toRaw() {
   LOG(87) << "Generating raw data from Framework MEB";
-  std::stringstream ss1;
-  ss1 << m_fwkId << std::to_string(static_cast<uint8_t>(m_fwkExts.size()));
-  for (auto &ext : m_fwkExts) {
-    ss1 << ext.second->getFwkExtId() << ext.second->getCodeLength()
-        << ext.second->getSwSrcCode();
-  }
-  ss1 << m_bundleState;
-  m_metadata = ss1.str();
+  m_metadata = encodeMetadata();
   std::stringstream ss;
   ss << m_blockType;
   ss << SDNV::encode(m_procFlags.to_ulong());
   ss << SDNV::encode(SDNV::getLength(m_metadataType) + m_metadata.length());
   ss << SDNV::encode(m_metadataType);
   ss << m_metadata;
-  m_raw = ss.str();
-  return m_raw;
+  std::string raw = ss.str();
+  setRaw(raw);
+  return raw;
 }
 
 uint8_t FrameworkMEB::getFwkId() {
@@ -165,6 +216,7 @@ std::map<uint8_t, std::shared_ptr<FrameworkExtension>> FrameworkMEB::getFwkExts(
 }
 
 nlohmann::json& FrameworkMEB::getBundleState() {
+  setDirty();
   return m_bundleState;
 }
 
@@ -177,10 +229,12 @@ std::shared_ptr<FrameworkExtension> FrameworkMEB::getFwkExt(uint8_t fwkExtId) {
 }
 
 void FrameworkMEB::setBundleState(nlohmann::json state) {
+  setDirty();
   m_bundleState = state;
 }
 
 void FrameworkMEB::addExtension(uint8_t extId, std::string code) {
+  setDirty();
   auto ext = std::make_shared<FrameworkExtension>(extId, code);
   m_fwkExts[extId] = ext;
 }
@@ -73,6 +73,16 @@ class FrameworkMEB : public MetadataExtensionBlock {
    * @param rawData The raw data that contains the FrameworkMEB.
    */
   explicit FrameworkMEB(const std::string& rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate a FrameworkMEB from the raw bundle buffer, starting at the
+   * given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  FrameworkMEB(const std::shared_ptr<const std::string> &buffer, size_t offset);
   /**
    * Destructor of the class.
    */
@@ -121,9 +131,11 @@ class FrameworkMEB : public MetadataExtensionBlock {
    *
    * This function initializes a Framework Metadata Extension Block from raw.
    *
-   * @param rawData Raw data to parse.
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
    */
-  void initFromRaw(const std::string& rawData);
+  void initFromRaw(const std::shared_ptr<const std::string> &buffer,
+                   size_t offset);
   /**
    * Function to get a framework extension by its id.
    *
@@ -139,6 +151,31 @@ class FrameworkMEB : public MetadataExtensionBlock {
   std::string toString();
 
  private:
+  /**
+   * @brief Generates the metadata in the binary format.
+   *
+   * The metadata is the framework id, the format version, the SDNV number of
+   * extensions, for each extension its SDNV id, SDNV code length and code,
+   * and at the end the SDNV length of the bundle state and the bundle state
+   * in CBOR.
+   *
+   * @return The metadata.
+   */
+  std::string encodeMetadata();
+  /**
+   * Parses the metadata in the binary format.
+   */
+  void decodeBinaryMetadata();
+  /**
+   * Parses the metadata in the text format of the first version, where the
+   * numbers are written in decimal and the bundle state is text JSON.
+   */
+  void decodeTextMetadata();
+  /**
+   * Version of the binary format, stored after the framework id. The text
+   * format has a decimal digit there.
+   */
+  static const uint8_t BINARY_FORMAT_VERSION = 0x81;
   /**
    * Defines the id of the framework.
    */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntegrityMEB.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the Integrity MEB.
+ */
+
+#include "Bundle/IntegrityMEB.h"
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Bundle/BundleTypes.h"
+#include "Utils/SDNV.h"
+
+const uint8_t IntegrityMEB::CRC32C_ALGORITHM;
+
+IntegrityMEB::IntegrityMEB()
+    : MetadataExtensionBlock() {
+  m_blockType =
+      static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK);
+  m_metadataType = static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB);
+  setChecksums(std::vector<uint32_t>());
+}
+
+IntegrityMEB::IntegrityMEB(const std::string &rawData)
+    : MetadataExtensionBlock() {
+  try {
+    initFromRaw(std::make_shared<const std::string>(rawData), 0);
+    decodeMetadata();
+  } catch (...) {
+    throw BlockConstructionException("[IntegrityMEB] Bad raw format");
+  }
+}
+
+IntegrityMEB::IntegrityMEB(const std::shared_ptr<const std::string> &buffer,
+                           size_t offset)
+    : MetadataExtensionBlock() {
+  try {
+    initFromRaw(buffer, offset);
+    decodeMetadata();
+  } catch (...) {
+    throw BlockConstructionException("[IntegrityMEB] Bad raw format");
+  }
+}
+
+IntegrityMEB::~IntegrityMEB() {
+}
+
+void IntegrityMEB::decodeMetadata() {
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(m_metadata.data());
+  const uint8_t *end = data + m_metadata.size();
+  if (data == end || *data != CRC32C_ALGORITHM) {
+    throw std::out_of_range("Unknown algorithm");
+  }
+  ++data;
+  uint64_t count;
+  data += SDNV::decode(data, end, count);
+  if (count > static_cast<uint64_t>(end - data) / 4) {
+    throw std::out_of_range("Metadata too short");
+  }
+  m_checksums.resize(count);
+  for (auto &checksum : m_checksums) {
+    checksum = (static_cast<uint32_t>(data[0]) << 24)
+        | (static_cast<uint32_t>(data[1]) << 16)
+        | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    data += 4;
+  }
+}
+
+const std::vector<uint32_t>& IntegrityMEB::getChecksums() const {
+  return m_checksums;
+}
+
+void IntegrityMEB::setChecksums(const std::vector<uint32_t> &checksums) {
+  setDirty();
+  m_checksums = checksums;
+  m_metadata = std::string(1, static_cast<char>(CRC32C_ALGORITHM))
+      + SDNV::encode(checksums.size());
+  for (auto checksum : checksums) {
+    m_metadata.push_back(static_cast<char>(checksum >> 24));
+    m_metadata.push_back(static_cast<char>(checksum >> 16));
+    m_metadata.push_back(static_cast<char>(checksum >> 8));
+    m_metadata.push_back(static_cast<char>(checksum));
+  }
+}
+
+std::string IntegrityMEB::toString() {
+  std::stringstream ss;
+  ss << "Integrity block:" << std::endl << MetadataExtensionBlock::toString()
+     << "\tChecksums:";
+  for (auto checksum : m_checksums) {
+    ss << " " << std::hex << std::setw(8) << std::setfill('0') << checksum;
+  }
+  ss << std::endl;
+  return ss.str();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntegrityMEB.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the Integrity MEB.
+ */
+
+#ifndef BUNDLEAGENT_BUNDLE_INTEGRITYMEB_H_
+#define BUNDLEAGENT_BUNDLE_INTEGRITYMEB_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bundle/MetadataExtensionBlock.h"
+
+/**
+ * CLASS IntegrityMEB
+ * This block holds the CRC32C of every other block of the bundle.
+ *
+ * The metadata holds the algorithm, one byte, the SDNV number of checksums
+ * and the checksums, 4 bytes each in network order, in the order of the
+ * blocks. The block itself is skipped. The checksums are updated by the node
+ * that sends the bundle, so the blocks can be changed on each hop.
+ */
+class IntegrityMEB : public MetadataExtensionBlock {
+ public:
+  /**
+   * @brief Empty constructor.
+   *
+   * Generates a block without checksums.
+   */
+  IntegrityMEB();
+  /**
+   * @brief Raw constructor.
+   *
+   * @param rawData The raw data that contains the Integrity MEB.
+   */
+  explicit IntegrityMEB(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate an Integrity MEB from the raw bundle buffer, starting
+   * at the given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  IntegrityMEB(const std::shared_ptr<const std::string> &buffer,
+               size_t offset);
+  /**
+   * Destructor of the class.
+   */
+  virtual ~IntegrityMEB();
+  /**
+   * @brief Returns the checksums of the blocks.
+   *
+   * @return The CRC32C of each block.
+   */
+  const std::vector<uint32_t>& getChecksums() const;
+  /**
+   * @brief Sets the checksums of the blocks.
+   *
+   * @param checksums The CRC32C of each block.
+   */
+  void setChecksums(const std::vector<uint32_t> &checksums);
+  /**
+   * @brief Returns an string with a nice view of the block information.
+   *
+   * @return The string with the block information.
+   */
+  std::string toString();
+
+ private:
+  /**
+   * Parses the checksums from the metadata.
+   */
+  void decodeMetadata();
+  /**
+   * Checksums of the blocks.
+   */
+  std::vector<uint32_t> m_checksums;
+  /**
+   * Identifier of the CRC32C algorithm.
+   */
+  static const uint8_t CRC32C_ALGORITHM = 0x01;
+};
+
+#endif  // BUNDLEAGENT_BUNDLE_INTEGRITYMEB_H_
@@ -25,6 +25,7 @@
 #include "Bundle/MetadataExtensionBlock.h"
 
 #include <string>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 #include "Utils/SDNV.h"
@@ -48,11 +49,16 @@ MetadataExtensionBlock::MetadataExtensionBlock(const uint8_t metadataType,
 }
 
 MetadataExtensionBlock::MetadataExtensionBlock(const std::string &rawData)
+    : MetadataExtensionBlock(std::make_shared<const std::string>(rawData), 0) {
+}
+
+MetadataExtensionBlock::MetadataExtensionBlock(
+    const std::shared_ptr<const std::string> &buffer, size_t offset)
     : CanonicalBlock(),
       m_metadataType(0),
       m_metadata() {
   try {
-    initFromRaw(rawData);
+    initFromRaw(buffer, offset);
   } catch (const BlockConstructionException &e) {
     throw;
   }
@@ -79,8 +85,9 @@ std::string MetadataExtensionBlock::toRaw() {
   ss << SDNV::encode(SDNV::getLength(m_metadataType) + m_metadata.length());
   ss << SDNV::encode(m_metadataType);
   ss << m_metadata;
-  m_raw = ss.str();
-  return m_raw;
+  std::string raw = ss.str();
+  setRaw(raw);
+  return raw;
 }
 
 uint8_t MetadataExtensionBlock::getMetadataType() {
@@ -99,13 +106,20 @@ std::string MetadataExtensionBlock::toString() {
   return ss.str();
 }
 
-void MetadataExtensionBlock::initFromRaw(const std::string &rawData) {
-  CanonicalBlock::initFromRaw(rawData);
+void MetadataExtensionBlock::initFromRaw(
+    const std::shared_ptr<const std::string> &buffer, size_t offset) {
+  CanonicalBlock::initFromRaw(buffer, offset);
   try {
-    std::string data = m_raw.substr(m_bodyDataIndex);
-    size_t metadataTypeSize = SDNV::getLength(data);
-    m_metadataType = SDNV::decode(data);
-    m_metadata = data.substr(metadataTypeSize);
+    size_t position = m_rawOffset + m_bodyDataIndex;
+    size_t end = m_rawOffset + m_rawLength;
+    if (position > end) {
+      throw std::out_of_range("[MetadataExtensionBlock] Type out of block");
+    }
+    const uint8_t *raw = reinterpret_cast<const uint8_t*>(buffer->data());
+    uint64_t metadataType = 0;
+    position += SDNV::decode(raw + position, raw + end, metadataType);
+    m_metadataType = metadataType;
+    m_metadata = buffer->substr(position, end - position);
   } catch (const std::out_of_range& e) {
     throw BlockConstructionException("[MetadataExtensionBlock] Bad raw format");
   }
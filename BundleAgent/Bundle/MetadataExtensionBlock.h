@@ -25,6 +25,7 @@
 #define BUNDLEAGENT_BUNDLE_METADATAEXTENSIONBLOCK_H_
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "Bundle/CanonicalBlock.h"
@@ -52,6 +53,17 @@ class MetadataExtensionBlock : public CanonicalBlock {
    * @param rawData the raw data that contains the metadata block.
    */
   explicit MetadataExtensionBlock(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate the Metadata extension block that starts at the given
+   * offset of the buffer.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  MetadataExtensionBlock(const std::shared_ptr<const std::string> &buffer,
+                         size_t offset);
   /**
    * Destructor of the class.
    */
@@ -90,11 +102,13 @@ class MetadataExtensionBlock : public CanonicalBlock {
    * @brief Parses a Metadata Extension Block from raw.
    *
    * This function parses a metadata extension block from raw.
-   * Saving the raw data into the block.
+   * The block keeps a view of the buffer as its raw data.
    *
-   * @parm rawData Raw data to parse.
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
    */
-  void initFromRaw(const std::string &rawData);
+  void initFromRaw(const std::shared_ptr<const std::string> &buffer,
+                   size_t offset);
   /**
    * Type of the metadata block.
    */
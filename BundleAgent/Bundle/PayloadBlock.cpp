@@ -24,32 +24,66 @@
 
 #include "Bundle/PayloadBlock.h"
 
+#include <memory>
 #include <string>
 #include <sstream>
+#include <utility>
 #include "Bundle/BundleTypes.h"
 #include "Utils/SDNV.h"
 #include "Utils/Logger.h"
 
-PayloadBlock::PayloadBlock(const std::string &payload, bool isRaw)
-    : CanonicalBlock() {
+PayloadBlock::PayloadBlock(std::string payload, bool isRaw)
+    : CanonicalBlock(),
+      m_payloadInBuffer(false) {
   LOG(84) << "Generating new payload block";
   if (isRaw) {
     try {
-      initFromRaw(payload);
-      m_payload = m_raw.substr(m_bodyDataIndex);
+      initFromRaw(std::make_shared<const std::string>(std::move(payload)), 0);
+      m_payloadInBuffer = true;
     } catch (...) {
       throw BlockConstructionException("[PayloadBlock] Bad raw format");
     }
   } else {
-    m_payload = payload;
+    m_payload = std::make_shared<const std::string>(std::move(payload));
     m_blockType = static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK);
   }
 }
 
+PayloadBlock::PayloadBlock(const std::shared_ptr<const std::string> &buffer,
+                           size_t offset)
+    : CanonicalBlock(),
+      m_payloadInBuffer(false) {
+  LOG(84) << "Generating new payload block from buffer";
+  try {
+    initFromRaw(buffer, offset);
+    m_payloadInBuffer = true;
+  } catch (...) {
+    throw BlockConstructionException("[PayloadBlock] Bad raw format");
+  }
+}
+
+PayloadBlock::PayloadBlock(const std::shared_ptr<const MappedFile> &file,
+                           size_t offset)
+    : CanonicalBlock(),
+      m_payloadInBuffer(false) {
+  LOG(84) << "Generating new payload block from file";
+  try {
+    initFromFile(file, offset);
+    m_payloadInBuffer = true;
+  } catch (...) {
+    throw BlockConstructionException("[PayloadBlock] Bad raw format");
+  }
+}
+
 PayloadBlock::~PayloadBlock() {
 }
 
 std::string PayloadBlock::toRaw() {
+  updateRaw();
+  return getRaw();
+}
+
+void PayloadBlock::updateRaw() {
   /**
    * The payload block contains
    *
@@ -59,17 +93,52 @@ std::string PayloadBlock::toRaw() {
    * Payload variable length
    */
   LOG(84) << "Generating raw data from payload block";
-  std::stringstream ss;
-  ss << m_blockType;
-  ss << SDNV::encode(m_procFlags.to_ulong());
-  ss << SDNV::encode(m_payload.size());
-  ss << m_payload;
-  m_raw = ss.str();
-  return m_raw;
+  const char *payload =
+      m_payloadInBuffer ? getRawData() + m_bodyDataIndex : m_payload->data();
+  size_t payloadLength = getPayloadLength();
+  std::string header = encodeHeader(m_procFlags, payloadLength);
+  // The payload is only kept into the raw block.
+  std::string raw;
+  raw.reserve(header.size() + payloadLength);
+  raw.append(header);
+  raw.append(payload, payloadLength);
+  m_bodyDataIndex = header.size();
+  setRaw(std::move(raw));
+  m_payload.reset();
+  m_payloadInBuffer = true;
+}
+
+std::string PayloadBlock::getPayload() const {
+  RawSegment payload = getPayloadSegment();
+  return std::string(payload.data(), payload.length);
+}
+
+RawSegment PayloadBlock::getPayloadSegment() const {
+  if (!m_payloadInBuffer) {
+    return RawSegment { m_payload, 0, m_payload->size(), nullptr };
+  }
+  RawSegment segment = getRawSegment();
+  segment.offset += m_bodyDataIndex;
+  segment.length -= m_bodyDataIndex;
+  return segment;
+}
+
+size_t PayloadBlock::getPayloadLength() const {
+  if (m_payloadInBuffer) {
+    return m_rawLength - m_bodyDataIndex;
+  }
+  return m_payload->size();
 }
 
-std::string PayloadBlock::getPayload() {
-  return m_payload;
+std::string PayloadBlock::encodeHeader(const std::bitset<7> &procFlags,
+                                       uint64_t payloadLength) {
+  std::bitset<7> flags = procFlags;
+  flags.reset(static_cast<uint32_t>(CanonicalBlockControlFlags::EID_FIELD));
+  std::string header;
+  header.push_back(static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK));
+  header.append(SDNV::encode(flags.to_ulong()));
+  header.append(SDNV::encode(payloadLength));
+  return header;
 }
 
 std::string PayloadBlock::toString() {
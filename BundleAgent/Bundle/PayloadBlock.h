@@ -24,6 +24,8 @@
 #ifndef BUNDLEAGENT_BUNDLE_PAYLOADBLOCK_H_
 #define BUNDLEAGENT_BUNDLE_PAYLOADBLOCK_H_
 
+#include <bitset>
+#include <memory>
 #include <string>
 #include <cstdint>
 
@@ -38,13 +40,36 @@ class PayloadBlock : public CanonicalBlock {
   /**
    * @brief Constructor.
    *
-   * Generates a Payload block from its payload.
+   * Generates a Payload block from its payload, that is moved into the
+   * block.
    *
    * @param payload, string with payload value.
    * @param isRaw, default value false, set to true if creating the
    * payload from raw.
    */
-  explicit PayloadBlock(const std::string &payload, bool isRaw = false);
+  explicit PayloadBlock(std::string payload, bool isRaw = false);
+  /**
+   * @brief Buffer constructor.
+   *
+   * Generates a Payload block from the raw bundle buffer, the payload is not
+   * copied, it is read from the buffer when needed.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  PayloadBlock(const std::shared_ptr<const std::string> &buffer,
+               size_t offset);
+  /**
+   * @brief File constructor.
+   *
+   * Generates a Payload block from a raw bundle that lives in a mapped file,
+   * the payload is read from the file when needed, so it does not need to fit
+   * into memory.
+   *
+   * @param file The mapped file that holds the raw bundle.
+   * @param offset The position of the block into the file.
+   */
+  PayloadBlock(const std::shared_ptr<const MappedFile> &file, size_t offset);
   /**
    * Destructor of the class
    */
@@ -60,13 +85,45 @@ class PayloadBlock : public CanonicalBlock {
    * @return the block in raw format.
    */
   std::string toRaw();
+  /**
+   * @brief Function to update the block in raw format without returning it.
+   *
+   * Overrides Block::updateRaw(), the payload is not copied again.
+   */
+  void updateRaw();
 
   /**
    * Function to get the payload value.
    *
+   * The payload is copied, use getPayloadSegment() to access big payloads.
+   *
    * @return The payload value.
    */
-  std::string getPayload();
+  std::string getPayload() const;
+  /**
+   * @brief Function to get the payload without copying it.
+   *
+   * @return The segment of the buffer or file that holds the payload.
+   */
+  RawSegment getPayloadSegment() const;
+  /**
+   * @brief Function to get the length of the payload.
+   *
+   * @return The number of bytes of the payload.
+   */
+  size_t getPayloadLength() const;
+  /**
+   * @brief Generates the fields of a raw payload block that precede the
+   * payload.
+   *
+   * No EID references are written, so that flag is cleared.
+   *
+   * @param procFlags The processing control flags of the block.
+   * @param payloadLength The length of the payload.
+   * @return The block type, the flags and the block length in raw format.
+   */
+  static std::string encodeHeader(const std::bitset<7> &procFlags,
+                                  uint64_t payloadLength);
   /**
    * @brief Returns an string with a nice view of the block information.
    *
@@ -76,9 +133,13 @@ class PayloadBlock : public CanonicalBlock {
 
  private:
   /**
-   * Payload of the block.
+   * Payload of the block, until it is converted into the raw block.
+   */
+  std::shared_ptr<const std::string> m_payload;
+  /**
+   * True if the payload lives in the raw buffer instead of m_payload.
    */
-  std::string m_payload;
+  bool m_payloadInBuffer;
 };
 
 #endif  // BUNDLEAGENT_BUNDLE_PAYLOADBLOCK_H_
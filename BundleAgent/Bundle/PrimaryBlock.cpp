@@ -27,13 +27,20 @@
 #include <sstream>
 #include <cstring>
 #include <map>
+#include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include "Utils/SDNV.h"
 #include "Utils/Logger.h"
 
 PrimaryBlock::PrimaryBlock(const std::string &rawData)
-    : Block(rawData),
+    : PrimaryBlock(std::make_shared<const std::string>(rawData), 0) {
+}
+
+PrimaryBlock::PrimaryBlock(const std::shared_ptr<const std::string> &buffer,
+                           size_t offset)
+    : Block(buffer, offset, 0),
       m_procFlags(),
       m_destination(),
       m_source(),
@@ -41,7 +48,10 @@ PrimaryBlock::PrimaryBlock(const std::string &rawData)
       m_custodian(),
       m_creationTimestamp(0),
       m_creationTimestampSeqNumber(0),
-      m_lifetime(0) {
+      m_lifetime(0),
+      m_fragmentOffset(0),
+      m_totalADULength(0),
+      m_fragmentLength(0) {
   /**
    * Primary Block format
    *
@@ -66,90 +76,60 @@ PrimaryBlock::PrimaryBlock(const std::string &rawData)
    */
   LOG(82) << "Generating Primary block from raw data";
   try {
-    std::string data = rawData;
-    size_t length = 1;
+    const std::string &data = *buffer;
+    if (offset >= data.size()) {
+      throw std::out_of_range("[PrimaryBlock] Block out of the buffer");
+    }
+    const uint8_t *raw = reinterpret_cast<const uint8_t*>(data.data());
+    const uint8_t *dataEnd = raw + data.size();
     // Jump the version.
-    data = data.substr(1);
-    // Proc. flags
-    m_procFlags = std::bitset<21>(SDNV::decode(data));
-    size_t offset = SDNV::getLength(data);
-    length += offset;
-    data = data.substr(offset);
-    // Block Length
-    offset = SDNV::getLength(data);
-    length += offset + SDNV::decode(data);
-    data = data.substr(offset);
-    // Destination scheme offset
-    uint64_t destOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Destination SSP offset
-    uint64_t destSSPOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Source scheme offset
-    uint64_t srcOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Source SSP offset
-    uint64_t srcSSPOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // ReportTo scheme offset
-    uint64_t reportOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // ReportTo SSP offset
-    uint64_t reportSSPOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Custodian scheme offset
-    uint64_t custOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Custodian SSP offset
-    uint64_t custSSPOff = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Creation timestamp
-    m_creationTimestamp = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Timestamp sequence number
-    m_creationTimestampSeqNumber = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Lifetime
-    m_lifetime = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
-    // Dictionary length
-    uint64_t dictionaryLength = SDNV::decode(data);
-    offset = SDNV::getLength(data);
-    data = data.substr(offset);
+    size_t position = offset + 1;
+    // Proc. flags and Block Length
+    uint64_t header[2];
+    position += SDNV::decode(raw + position, dataEnd, header, 2);
+    m_procFlags = std::bitset<21>(header[0]);
+    uint64_t blockLength = header[1];
+    if (blockLength > data.size() - position) {
+      throw std::out_of_range("[PrimaryBlock] Block out of the buffer");
+    }
+    size_t length = position - offset + blockLength;
+    // The next 12 fields are consecutive SDNVs:
+    // Destination, Source, ReportTo and Custodian scheme and SSP offsets,
+    // creation timestamp, timestamp sequence number, lifetime and
+    // dictionary length.
+    uint64_t fields[12];
+    position += SDNV::decode(raw + position, raw + offset + length, fields, 12);
+    uint64_t destSSPOff = fields[1];
+    uint64_t srcSSPOff = fields[3];
+    uint64_t reportSSPOff = fields[5];
+    uint64_t custSSPOff = fields[7];
+    m_creationTimestamp = fields[8];
+    m_creationTimestampSeqNumber = fields[9];
+    m_lifetime = fields[10];
+    uint64_t dictionaryLength = fields[11];
+    if (dictionaryLength > offset + length - position) {
+      throw std::out_of_range("[PrimaryBlock] Dictionary out of the block");
+    }
     // Dictionary
-    std::string dictionary = data.substr(0, dictionaryLength);
-    const char* dataChar = data.c_str();
-    char buffScheme[1024];  // max size of scheme as in RFC 5050
-    char buffSSP[1024];  // max size of SSP as in RFC 5050
     // For the moment we ignore the scheme value.
-    // Destination
-    strcpy(&buffScheme[0], dataChar + destOff * sizeof(char));
-    strcpy(&buffSSP[0], dataChar + destSSPOff * sizeof(char));
-    m_destination = std::string(buffSSP);
-    // Source
-    strcpy(&buffScheme[0], dataChar + srcOff * sizeof(char));
-    strcpy(&buffSSP[0], dataChar + srcSSPOff * sizeof(char));
-    m_source = std::string(buffSSP);
-    // ReportTo
-    strcpy(&buffScheme[0], dataChar + reportOff * sizeof(char));
-    strcpy(&buffSSP[0], dataChar + reportSSPOff * sizeof(char));
-    m_reportTo = std::string(buffSSP);
-    // Custodian
-    strcpy(&buffScheme[0], dataChar + custOff * sizeof(char));
-    strcpy(&buffSSP[0], dataChar + custSSPOff * sizeof(char));
-    m_custodian = std::string(buffSSP);
-    m_raw = rawData.substr(0, length);
+    const char* dictionary = data.data() + position;
+    m_destination = readDictionaryEntry(dictionary, dictionaryLength,
+                                        destSSPOff);
+    m_source = readDictionaryEntry(dictionary, dictionaryLength, srcSSPOff);
+    m_reportTo = readDictionaryEntry(dictionary, dictionaryLength,
+                                     reportSSPOff);
+    m_custodian = readDictionaryEntry(dictionary, dictionaryLength,
+                                      custSSPOff);
+    position += dictionaryLength;
+    if (m_procFlags.test(
+        static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT))) {
+      position += SDNV::decode(raw + position, raw + offset + length,
+                               fields, 2);
+      m_fragmentOffset = fields[0];
+      m_totalADULength = fields[1];
+    }
+    updateKey();
+    setRaw(buffer, offset, length);
   } catch (const std::exception& e) {
     throw BlockConstructionException("[PrimaryBlock] Bad raw format");
   }
@@ -166,7 +146,11 @@ PrimaryBlock::PrimaryBlock(const std::string &source,
       m_custodian(),
       m_creationTimestamp(timestamp),
       m_creationTimestampSeqNumber(seqNumber),
-      m_lifetime(3600) {
+      m_lifetime(3600),
+      m_fragmentOffset(0),
+      m_totalADULength(0),
+      m_fragmentLength(0),
+      m_key(source, timestamp, seqNumber) {
   LOG(82) << "Generating primary block from parameters - [Source: " << source
           << "][Destination: " << destination << "][Timestamp: " << timestamp
           << "][Timestamp SeqNumber: " << seqNumber << "]";
@@ -176,11 +160,15 @@ PrimaryBlock::~PrimaryBlock() {
 }
 
 void PrimaryBlock::setPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
+  setDirty();
   LOG(82) << "Setting flag " << static_cast<uint32_t>(procFlag);
   if (procFlag != PrimaryBlockControlFlags::PRIORITY_BULK
       && procFlag != PrimaryBlockControlFlags::PRIORITY_NORMAL
       && procFlag != PrimaryBlockControlFlags::PRIORITY_EXPEDITED) {
     m_procFlags.set(static_cast<uint32_t>(procFlag));
+    if (procFlag == PrimaryBlockControlFlags::IS_FRAGMENT) {
+      updateKey();
+    }
   } else {
     // Priority is represented with values into bytes 7 and 8,
     // BULK = 00, NORMAL = 01, EXPEDITED = 10
@@ -204,11 +192,18 @@ void PrimaryBlock::setPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
 }
 
 void PrimaryBlock::unsetPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
+  setDirty();
   LOG(82) << "Clearing flag " << static_cast<uint32_t>(procFlag);
   if (procFlag != PrimaryBlockControlFlags::PRIORITY_BULK
       && procFlag != PrimaryBlockControlFlags::PRIORITY_NORMAL
       && procFlag != PrimaryBlockControlFlags::PRIORITY_EXPEDITED) {
     m_procFlags.reset(static_cast<uint32_t>(procFlag));
+    if (procFlag == PrimaryBlockControlFlags::IS_FRAGMENT) {
+      m_fragmentOffset = 0;
+      m_totalADULength = 0;
+      m_fragmentLength = 0;
+      updateKey();
+    }
   } else {
     // Priority is represented with values into bytes 7 and 8,
     // BULK = 00, NORMAL = 01, EXPEDITED = 10
@@ -217,7 +212,8 @@ void PrimaryBlock::unsetPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
   }
 }
 
-bool PrimaryBlock::checkPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
+bool PrimaryBlock::checkPrimaryProcFlag(
+    PrimaryBlockControlFlags procFlag) const {
   LOG(82) << "Testing flag " << static_cast<uint32_t>(procFlag);
   bool flagActive = false;
   if (procFlag != PrimaryBlockControlFlags::PRIORITY_BULK
@@ -244,6 +240,16 @@ bool PrimaryBlock::checkPrimaryProcFlag(PrimaryBlockControlFlags procFlag) {
   return flagActive;
 }
 
+std::bitset<21> PrimaryBlock::getProcFlags() const {
+  return m_procFlags;
+}
+
+void PrimaryBlock::setProcFlags(const std::bitset<21> &procFlags) {
+  setDirty();
+  m_procFlags = procFlags;
+  updateKey();
+}
+
 std::string PrimaryBlock::toRaw() {
   /**
    * Primary Block format
@@ -332,12 +338,19 @@ std::string PrimaryBlock::toRaw() {
   ss1 << SDNV::encode(dictionary.str().size());
   // Dictionary
   ss1 << dictionary.str();
+  // Fragment fields
+  if (m_procFlags.test(
+      static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT))) {
+    ss1 << SDNV::encode(m_fragmentOffset);
+    ss1 << SDNV::encode(m_totalADULength);
+  }
   // Add block length
   ss << SDNV::encode(ss1.str().size());
   // Append all the block
   ss << ss1.str();
-  Block::m_raw = ss.str();
-  return Block::m_raw;
+  std::string raw = ss.str();
+  setRaw(raw);
+  return raw;
 }
 
 const std::string PrimaryBlock::getDestination() const {
@@ -368,28 +381,84 @@ const uint64_t PrimaryBlock::getCreationTimestampSeqNumber() const {
   return m_creationTimestampSeqNumber;
 }
 
+const BundleKey& PrimaryBlock::getKey() const {
+  return m_key;
+}
+
 void PrimaryBlock::setReportTo(const std::string &reportTo) {
+  setDirty();
   LOG(82) << "Setting new reportTo [" << reportTo << "]";
   m_reportTo = reportTo;
 }
 
 void PrimaryBlock::setCustodian(const std::string &custodian) {
+  setDirty();
   LOG(82) << "Setting new custodian [" << custodian << "]";
   m_custodian = custodian;
 }
 
 void PrimaryBlock::setLifetime(const uint64_t &lifetime) {
+  setDirty();
   LOG(82) << "Setting new lifetime [" << lifetime << "]";
   m_lifetime = lifetime;
 }
 
 void PrimaryBlock::setTimestamp(std::pair<uint64_t, uint64_t> timestamp) {
+  setDirty();
   m_creationTimestamp = timestamp.first;
   m_creationTimestampSeqNumber = timestamp.second;
+  updateKey();
 }
 
 void PrimaryBlock::setSource(const std::string &source) {
+  setDirty();
   m_source = source;
+  updateKey();
+}
+
+const uint64_t PrimaryBlock::getFragmentOffset() const {
+  return m_fragmentOffset;
+}
+
+const uint64_t PrimaryBlock::getTotalApplicationDataLength() const {
+  return m_totalADULength;
+}
+
+void PrimaryBlock::setFragment(uint64_t offset, uint64_t totalLength) {
+  setDirty();
+  LOG(82) << "Setting fragment [Offset: " << offset << "][Total length: "
+          << totalLength << "]";
+  m_procFlags.set(static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT));
+  m_fragmentOffset = offset;
+  m_totalADULength = totalLength;
+  updateKey();
+}
+
+void PrimaryBlock::setFragmentLength(uint64_t length) {
+  m_fragmentLength = length;
+  updateKey();
+}
+
+void PrimaryBlock::updateKey() {
+  if (m_procFlags.test(
+      static_cast<uint32_t>(PrimaryBlockControlFlags::IS_FRAGMENT))) {
+    m_key = BundleKey(m_source, m_creationTimestamp,
+                      m_creationTimestampSeqNumber, m_fragmentOffset,
+                      m_fragmentLength);
+  } else {
+    m_key = BundleKey(m_source, m_creationTimestamp,
+                      m_creationTimestampSeqNumber);
+  }
+}
+
+std::string PrimaryBlock::readDictionaryEntry(const char* dictionary,
+                                              uint64_t dictionaryLength,
+                                              uint64_t offset) {
+  if (offset >= dictionaryLength) {
+    throw std::out_of_range("[PrimaryBlock] Offset out of the dictionary");
+  }
+  const char* entry = dictionary + offset;
+  return std::string(entry, strnlen(entry, dictionaryLength - offset));
 }
 
 std::string PrimaryBlock::toString() {
@@ -440,5 +509,10 @@ std::string PrimaryBlock::toString() {
      << std::endl << "\tCreation timestamp sequence number: "
      << getCreationTimestampSeqNumber() << std::endl << "\tLifetime: "
      << getLifetime() << std::endl;
+  if (checkPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT)) {
+    ss << "\tFragment offset: " << getFragmentOffset() << std::endl
+       << "\tTotal application data unit length: "
+       << getTotalApplicationDataLength() << std::endl;
+  }
   return ss.str();
 }
@@ -25,11 +25,13 @@
 #define BUNDLEAGENT_BUNDLE_PRIMARYBLOCK_H_
 
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <bitset>
 #include <utility>
 #include "Bundle/BundleTypes.h"
 #include "Bundle/Block.h"
+#include "Bundle/BundleKey.h"
 
 /**
  * CLASS PrimaryBlock
@@ -45,6 +47,17 @@ class PrimaryBlock : public Block {
    * @param rawData of the primary block.
    */
   explicit PrimaryBlock(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This constructor will reconstruct the primary block that starts at the
+   * given offset of the buffer, without copying it.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the primary block into the buffer.
+   */
+  PrimaryBlock(const std::shared_ptr<const std::string> &buffer,
+               size_t offset);
   /**
    * @brief Constructs a primary block with the provided information.
    *
@@ -93,7 +106,21 @@ class PrimaryBlock : public Block {
    *
    * @sa PrimaryBlockControlFlags
    */
-  bool checkPrimaryProcFlag(PrimaryBlockControlFlags procFlag);
+  bool checkPrimaryProcFlag(PrimaryBlockControlFlags procFlag) const;
+  /**
+   * @brief Returns all the processing control flags.
+   *
+   * @return The flags, as they are encoded into the block.
+   */
+  std::bitset<21> getProcFlags() const;
+  /**
+   * @brief Replaces all the processing control flags.
+   *
+   * The fragment fields are not changed.
+   *
+   * @param procFlags The flags, as they are encoded into the block.
+   */
+  void setProcFlags(const std::bitset<21> &procFlags);
   /**
    * @brief Function to update the block in raw format.
    *
@@ -137,6 +164,12 @@ class PrimaryBlock : public Block {
    * @return the timestamp sequence number field.
    */
   const uint64_t getCreationTimestampSeqNumber() const;
+  /**
+   * Function to get the key that identifies the bundle, generated from the
+   * source, the creation timestamp and the sequence number.
+   * @return the bundle key.
+   */
+  const BundleKey& getKey() const;
   /**
    * Function to set a new reportTo into the primary block.
    * @param reportTo new reportTo to set.
@@ -164,6 +197,34 @@ class PrimaryBlock : public Block {
    * @param source The new source.
    */
   void setSource(const std::string &source);
+  /**
+   * Function to get the offset of the fragment payload into the payload of
+   * the original bundle.
+   *
+   * @return The fragment offset, 0 if the bundle is not a fragment.
+   */
+  const uint64_t getFragmentOffset() const;
+  /**
+   * Function to get the payload length of the original bundle.
+   *
+   * @return The total application data unit length, 0 if the bundle is not a
+   *         fragment.
+   */
+  const uint64_t getTotalApplicationDataLength() const;
+  /**
+   * Marks the bundle as a fragment of an original bundle.
+   *
+   * @param offset The offset of the fragment payload into the original one.
+   * @param totalLength The payload length of the original bundle.
+   */
+  void setFragment(uint64_t offset, uint64_t totalLength);
+  /**
+   * Sets the payload length of the fragment, it is not a field of the primary
+   * block but it identifies the fragment, so it is part of the key.
+   *
+   * @param length The payload length of the fragment.
+   */
+  void setFragmentLength(uint64_t length);
   /**
    * @brief Returns an string with a nice view of the block information.
    *
@@ -172,6 +233,21 @@ class PrimaryBlock : public Block {
   std::string toString();
 
  private:
+  /**
+   * @brief Reads an endpoint from the dictionary.
+   *
+   * @param dictionary Pointer to the start of the dictionary.
+   * @param dictionaryLength Length of the dictionary.
+   * @param offset Offset of the endpoint into the dictionary.
+   * @return The endpoint.
+   */
+  static std::string readDictionaryEntry(const char* dictionary,
+                                         uint64_t dictionaryLength,
+                                         uint64_t offset);
+  /**
+   * @brief Generates the key from the current fields.
+   */
+  void updateKey();
   /**
    * Bundle Processing control flags.
    */
@@ -204,6 +280,24 @@ class PrimaryBlock : public Block {
    * Bundle lifetime.
    */
   uint64_t m_lifetime;
+  /**
+   * Fragment offset, only valid if the IS_FRAGMENT flag is set.
+   */
+  uint64_t m_fragmentOffset;
+  /**
+   * Total application data unit length, only valid if the IS_FRAGMENT flag is
+   * set.
+   */
+  uint64_t m_totalADULength;
+  /**
+   * Payload length of the fragment, only valid if the IS_FRAGMENT flag is
+   * set.
+   */
+  uint64_t m_fragmentLength;
+  /**
+   * Bundle key, kept in sync with the source and the creation timestamp.
+   */
+  BundleKey m_key;
 
   const std::string m_nullEndpoint = "none";
 };
@@ -25,28 +25,53 @@
 #include <ctime>
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "RouteReportingMEB.h"
 #include "Bundle/MetadataExtensionBlock.h"
 #include "Bundle/BundleTypes.h"
+#include "Utils/SDNV.h"
+
+namespace {
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1)
+      ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+}  // namespace
+
+const uint8_t RouteReportingMEB::BINARY_FORMAT_MARKER;
+const uint8_t RouteReportingMEB::BINARY_FORMAT_VERSION;
 
 RouteReportingMEB::RouteReportingMEB(std::string nodeId,
                                      std::time_t arrivalTime,
                                      std::time_t departureTime)
-    : MetadataExtensionBlock(
-        static_cast<uint8_t>(MetadataTypes::ROUTE_REPORTING_MEB),
-        nodeId + "," + std::to_string(arrivalTime) + ","
-            + std::to_string(departureTime)),
-            m_routeReporting(m_metadata) {
+    : RouteReportingMEB() {
+  addRouteInformation(nodeId, arrivalTime, departureTime);
 }
 
 RouteReportingMEB::RouteReportingMEB(const std::string &rawData)
-    : MetadataExtensionBlock(rawData),
-      m_routeReporting(m_metadata) {
+    : RouteReportingMEB(std::make_shared<const std::string>(rawData), 0) {
+}
+
+RouteReportingMEB::RouteReportingMEB(
+    const std::shared_ptr<const std::string> &buffer, size_t offset)
+    : MetadataExtensionBlock(buffer, offset),
+      m_maxHops(0),
+      m_droppedHops(0),
+      m_textFormat(false) {
+  decodeRoute();
 }
 
 RouteReportingMEB::RouteReportingMEB()
     : MetadataExtensionBlock(),
-      m_routeReporting(m_metadata) {
+      m_maxHops(0),
+      m_droppedHops(0),
+      m_textFormat(false) {
   m_metadataType = static_cast<uint8_t>(MetadataTypes::ROUTE_REPORTING_MEB);
 }
 
@@ -54,25 +79,186 @@ RouteReportingMEB::~RouteReportingMEB() {
 }
 
 std::string RouteReportingMEB::getRouteReporting() {
-  return m_metadata;
+  std::stringstream ss;
+  for (size_t i = 0; i < m_hops.size(); ++i) {
+    if (i > 0) {
+      ss << "\n";
+    }
+    ss << m_nodes[m_hops[i].node] << "," << m_hops[i].arrivalTime << ","
+       << m_hops[i].departureTime;
+  }
+  return ss.str();
+}
+
+size_t RouteReportingMEB::getNumberOfHops() {
+  return m_hops.size();
+}
+
+uint64_t RouteReportingMEB::getDroppedHops() {
+  return m_droppedHops;
+}
+
+void RouteReportingMEB::setMaxHops(uint64_t maxHops) {
+  setDirty();
+  m_maxHops = maxHops;
+  if (m_maxHops > 0 && m_hops.size() > m_maxHops) {
+    size_t first = m_maxHops > 1 ? 1 : 0;
+    size_t toDrop = m_hops.size() - m_maxHops;
+    m_hops.erase(m_hops.begin() + first, m_hops.begin() + first + toDrop);
+    m_droppedHops += toDrop;
+  }
+  if (!m_hops.empty()) {
+    encodeRoute();
+  }
 }
 
 void RouteReportingMEB::addRouteInformation(std::string nodeId,
                                             std::time_t arrivalTime,
                                             std::time_t departureTime) {
-  std::string routeInformation = nodeId + "," + std::to_string(arrivalTime)
-      + "," + std::to_string(departureTime);
-  if (m_metadata == "") {
-    m_metadata = routeInformation;
+  setDirty();
+  auto it = m_nodeIds.find(nodeId);
+  if (it == m_nodeIds.end()) {
+    it = m_nodeIds.emplace(nodeId, m_nodes.size()).first;
+    m_nodes.push_back(nodeId);
+  }
+  Hop hop { it->second, arrivalTime, departureTime };
+  if (m_maxHops > 0 && m_hops.size() >= m_maxHops) {
+    // Keep the first hop and the most recent ones.
+    size_t first = m_maxHops > 1 ? 1 : 0;
+    m_hops.erase(m_hops.begin() + first);
+    ++m_droppedHops;
+    m_hops.push_back(hop);
+    encodeRoute();
+  } else if (m_textFormat || m_hops.empty()) {
+    m_hops.push_back(hop);
+    encodeRoute();
+  } else {
+    std::time_t previousDeparture = m_hops.back().departureTime;
+    m_hops.push_back(hop);
+    appendHop(hop, m_writtenNodes, previousDeparture);
+  }
+}
+
+void RouteReportingMEB::decodeRoute() {
+  if (m_metadata.empty()) {
+    return;
+  }
+  try {
+    if (static_cast<uint8_t>(m_metadata[0]) != BINARY_FORMAT_MARKER) {
+      // Text format, one "nodeId,arrival,departure" line for each hop.
+      m_textFormat = true;
+      std::stringstream ss(m_metadata);
+      std::string line;
+      while (std::getline(ss, line)) {
+        size_t second = line.rfind(',');
+        size_t first =
+            (second == std::string::npos || second == 0) ?
+                std::string::npos : line.rfind(',', second - 1);
+        if (first == std::string::npos) {
+          throw BlockConstructionException(
+              "[RouteReportingMEB] Bad route format");
+        }
+        std::string nodeId = line.substr(0, first);
+        auto it = m_nodeIds.find(nodeId);
+        if (it == m_nodeIds.end()) {
+          it = m_nodeIds.emplace(nodeId, m_nodes.size()).first;
+          m_nodes.push_back(nodeId);
+        }
+        m_hops.push_back(
+            Hop { it->second, static_cast<std::time_t>(std::stoll(
+                line.substr(first + 1, second - first - 1))),
+                static_cast<std::time_t>(std::stoll(line.substr(second + 1)))
+            });
+      }
+      return;
+    }
+    const uint8_t *data = reinterpret_cast<const uint8_t*>(m_metadata.data());
+    const uint8_t *end = data + m_metadata.size();
+    if (m_metadata.size() < 2 || data[1] != BINARY_FORMAT_VERSION) {
+      throw BlockConstructionException(
+          "[RouteReportingMEB] Unknown route format version");
+    }
+    data += 2;
+    data += SDNV::decode(data, end, m_maxHops);
+    data += SDNV::decode(data, end, m_droppedHops);
+    std::time_t previousDeparture = 0;
+    while (data < end) {
+      uint64_t reference;
+      data += SDNV::decode(data, end, reference);
+      size_t node;
+      if (reference == 0) {
+        uint64_t length;
+        data += SDNV::decode(data, end, length);
+        if (length > static_cast<uint64_t>(end - data)) {
+          throw BlockConstructionException(
+              "[RouteReportingMEB] Bad route format");
+        }
+        node = m_nodes.size();
+        m_nodes.push_back(std::string(reinterpret_cast<const char*>(data),
+                                      length));
+        m_nodeIds.emplace(m_nodes.back(), node);
+        data += length;
+      } else if (reference <= m_nodes.size()) {
+        node = reference - 1;
+      } else {
+        throw BlockConstructionException(
+            "[RouteReportingMEB] Bad route format");
+      }
+      uint64_t arrivalDelta;
+      uint64_t stay;
+      data += SDNV::decode(data, end, arrivalDelta);
+      data += SDNV::decode(data, end, stay);
+      Hop hop;
+      hop.node = node;
+      hop.arrivalTime = previousDeparture + unzigzag(arrivalDelta);
+      hop.departureTime = hop.arrivalTime + unzigzag(stay);
+      previousDeparture = hop.departureTime;
+      m_hops.push_back(hop);
+    }
+    m_writtenNodes.assign(m_nodes.size(), true);
+  } catch (const std::logic_error &e) {
+    throw BlockConstructionException("[RouteReportingMEB] Bad route format");
+  }
+}
+
+void RouteReportingMEB::appendHop(const Hop &hop, std::vector<bool> &written,
+                                  std::time_t previousDeparture) {
+  if (written.size() < m_nodes.size()) {
+    written.resize(m_nodes.size(), false);
+  }
+  if (written[hop.node]) {
+    m_metadata += SDNV::encode(hop.node + 1);
   } else {
-    m_metadata = m_metadata + "\n" + routeInformation;
+    const std::string &nodeId = m_nodes[hop.node];
+    m_metadata += SDNV::encode(0);
+    m_metadata += SDNV::encode(nodeId.size());
+    m_metadata += nodeId;
+    written[hop.node] = true;
   }
+  m_metadata += SDNV::encode(zigzag(hop.arrivalTime - previousDeparture));
+  m_metadata += SDNV::encode(zigzag(hop.departureTime - hop.arrivalTime));
+}
+
+void RouteReportingMEB::encodeRoute() {
+  m_metadata.clear();
+  m_metadata.push_back(static_cast<char>(BINARY_FORMAT_MARKER));
+  m_metadata.push_back(static_cast<char>(BINARY_FORMAT_VERSION));
+  m_metadata += SDNV::encode(m_maxHops);
+  m_metadata += SDNV::encode(m_droppedHops);
+  m_writtenNodes.assign(m_nodes.size(), false);
+  std::time_t previousDeparture = 0;
+  for (const Hop &hop : m_hops) {
+    appendHop(hop, m_writtenNodes, previousDeparture);
+    previousDeparture = hop.departureTime;
+  }
+  m_textFormat = false;
 }
 
 std::string RouteReportingMEB::toString() {
   std::stringstream ss;
   ss << "Route Reporting block: " << std::endl
-     << MetadataExtensionBlock::toString() << "\tRoute is: " << m_metadata;
+     << MetadataExtensionBlock::toString() << "\tRoute is: "
+     << getRouteReporting() << std::endl << "\tDropped hops: "
+     << m_droppedHops;
   return ss.str();
 }
-
@@ -25,9 +25,12 @@
 #ifndef BUNDLEAGENT_BUNDLE_ROUTEREPORTINGMEB_H_
 #define BUNDLEAGENT_BUNDLE_ROUTEREPORTINGMEB_H_
 
+#include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <ctime>
+#include <cstdint>
 #include "MetadataExtensionBlock.h"
 
 class RouteReportingMEB : public MetadataExtensionBlock {
@@ -50,6 +53,16 @@ class RouteReportingMEB : public MetadataExtensionBlock {
    * This will generate a Route Reporting MEB from raw data.
    */
   explicit RouteReportingMEB(const std::string& rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate a Route Reporting MEB from the raw bundle buffer, starting at the
+   * given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  RouteReportingMEB(const std::shared_ptr<const std::string> &buffer, size_t offset);
   /**
    * @brief Empty constructor
    *
@@ -63,9 +76,33 @@ class RouteReportingMEB : public MetadataExtensionBlock {
   /**
    * Function to get the sequence of nodes the bundle has been transmitted.
    *
+   * The route is returned as text, one "nodeId,arrival,departure" line for
+   * each hop.
+   *
    * @return Route which the bundle has followed.
    */
   std::string getRouteReporting();
+  /**
+   * Function to get the number of hops kept in the block.
+   *
+   * @return The number of hops.
+   */
+  size_t getNumberOfHops();
+  /**
+   * Function to get the number of hops removed by the hop limit.
+   *
+   * @return The number of removed hops.
+   */
+  uint64_t getDroppedHops();
+  /**
+   * @brief Sets the maximum number of hops kept in the block.
+   *
+   * When the limit is reached the first hop and the most recent ones are
+   * kept. The limit travels with the block.
+   *
+   * @param maxHops The maximum number of hops, 0 for no limit.
+   */
+  void setMaxHops(uint64_t maxHops);
 
   /**
    * Function to add new route information of a node.
@@ -81,9 +118,78 @@ class RouteReportingMEB : public MetadataExtensionBlock {
 
  private:
   /**
-   * Route which the bundle has followed.
+   * Information of one hop.
+   */
+  struct Hop {
+    /**
+     * Position of the node id in the nodes table.
+     */
+    size_t node;
+    std::time_t arrivalTime;
+    std::time_t departureTime;
+  };
+  /**
+   * @brief Parses the route from the metadata.
+   *
+   * The metadata can be in the binary format or in the text format of the
+   * first version.
+   */
+  void decodeRoute();
+  /**
+   * @brief Appends the binary form of a hop to the metadata.
+   *
+   * In the binary format each hop is stored as the SDNV position of the node
+   * plus one, or zero followed by the SDNV length and the node id the first
+   * time it appears, followed by the zigzag SDNV difference between the
+   * arrival time and the previous departure time and the zigzag SDNV time
+   * spent in the node. This allows to add a hop without rewriting the block.
+   *
+   * @param hop The hop to encode.
+   * @param written The nodes already written in the metadata.
+   * @param previousDeparture The departure time of the previous hop.
+   */
+  void appendHop(const Hop &hop, std::vector<bool> &written,
+                 std::time_t previousDeparture);
+  /**
+   * Generates the metadata of the whole route in the binary format.
+   */
+  void encodeRoute();
+  /**
+   * Node ids that appear in the route.
+   */
+  std::vector<std::string> m_nodes;
+  /**
+   * Position of each node id in m_nodes.
+   */
+  std::unordered_map<std::string, size_t> m_nodeIds;
+  /**
+   * Hops kept in the block.
+   */
+  std::vector<Hop> m_hops;
+  /**
+   * Nodes already written in the metadata.
+   */
+  std::vector<bool> m_writtenNodes;
+  /**
+   * Maximum number of hops, 0 for no limit.
+   */
+  uint64_t m_maxHops;
+  /**
+   * Number of hops removed because of the limit.
+   */
+  uint64_t m_droppedHops;
+  /**
+   * True if the metadata is not in the binary format.
+   */
+  bool m_textFormat;
+  /**
+   * First byte of the binary format, the text format starts with a node id.
+   */
+  static const uint8_t BINARY_FORMAT_MARKER = 0x00;
+  /**
+   * Version of the binary format.
    */
-  std::string m_routeReporting;
+  static const uint8_t BINARY_FORMAT_VERSION = 0x01;
 };
 
 #endif  // BUNDLEAGENT_BUNDLE_ROUTEREPORTINGMEB_H_
@@ -25,6 +25,7 @@
 #include "RoutingSelectionMEB.h"
 #include <sstream>
 #include <string>
+#include <memory>
 #include <exception>
 #include "Utils/Logger.h"
 #include "Bundle/BundleTypes.h"
@@ -37,7 +38,12 @@ RoutingSelectionMEB::RoutingSelectionMEB(const uint8_t selection)
 }
 
 RoutingSelectionMEB::RoutingSelectionMEB(const std::string& rawData)
-    : MetadataExtensionBlock(rawData) {
+    : RoutingSelectionMEB(std::make_shared<const std::string>(rawData), 0) {
+}
+
+RoutingSelectionMEB::RoutingSelectionMEB(
+    const std::shared_ptr<const std::string> &buffer, size_t offset)
+    : MetadataExtensionBlock(buffer, offset) {
   try {
     m_selection = static_cast<uint8_t>(std::stoi(m_metadata));
   } catch (const std::invalid_argument& e) {
@@ -26,6 +26,7 @@
 #ifndef BUNDLEAGENT_BUNDLE_ROUTINGSELECTIONMEB_H_
 #define BUNDLEAGENT_BUNDLE_ROUTINGSELECTIONMEB_H_
 
+#include <memory>
 #include <string>
 #include <cstdint>
 
@@ -46,6 +47,16 @@ class RoutingSelectionMEB : public MetadataExtensionBlock {
    *
    */
   explicit RoutingSelectionMEB(const std::string &rawData);
+  /**
+   * @brief Buffer constructor.
+   *
+   * This will generate a Routing selection MEB from the raw bundle buffer, starting at the
+   * given offset.
+   *
+   * @param buffer The buffer that holds the raw bundle.
+   * @param offset The position of the block into the buffer.
+   */
+  RoutingSelectionMEB(const std::shared_ptr<const std::string> &buffer, size_t offset);
   /**
    * Destructor of the class.
    */
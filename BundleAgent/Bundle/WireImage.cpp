@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE WireImage.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the WireImage class.
+ */
+
+#include "Bundle/WireImage.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+WireImage::WireImage(std::vector<RawSegment> segments)
+    : m_segments(std::move(segments)),
+      m_length(0) {
+  for (auto &segment : m_segments) {
+    m_length += segment.length;
+  }
+}
+
+WireImage::~WireImage() {
+}
+
+const std::vector<RawSegment>& WireImage::getSegments() const {
+  return m_segments;
+}
+
+size_t WireImage::getLength() const {
+  return m_length;
+}
+
+std::string WireImage::toString() const {
+  std::string raw;
+  raw.reserve(m_length);
+  for (auto &segment : m_segments) {
+    raw.append(segment.data(), segment.length);
+  }
+  return raw;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE WireImage.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the class WireImage.
+ */
+#ifndef BUNDLEAGENT_BUNDLE_WIREIMAGE_H_
+#define BUNDLEAGENT_BUNDLE_WIREIMAGE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Bundle/Block.h"
+
+/**
+ * CLASS WireImage
+ * This class holds a bundle encoded to be sent, as the list of segments of
+ * the buffers that hold its blocks.
+ *
+ * The image can not be changed once created, and the segments keep the
+ * buffers alive, so one image can be shared between all the neighbours and
+ * endpoints that receive the bundle, even if the bundle changes or is
+ * destroyed meanwhile.
+ */
+class WireImage {
+ public:
+  /**
+   * @brief Generates an image from the segments of a bundle.
+   *
+   * @param segments The segments that form the raw bundle, in order.
+   */
+  explicit WireImage(std::vector<RawSegment> segments);
+  /**
+   * Destructor of the class.
+   */
+  virtual ~WireImage();
+  /**
+   * @brief Returns the segments that form the raw bundle.
+   *
+   * @return The segments, in order.
+   */
+  const std::vector<RawSegment>& getSegments() const;
+  /**
+   * @brief Returns the length of the raw bundle.
+   *
+   * @return The length in bytes.
+   */
+  size_t getLength() const;
+  /**
+   * @brief Copies the raw bundle into a string.
+   *
+   * Only intended for small bundles, the segments should be sent instead.
+   *
+   * @return The raw bundle.
+   */
+  std::string toString() const;
+
+ private:
+  /**
+   * The segments that form the raw bundle.
+   */
+  std::vector<RawSegment> m_segments;
+  /**
+   * The length of the raw bundle.
+   */
+  size_t m_length;
+};
+
+#endif  // BUNDLEAGENT_BUNDLE_WIREIMAGE_H_
@@ -167,17 +167,17 @@ bool BasicBundleProcessor::processBundle(
         auto it = std::find(
             neighbours.begin(),
             neighbours.end(),
-            bundleContainer->getBundle().getPrimaryBlock()->getDestination()
+            bundleContainer->getInfo()->getDestination()
                 .substr(
                 0,
-                bundleContainer->getBundle().getPrimaryBlock()->getDestination()
+                bundleContainer->getInfo()->getDestination()
                     .find(":")));
         if (it != neighbours.end()) {
           LOG(55) << "Destination found, sending the bundle to it.";
           std::vector<std::string> nextHop = std::vector<std::string>();
           nextHop.push_back(*it);
           try {
-            forward(bundleContainer->getBundle(), nextHop);
+            forward(*bundleContainer, nextHop);
             LOG(55) << "Discarding the bundle.";
             discard(std::move(bundleContainer));
           } catch (const ForwardException &e) {
@@ -189,7 +189,7 @@ bool BasicBundleProcessor::processBundle(
           LOG(55) << "Destination not found, "
                   << "sending the bundle to all the neighbours.";
           try {
-            forward(bundleContainer->getBundle(), neighbours);
+            forward(*bundleContainer, neighbours);
             LOG(55) << "Discarding the bundle.";
             discard(std::move(bundleContainer));
           } catch (const ForwardException &e) {
@@ -216,7 +216,7 @@ std::unique_ptr<BundleContainer> BasicBundleProcessor::createBundleContainer(
 
 bool BasicBundleProcessor::checkDestination(BundleContainer &bundleContainer) {
   try {
-    BundleInfo bi = BundleInfo(bundleContainer.getBundle());
+    BundleInfo bi = *bundleContainer.getInfo();
     m_destinationWorker.execute(m_nodeState, bi);
     return m_destinationWorker.getResult();
   } catch (const WorkerException &e) {
@@ -227,8 +227,7 @@ bool BasicBundleProcessor::checkDestination(BundleContainer &bundleContainer) {
 
 std::vector<std::string> BasicBundleProcessor::checkDispatch(
     BundleContainer &bundleContainer) {
-  std::string destination = bundleContainer.getBundle().getPrimaryBlock()
-      ->getDestination();
+  std::string destination = bundleContainer.getInfo()->getDestination();
   std::string appId = destination.substr(destination.find(":") + 1);
   std::vector<std::string> dispatch;
   dispatch.push_back(appId);
@@ -251,7 +250,7 @@ std::vector<std::string> BasicBundleProcessor::checkForward(
 
 bool BasicBundleProcessor::checkLifetime(BundleContainer &bundleContainer) {
   try {
-    BundleInfo bi = BundleInfo(bundleContainer.getBundle());
+    BundleInfo bi = *bundleContainer.getInfo();
     m_lifeWorker.execute(m_nodeState, bi);
     return m_lifeWorker.getResult();
   } catch (const WorkerException &e) {
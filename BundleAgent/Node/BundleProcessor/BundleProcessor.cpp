@@ -23,6 +23,12 @@
  */
 
 #include "Node/BundleProcessor/BundleProcessor.h"
+#include "Node/BundleProcessor/FragmentReassembler.h"
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,12 +48,19 @@
 #include "Bundle/Bundle.h"
 #include "Bundle/PrimaryBlock.h"
 #include "Bundle/PayloadBlock.h"
+#include "Bundle/CompressionMEB.h"
+#include "Bundle/WireImage.h"
 #include "Utils/globals.h"
 #include "Utils/Logger.h"
 #include "Utils/PerfLogger.h"
 #include "Utils/TimestampManager.h"
 #include "Utils/Functions.h"
 #include "Utils/Socket.h"
+#include "Utils/Arena.h"
+#include "Utils/MappedFile.h"
+#include "Utils/SeenFilter.h"
+
+const uint32_t BundleProcessor::RECEIVE_CHUNK_SIZE;
 
 BundleProcessor::BundleProcessor() {
 }
@@ -63,6 +76,27 @@ void BundleProcessor::start(
   m_bundleQueue = bundleQueue;
   m_neighbourTable = neighbourTable;
   m_listeningAppsTable = listeningAppsTable;
+  m_reassembler = std::unique_ptr<FragmentReassembler>(
+      new FragmentReassembler(m_config.getDataPath(),
+                              m_config.getPayloadFileThreshold()));
+  // The queue keeps in memory the bundles that fit, the rest are loaded from
+  // the data path when needed.
+  if (m_config.getQueueMemorySize() > 0) {
+    m_bundleQueue->setPaging(m_config.getDataPath(),
+                             m_config.getQueueMemorySize(),
+                             [this](const std::string &data) {
+                               return loadBundleContainer(data);
+                             });
+  }
+  if (m_config.getSeenWindow() > 0) {
+    m_seenFilter = std::unique_ptr<SeenFilter>(
+        new SeenFilter(m_config.getSeenWindow(), m_config.getSeenCapacity()));
+    if (!m_config.getSeenFilterPath().empty()
+        && m_seenFilter->load(m_config.getSeenFilterPath())) {
+      LOG(10) << "Restored the seen bundles from "
+              << m_config.getSeenFilterPath();
+    }
+  }
   LOG(10) << "Starting BundleProcessor";
   std::thread t = std::thread(&BundleProcessor::processBundles, this);
   t.detach();
@@ -75,8 +109,17 @@ void BundleProcessor::processBundles() {
                                        "Bundle Processor");
   g_startedThread++;
   while (!g_stop.load()) {
-    uint32_t oldValue;
-    while (((oldValue = g_queueProcessEvents) > 0) && !g_stop.load()) {
+    expireBundles();
+    while (!g_stop.load()) {
+      // The new neighbours only process the bundles that can go to them, the
+      // whole queue is processed when there is no contact left.
+      if (processContacts() > 0) {
+        continue;
+      }
+      uint32_t oldValue = g_queueProcessEvents;
+      if (oldValue == 0) {
+        break;
+      }
       uint32_t queueSize = m_bundleQueue->getSize();
       uint32_t i = 0;
       while (i < queueSize && !g_stop.load()) {
@@ -93,6 +136,12 @@ void BundleProcessor::processBundles() {
       }
       g_queueProcessEvents -= oldValue;
     }
+    // The seen bundles are saved when they change, at most once per loop.
+    if (m_seenFilter && !m_config.getSeenFilterPath().empty()
+        && !m_seenFilter->save(m_config.getSeenFilterPath())) {
+      LOG(3) << "Cannot save the seen bundles to "
+             << m_config.getSeenFilterPath();
+    }
     std::unique_lock<std::mutex> lck(g_processorMutex);
     if (g_processorConditionVariable.wait_for(
         lck, std::chrono::seconds(m_config.getProcessTimeout()))
@@ -105,6 +154,55 @@ void BundleProcessor::processBundles() {
   g_stopped++;
 }
 
+void BundleProcessor::expireBundles() {
+  if (!m_config.getProactiveExpiry()) {
+    return;
+  }
+  std::vector<std::unique_ptr<BundleContainer>> expired = m_bundleQueue
+      ->expire(time(NULL) - g_timeFrom2000);
+  for (auto &bc : expired) {
+    LOG(55) << "Bundle " << bc->readBundle().getId()
+            << " expired, discarding it.";
+    discard(std::move(bc));
+  }
+}
+
+uint32_t BundleProcessor::processContacts() {
+  std::vector<std::string> appeared = m_neighbourTable->takeAppeared();
+  if (!m_config.getContactScheduling()) {
+    // Every new neighbour processes the whole queue.
+    g_queueProcessEvents += appeared.size();
+    return 0;
+  }
+  for (auto &neighbourId : appeared) {
+    std::vector<std::string> endpoints;
+    try {
+      endpoints = m_neighbourTable->getValue(neighbourId)->getEndpoints();
+    } catch (const NeighbourTableException &e) {
+      LOG(60) << "Neighbour " << neighbourId << " has already disappeared";
+      continue;
+    }
+    endpoints.push_back(neighbourId);
+    LOG(60) << "Neighbour " << neighbourId << " schedules "
+            << m_bundleQueue->schedule(endpoints) << " bundles";
+  }
+  while (!g_stop.load()) {
+    std::unique_ptr<BundleContainer> bc;
+    try {
+      bc = m_bundleQueue->dequeueScheduled();
+    } catch (const EmptyBundleQueueException &e) {
+      break;
+    }
+    // A bundle that can not be sent waits for the next contact or the next
+    // pass of the queue, it does not start a new pass.
+    try {
+      processBundle(std::move(bc));
+    } catch (const std::exception &e) {
+    }
+  }
+  return appeared.size();
+}
+
 void BundleProcessor::receiveBundles() {
   Logger::getInstance()->setThreadName(std::this_thread::get_id(),
                                        "Bundle Receiver");
@@ -176,9 +274,19 @@ void BundleProcessor::receiveMessage(Socket sock) {
     } else {
       LOG(42) << "Received bundle length: " << bundleLength;
       std::string bundleStringRaw;
-      StringWithSize sws1 = StringWithSize(bundleStringRaw, bundleLength);
+      std::shared_ptr<const MappedFile> bundleFile;
+      bool received;
       LOG(42) << "Receiving bundle...";
-      if (!(sock >> sws1)) {
+      // Big bundles are written into a file as they arrive, so they never
+      // have to fit into memory.
+      if (m_config.getPayloadFileThreshold() > 0
+          && bundleLength > m_config.getPayloadFileThreshold()) {
+        received = receiveToFile(sock, bundleLength, bundleFile);
+      } else {
+        StringWithSize sws1 = StringWithSize(bundleStringRaw, bundleLength);
+        received = sock >> sws1;
+      }
+      if (!received) {
         LOG(3) << "Bundle not received correctly from " << sock.getPeerName()
                << sock.getLastError();
         sock.close();
@@ -189,8 +297,60 @@ void BundleProcessor::receiveMessage(Socket sock) {
         try {
           // Create the bundle
           LOG(42) << "Creating bundle from received raw";
-          std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
-              new Bundle(bundleStringRaw));
+          // The blocks of the bundle live in its own arena, that is released
+          // with the bundle container.
+          std::shared_ptr<Arena> arena;
+          if (m_config.getBundleArenaSize() > 0) {
+            arena = std::make_shared<Arena>(m_config.getBundleArenaSize());
+          }
+          std::unique_ptr<Bundle> b;
+          if (bundleFile) {
+            b = std::unique_ptr<Bundle>(new Bundle(bundleFile, arena));
+          } else {
+            b = std::unique_ptr<Bundle>(
+                new Bundle(std::move(bundleStringRaw), arena));
+          }
+          // A bundle received again is rejected before its blocks are read
+          // and it is stored.
+          if (m_seenFilter && srcNodeId != "_ADTN_LIB_"
+              && m_seenFilter->contains(b->getKey().toString(), time(NULL))) {
+            LOG(40) << "Discarding already seen bundle " << b->getId()
+                    << " from " << sock.getPeerName();
+            ack = static_cast<uint8_t>(BundleACK::ALREADY_IN_QUEUE);
+            if (!(sock << ack)) {
+              LOG(3) << "Cannot write to socket, reason: "
+                     << sock.getLastError();
+            }
+            sock.close();
+            return;
+          }
+          // Expired bundles are rejected before they are stored.
+          if (m_config.getProactiveExpiry() && srcNodeId != "_ADTN_LIB_"
+              && b->getPrimaryBlock()->getCreationTimestamp()
+                  + b->getPrimaryBlock()->getLifetime()
+                  < static_cast<uint64_t>(time(NULL) - g_timeFrom2000)) {
+            LOG(40) << "Discarding expired bundle " << b->getId() << " from "
+                    << sock.getPeerName();
+            ack = static_cast<uint8_t>(BundleACK::EXPIRED_BUNDLE);
+            if (!(sock << ack)) {
+              LOG(3) << "Cannot write to socket, reason: "
+                     << sock.getLastError();
+            }
+            sock.close();
+            return;
+          }
+          // Damaged bundles are rejected before they reach the queue.
+          if (m_config.getBlockChecksums() && !b->verifyChecksums()) {
+            LOG(3) << "Discarding damaged bundle " << b->getId() << " from "
+                   << sock.getPeerName();
+            ack = static_cast<uint8_t>(BundleACK::CORRUPTED_BUNDLE);
+            if (!(sock << ack)) {
+              LOG(3) << "Cannot write to socket, reason: "
+                     << sock.getLastError();
+            }
+            sock.close();
+            return;
+          }
           // If the source node is the library, change the timestamp to a one
           // generated from this node
           if (srcNodeId == "_ADTN_LIB_") {
@@ -201,40 +361,63 @@ void BundleProcessor::receiveMessage(Socket sock) {
             if (b->getPrimaryBlock()->getSource() == "_ADTN_LIB_") {
               b->getPrimaryBlock()->setSource(m_config.getNodeId());
             }
+            // The payload is compressed here, so the queues and the relays
+            // only hold the compressed bundle.
+            if (m_config.getCompressionThreshold() > 0
+                && b->getPayloadBlock() != nullptr
+                && b->getPayloadBlock()->getPayloadLength()
+                    > m_config.getCompressionThreshold()) {
+              try {
+                std::unique_ptr<Bundle> compressed = b->compressPayload(
+                    m_config.getCompressionLevel());
+                if (compressed) {
+                  b = std::move(compressed);
+                }
+              } catch (const CompressionException &e) {
+                LOG(3) << e.what();
+              }
+            }
           }
-          LOG(42) << "Creating bundle container";
-          // Create the bundleContainer
-          std::unique_ptr<BundleContainer> bc = createBundleContainer(
-              std::move(b));
-          // Save the bundleContainer to disk
-          std::string bundleId = bc->getBundle().getId();
-          LOG(42) << "Saving bundle " << bundleId << " to disk";
-          m_bundleQueue->saveBundleToDisk(m_config.getDataPath(), *bc);
-          // Execute process control
-          processControl(*bc);
-          // Enqueue the bundleContainer
-          LOG(42) << "Saving bundle to queue";
-          try {
-            m_bundleQueue->enqueue(std::move(bc));
-            // Notify Processor that a new bundle can be processed
-            g_queueProcessEvents++;
-            std::unique_lock<std::mutex> lck(g_processorMutex);
-            g_processorConditionVariable.notify_one();
-
-          } catch (const DroppedBundleQueueException &e) {
-            std::stringstream ss;
-            ss << m_config.getDataPath() << bundleId << ".bundle";
-            int success = std::remove(ss.str().c_str());
-            if (success != 0) {
-              LOG(3) << "Cannot delete bundle " << ss.str();
+          std::string bundleId = b->getId();
+          std::string seenKey = b->getKey().toString();
+          std::vector<std::unique_ptr<Bundle>> fragments;
+          std::string destination = b->getPrimaryBlock()->getDestination();
+          // Bundles to other nodes are split, so each fragment can be
+          // forwarded on its own when the contacts are short.
+          if (m_config.getFragmentSize() > 0
+              && destination.substr(0, destination.find(":"))
+                  != m_config.getNodeId()) {
+            try {
+              fragments = b->fragment(m_config.getFragmentSize());
+            } catch (const BundleException &e) {
+              LOG(3) << "Cannot fragment bundle " << bundleId << ", reason: "
+                     << e.what();
+            }
+          }
+          // The bundles generated in this node carry the checksums of its
+          // blocks.
+          bool created = srcNodeId == "_ADTN_LIB_" || !fragments.empty();
+          if (fragments.empty()) {
+            fragments.push_back(std::move(b));
+          } else {
+            LOG(42) << "Bundle " << bundleId << " split into "
+                    << fragments.size() << " fragments";
+          }
+          for (auto &fragment : fragments) {
+            if (created && m_config.getBlockChecksums()) {
+              fragment->addChecksums();
+            }
+            uint8_t fragmentAck = static_cast<uint8_t>(storeBundle(
+                std::move(fragment)));
+            if (ack == static_cast<uint8_t>(BundleACK::CORRECT_RECEIVED)) {
+              ack = fragmentAck;
             }
-            LOG(40) << e.what();
-            drop();
-            ack = static_cast<uint8_t>(BundleACK::QUEUE_FULL);
+          }
+          if (ack == static_cast<uint8_t>(BundleACK::QUEUE_FULL)) {
             PERF(PerfMessages::MESSAGE_DROPPED) << bundleId;
-          } catch (const InBundleQueueException &e) {
-            LOG(40) << e.what();
-            ack = static_cast<uint8_t>(BundleACK::ALREADY_IN_QUEUE);
+          } else if (m_seenFilter
+              && ack == static_cast<uint8_t>(BundleACK::CORRECT_RECEIVED)) {
+            m_seenFilter->insert(seenKey, time(NULL));
           }
           // Sending ACK
           LOG(42) << "Sending Bundle ACK: " << static_cast<unsigned int>(ack);
@@ -251,33 +434,174 @@ void BundleProcessor::receiveMessage(Socket sock) {
           sock.close();
         } catch (const BundleCreationException &e) {
           LOG(3) << "Error constructing received bundle, reason: " << e.what();
+        } catch (const std::exception &e) {
+          // The blocks are checked, compressed and sealed here, a bundle
+          // that fails is not stored.
+          LOG(3) << "Error processing received bundle, reason: " << e.what();
+          ack = static_cast<uint8_t>(BundleACK::CORRUPTED_BUNDLE);
+          if (!(sock << ack)) {
+            LOG(3) << "Cannot write to socket, reason: " << sock.getLastError();
+          }
+          sock.close();
         }
       }
     }
   }
 }
 
+BundleACK BundleProcessor::storeBundle(std::unique_ptr<Bundle> bundle) {
+  LOG(42) << "Creating bundle container";
+  // Create the bundleContainer
+  std::unique_ptr<BundleContainer> bc = createBundleContainer(
+      std::move(bundle));
+  // Save the bundleContainer to disk
+  std::string bundleId = bc->readBundle().getId();
+  LOG(42) << "Saving bundle " << bundleId << " to disk";
+  m_bundleQueue->saveBundleToDisk(m_config.getDataPath(), *bc);
+  // Execute process control
+  processControl(*bc);
+  // Enqueue the bundleContainer
+  LOG(42) << "Saving bundle to queue";
+  try {
+    // With a drop policy the queued bundles make room for the new one.
+    // The bundle is posted, so the receivers do not wait for each other.
+    m_bundleQueue->post(std::move(bc), m_config.getDropPolicy().empty());
+    // Notify Processor that a new bundle can be processed
+    g_queueProcessEvents++;
+    std::unique_lock<std::mutex> lck(g_processorMutex);
+    g_processorConditionVariable.notify_one();
+  } catch (const DroppedBundleQueueException &e) {
+    std::stringstream ss;
+    ss << m_config.getDataPath() << bundleId << ".bundle";
+    int success = std::remove(ss.str().c_str());
+    if (success != 0) {
+      LOG(3) << "Cannot delete bundle " << ss.str();
+    }
+    LOG(40) << e.what();
+    drop();
+    return BundleACK::QUEUE_FULL;
+  } catch (const InBundleQueueException &e) {
+    LOG(40) << e.what();
+    return BundleACK::ALREADY_IN_QUEUE;
+  }
+  return BundleACK::CORRECT_RECEIVED;
+}
+
+bool BundleProcessor::receiveToFile(Socket &sock, uint32_t bundleLength,
+                                    std::shared_ptr<const MappedFile> &file) {
+  int fd = MappedFile::createTemporary(m_config.getDataPath());
+  if (fd < 0) {
+    LOG(3) << "Cannot create a file for the bundle, reason: "
+           << strerror(errno);
+    return false;
+  }
+  std::string chunk;
+  uint32_t remaining = bundleLength;
+  while (remaining > 0) {
+    uint32_t chunkLength = std::min(remaining, RECEIVE_CHUNK_SIZE);
+    StringWithSize sws = StringWithSize(chunk, chunkLength);
+    if (!(sock >> sws)) {
+      close(fd);
+      return false;
+    }
+    size_t written = 0;
+    while (written < chunk.size()) {
+      ssize_t result = write(fd, chunk.data() + written,
+                             chunk.size() - written);
+      if (result < 0) {
+        LOG(3) << "Cannot write the bundle to file, reason: "
+               << strerror(errno);
+        close(fd);
+        return false;
+      }
+      written += result;
+    }
+    remaining -= chunkLength;
+  }
+  try {
+    file = std::make_shared<const MappedFile>(fd);
+  } catch (const MappedFileException &e) {
+    LOG(3) << e.what();
+    close(fd);
+    return false;
+  }
+  close(fd);
+  return true;
+}
+
 void BundleProcessor::delivery(BundleContainer &bundleContainer,
-                               std::vector<std::string> destinations) {
+                               const std::vector<std::string> &destinations) {
+  std::unique_ptr<Bundle> bundle;
+  if (bundleContainer.readBundle().getPrimaryBlock()->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::IS_FRAGMENT)) {
+    try {
+      bundle = m_reassembler->addFragment(bundleContainer.readBundle());
+    } catch (const BundleException &e) {
+      LOG(3) << "Cannot reassemble fragment "
+             << bundleContainer.readBundle().getId() << ", reason: "
+             << e.what();
+      return;
+    }
+    if (bundle == nullptr) {
+      LOG(11) << "Waiting for the rest of the fragments of "
+              << bundleContainer.readBundle().getId();
+      return;
+    }
+  }
+  // The applications receive the original payload.
+  std::unique_ptr<Bundle> original;
+  try {
+    original = (bundle ? *bundle : bundleContainer.readBundle())
+        .decompressPayload();
+  } catch (const CompressionException &e) {
+    LOG(3) << "Cannot decompress bundle "
+           << bundleContainer.readBundle().getId() << ", reason: " << e.what();
+    return;
+  }
+  if (original) {
+    bundle = std::move(original);
+  }
+  if (bundle == nullptr) {
+    deliverBundle(bundleContainer, destinations);
+  } else {
+    BundleContainer deliveredBundle(std::move(bundle));
+    deliverBundle(deliveredBundle, destinations);
+  }
+}
+
+void BundleProcessor::deliverBundle(
+    BundleContainer &bundleContainer,
+    const std::vector<std::string> &destinations) {
   LOG(11) << "Dispatching bundle";
-  std::string payload = bundleContainer.getBundle().toRaw();
-  uint32_t payloadSize = payload.length();
-  for (auto destination : destinations) {
+  // The bundle length and the bundle are sent in one call, from the buffers
+  // that hold the bundle blocks. All the endpoints get the same image.
+  std::shared_ptr<const WireImage> image = bundleContainer.readBundle()
+      .toWireImage();
+  uint32_t payloadSize = image->getLength();
+  uint32_t networkSize = htonl(payloadSize);
+  std::vector<ConstBuffer> buffers;
+  buffers.reserve(image->getSegments().size() + 1);
+  buffers.push_back(ConstBuffer(reinterpret_cast<const char*>(&networkSize),
+                                sizeof(networkSize)));
+  for (auto &segment : image->getSegments()) {
+    buffers.push_back(ConstBuffer(segment.data(), segment.length));
+  }
+  for (const auto &destination : destinations) {
     try {
       auto endpoints = m_listeningAppsTable->getValue(destination);
-      for (auto endpoint : endpoints) {
-        if (!endpoint->checkDeliveredId(bundleContainer.getBundle().getId())) {
-          if (!(endpoint->getSocket() << payloadSize)) {
+      for (auto &endpoint : endpoints) {
+        if (!endpoint->checkDeliveredId(
+            bundleContainer.readBundle().getKey())) {
+          if (!(endpoint->getSocket() << buffers)) {
+            LOG(1) << endpoint->getSocket().getLastError();
             LOG(11) << "Saving not delivered bundle to disk.";
             m_bundleQueue->saveBundleToDisk(m_config.getDeliveryPath(),
                                             bundleContainer);
             continue;
           }
-          endpoint->getSocket() << payload;
-          LOG(1) << endpoint->getSocket().getLastError();
-          LOG(60) << "Send the payload: " << payload << " to the appId: "
-                  << destination;
-          endpoint->addDeliveredId(bundleContainer.getBundle().getId());
+          LOG(60) << "Send a payload of length " << payloadSize
+                  << " to the appId: " << destination;
+          endpoint->addDeliveredId(bundleContainer.readBundle().getKey());
         } else {
           LOG(11) << "Saving trashed bundle to disk.";
           m_bundleQueue->saveBundleToDisk(m_config.getTrashDelivery(),
@@ -285,8 +609,8 @@ void BundleProcessor::delivery(BundleContainer &bundleContainer,
         }
       }
       PERF(MESSAGE_RECEIVED)
-          << bundleContainer.getBundle().getId() << " " << payloadSize << " "
-          << BundleInfo(bundleContainer.getBundle()).getCreationTimestamp();
+          << bundleContainer.getInfo()->getId() << " " << payloadSize << " "
+          << bundleContainer.getInfo()->getCreationTimestamp();
     } catch (const TableException &e) {
       LOG(3) << "Error getting appId, reason: " << e.what();
       LOG(11) << "Saving not delivered bundle to disk.";
@@ -296,19 +620,72 @@ void BundleProcessor::delivery(BundleContainer &bundleContainer,
   }
 }
 
-void BundleProcessor::forward(Bundle bundle, std::vector<std::string> nextHop) {
+int BundleProcessor::forward(Bundle &bundle,
+                             const std::vector<std::string> &nextHop) {
   LOG(11) << "Forwarding bundle";
-  std::string bundleRaw = bundle.toRaw();
-// Bundle length, this will limit the max length of a bundle to 2^32 ~ 4GB
-  uint32_t bundleLength = bundleRaw.length();
+  // The checksums are added at the source, they are only computed again if
+  // a block has been changed in this node. The bundles that arrive without
+  // them are forwarded as they are.
+  if (m_config.getBlockChecksums() && bundle.hasChecksums()
+      && bundle.isDirty()) {
+    bundle.addChecksums();
+  }
+  /**
+   * The bundle in the version used by a neighbour. It is sent from the
+   * buffers of its image, without joining them into a new raw bundle.
+   */
+  struct Encoding {
+    std::shared_ptr<const WireImage> image;
+    std::string header;
+    std::vector<ConstBuffer> buffers;
+    uint32_t length;
+  };
+  // Every encoding is generated once, the first time a neighbour uses it.
+  std::map<BundleEncoding, Encoding> encodings;
+  auto getEncoding = [this, &bundle, &encodings](
+      BundleEncoding bundleEncoding) -> const Encoding& {
+    auto it = encodings.find(bundleEncoding);
+    if (it != encodings.end()) {
+      return it->second;
+    }
+    Encoding &encoding = encodings[bundleEncoding];
+    try {
+      encoding.image = bundle.toWireImage(bundleEncoding);
+    } catch (const BundleException &e) {
+      LOG(3) << "Cannot encode bundle " << bundle.getId() << " in encoding "
+             << static_cast<int>(bundleEncoding) << ", reason: " << e.what();
+      encoding.image = bundle.toWireImage();
+    }
+    // Bundle length, this will limit the max length of a bundle to 2^32 ~ 4GB
+    encoding.length = encoding.image->getLength();
+    // The node id, padded to 1024 bytes, and the bundle length are sent
+    // with the bundle.
+    encoding.header = m_config.getNodeId().substr(0, 1023);
+    encoding.header.resize(1024, '\0');
+    uint32_t networkLength = htonl(encoding.length);
+    encoding.header.append(reinterpret_cast<const char*>(&networkLength),
+                           sizeof(networkLength));
+    encoding.buffers.reserve(encoding.image->getSegments().size() + 1);
+    encoding.buffers.push_back(ConstBuffer(encoding.header.data(),
+                                           encoding.header.size()));
+    for (auto &segment : encoding.image->getSegments()) {
+      encoding.buffers.push_back(ConstBuffer(segment.data(), segment.length));
+    }
+    return encoding;
+  };
   std::string bundleId = bundle.getId();
-  if (bundleLength <= 0) {
+  int hops = 0;
+  if (bundle.getRawLength() == 0) {
     LOG(3) << "The bundle to forward has a length of 0, aborting forward.";
   } else {
     auto forwardFunction =
-        [this, bundleRaw, bundleLength, bundleId](std::string &nh) {
+        [this, &getEncoding, &bundleId](const std::string &nh) {
           LOG(45) << "Forwarding bundle to " << nh;
-          LOG(50) << "Bundle to forward " << bundleRaw;
+          const Encoding &encoding = getEncoding(
+              m_config.getBundleEncoding(nh));
+          const std::vector<ConstBuffer> &buffers = encoding.buffers;
+          uint32_t bundleLength = encoding.length;
+          LOG(50) << "Bundle to forward of length " << bundleLength;
           std::shared_ptr<Neighbour> nb = m_neighbourTable->getValue(nh);
           Socket s = Socket();
           if (!s) {
@@ -343,9 +720,10 @@ void BundleProcessor::forward(Bundle bundle, std::vector<std::string> nextHop) {
                   throw ForwardNetworkException(ss.str(),
                       static_cast<uint8_t>(NetworkError::SOCKET_CONNECT_ERROR));
                 } else {
-                  LOG(46) << "Sending node id: " << m_config.getNodeId();
-                  ConstStringWithSize csws = ConstStringWithSize(m_config.getNodeId(), 1024);
-                  if (!(s << csws)) {
+                  LOG(46) << "Sending node id: " << m_config.getNodeId()
+                          << ", bundle length: " << bundleLength
+                          << " and bundle...";
+                  if (!(s << buffers)) {
                     std::stringstream ss;
                     ss << "Cannot write to socket, reason: "
                     << s.getLastError();
@@ -353,54 +731,41 @@ void BundleProcessor::forward(Bundle bundle, std::vector<std::string> nextHop) {
                     throw ForwardNetworkException(ss.str(),
                         static_cast<uint8_t>(NetworkError::SOCKET_WRITE_ERROR));
                   } else {
-                    LOG(46) << "Sending bundle length: " << bundleLength;
-                    if (!(s << bundleLength)) {
+                    uint8_t ack;
+                    if (!(s >> ack)) {
                       std::stringstream ss;
-                      ss << "Cannot write to socket, reason: "
-                      << s.getLastError();
+                      ss << "Error receiving bundle ACK";
                       s.close();
                       throw ForwardNetworkException(ss.str(),
-                          static_cast<uint8_t>(NetworkError::SOCKET_WRITE_ERROR));
+                          static_cast<uint8_t>(NetworkError::SOCKET_RECEIVE_ERROR));
                     } else {
-                      LOG(46) << "Sending bundle...";
-                      if (!(s << bundleRaw)) {
-                        std::stringstream ss;
-                        ss << "Cannot write to socket, reason: "
-                        << s.getLastError();
-                        s.close();
-                        throw ForwardNetworkException(ss.str(),
-                            static_cast<uint8_t>(NetworkError::SOCKET_WRITE_ERROR));
-                      }
-                      uint8_t ack;
-                      if (!(s >> ack)) {
-                        std::stringstream ss;
-                        ss << "Error receiving bundle ACK";
-                        s.close();
-                        throw ForwardNetworkException(ss.str(),
-                            static_cast<uint8_t>(NetworkError::SOCKET_RECEIVE_ERROR));
+                      LOG(46) << "Received bundle ACK: " << static_cast<unsigned int>(ack);
+                      if (ack == static_cast<uint8_t>(BundleACK::CORRECT_RECEIVED) || ack == static_cast<uint8_t>(BundleACK::QUEUE_FULL)) {
+                        LOG(11) << "A bundle of length " << bundleLength
+                        << " has been sent to " << nb->getNodeAddress()
+                        << ":" << nb->getNodePort() << " from "
+                        << s.getPeerName();
+                        PERF(MESSAGE_RELAYED) << bundleId << " " << s.getPeerName() << " " << bundleLength;
                       } else {
-                        LOG(46) << "Received bundle ACK: " << static_cast<unsigned int>(ack);
-                        if (ack == static_cast<uint8_t>(BundleACK::CORRECT_RECEIVED) || ack == static_cast<uint8_t>(BundleACK::QUEUE_FULL)) {
-                          LOG(11) << "A bundle of length " << bundleLength
-                          << " has been sent to " << nb->getNodeAddress()
-                          << ":" << nb->getNodePort() << " from "
-                          << s.getPeerName();
-                          PERF(MESSAGE_RELAYED) << bundleId << " " << s.getPeerName() << " " << bundleLength;
+                        std::stringstream ss;
+                        uint8_t error;
+                        if (ack == static_cast<uint8_t>(BundleACK::ALREADY_IN_QUEUE)) {
+                          ss << "Node already has the bundle in queue.";
+                          error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_IN_QUEUE);
+                        } else if (ack == static_cast<uint8_t>(BundleACK::QUEUE_FULL)) {
+                          ss << "Full queue of neighbour.";
+                          error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_FULL_QUEUE);
+                        } else if (ack == static_cast<uint8_t>(BundleACK::CORRUPTED_BUNDLE)) {
+                          ss << "Neighbour received a damaged bundle.";
+                          error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_CORRUPTED_BUNDLE);
+                        } else if (ack == static_cast<uint8_t>(BundleACK::EXPIRED_BUNDLE)) {
+                          ss << "Neighbour received an expired bundle.";
+                          error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_EXPIRED_BUNDLE);
                         } else {
-                          std::stringstream ss;
-                          uint8_t error;
-                          if (ack == static_cast<uint8_t>(BundleACK::ALREADY_IN_QUEUE)) {
-                            ss << "Node already has the bundle in queue.";
-                            error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_IN_QUEUE);
-                          } else if (ack == static_cast<uint8_t>(BundleACK::QUEUE_FULL)) {
-                            ss << "Full queue of neighbour.";
-                            error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_FULL_QUEUE);
-                          } else {
-                            ss << "Bad ack received.";
-                            error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_BAD_ACK);
-                          }
-                          throw ForwardNetworkException(ss.str(), error);
+                          ss << "Bad ack received.";
+                          error = static_cast<uint8_t>(NetworkError::NEIGHBOUR_BAD_ACK);
                         }
+                        throw ForwardNetworkException(ss.str(), error);
                       }
                     }
                   }
@@ -410,9 +775,8 @@ void BundleProcessor::forward(Bundle bundle, std::vector<std::string> nextHop) {
             s.close();
           }
         };
-    int hops = 0;
     std::map<std::string, uint8_t> errors;
-    for (auto hop : nextHop) {
+    for (const auto &hop : nextHop) {
       try {
         forwardFunction(hop);
         hops++;
@@ -426,19 +790,27 @@ void BundleProcessor::forward(Bundle bundle, std::vector<std::string> nextHop) {
                              errors);
     }
   }
+  return hops;
+}
+
+void BundleProcessor::forward(BundleContainer &bundleContainer,
+                              const std::vector<std::string> &nextHop) {
+  // The bundle is scheduled again when one of the next hops is in contact.
+  bundleContainer.setNextHops(nextHop);
+  bundleContainer.addForwards(forward(bundleContainer.getBundle(), nextHop));
 }
 
 void BundleProcessor::discard(
     std::unique_ptr<BundleContainer> bundleContainer) {
   std::stringstream ss;
-  ss << m_config.getDataPath() << bundleContainer->getBundle().getId()
+  ss << m_config.getDataPath() << bundleContainer->readBundle().getId()
      << ".bundle";
   int success = std::remove(ss.str().c_str());
   if (success != 0) {
     LOG(3) << "Cannot delete bundle " << ss.str();
   }
   LOG(51) << "Deleting bundleContainer.";
-  PERF(PerfMessages::MESSAGE_REMOVED) << bundleContainer->getBundle().getId();
+  PERF(PerfMessages::MESSAGE_REMOVED) << bundleContainer->readBundle().getId();
   bundleContainer.reset();
   m_bundleQueue->resetLast();
 }
@@ -458,6 +830,17 @@ void BundleProcessor::restoreRawBundleContainer(const std::string &data) {
   try {
     std::unique_ptr<BundleContainer> bundleContainer = std::unique_ptr<
         BundleContainer>(new BundleContainer(data));
+    if (m_config.getBlockChecksums()
+        && !bundleContainer->readBundle().verifyChecksums()) {
+      std::stringstream ss;
+      ss << m_config.getDataPath() << bundleContainer->readBundle().getId()
+         << ".bundle";
+      LOG(3) << "Discarding damaged bundle " << ss.str();
+      if (std::remove(ss.str().c_str()) != 0) {
+        LOG(3) << "Cannot delete bundle " << ss.str();
+      }
+      return;
+    }
     try {
       m_bundleQueue->enqueue(std::move(bundleContainer));
     } catch (const DroppedBundleQueueException &e) {
@@ -469,6 +852,11 @@ void BundleProcessor::restoreRawBundleContainer(const std::string &data) {
   }
 }
 
+std::unique_ptr<BundleContainer> BundleProcessor::loadBundleContainer(
+    const std::string &data) {
+  return std::unique_ptr<BundleContainer>(new BundleContainer(data));
+}
+
 void BundleProcessor::drop() {
 }
 
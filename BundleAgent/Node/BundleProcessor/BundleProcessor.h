@@ -29,6 +29,7 @@
 #include <vector>
 #include <string>
 #include <exception>
+#include <stdexcept>
 #include <map>
 #include "Node/Config.h"
 #include "Utils/Socket.h"
@@ -39,6 +40,9 @@ class BundleContainer;
 class NeighbourTable;
 class ListeningEndpointsTable;
 class Neighbour;
+class MappedFile;
+class FragmentReassembler;
+class SeenFilter;
 
 /**
  * Esception with a list of what error occurred at each neighbour.
@@ -84,7 +88,9 @@ enum class BundleACK
   : uint8_t {
     CORRECT_RECEIVED = 0x00,
   ALREADY_IN_QUEUE = 0x01,
-  QUEUE_FULL = 0x02
+  QUEUE_FULL = 0x02,
+  CORRUPTED_BUNDLE = 0x03,
+  EXPIRED_BUNDLE = 0x04
 };
 
 /**
@@ -99,7 +105,9 @@ enum class NetworkError
   SOCKET_RECEIVE_ERROR = 0x04,
   NEIGHBOUR_FULL_QUEUE = 0x05,
   NEIGHBOUR_IN_QUEUE = 0x06,
-  NEIGHBOUR_BAD_ACK = 0x07
+  NEIGHBOUR_BAD_ACK = 0x07,
+  NEIGHBOUR_CORRUPTED_BUNDLE = 0x08,
+  NEIGHBOUR_EXPIRED_BUNDLE = 0x09
 };
 
 /**
@@ -147,22 +155,45 @@ class BundleProcessor {
   /**
    * @brief Function that dispatches a bundle.
    *
-   * This function will dispatch a bundle to the given destinations.
+   * This function will dispatch a bundle to the given destinations. The
+   * fragments are kept until the whole bundle is received, and then the
+   * whole bundle is dispatched. Compressed payloads are decompressed.
+   *
+   * The bundle is encoded once and the same image is sent to all the
+   * destinations.
    *
    * @param bundle Bundle to delivery.
    * @param destinations List of all the destinations to delivery the bundle.
    */
   void delivery(BundleContainer &bundleContainer,
-                std::vector<std::string> destinations);
+                const std::vector<std::string> &destinations);
   /**
    * @brief Function that forwards a bundle.
    *
-   * This function will forward a bundle to the given destinations.
+   * This function will forward a bundle to the given destinations. The
+   * bundle is encoded once for each version used by the destinations, and
+   * the images are shared between them, so the payload is never copied.
+   * The bundle stays owned by the caller, it is only changed to add the
+   * block checksums.
    *
    * @param bundle Bundle to forward.
    * @param nextHop List of all the destinations to forward the bundle.
+   * @return The number of destinations that received the bundle.
+   */
+  int forward(Bundle &bundle, const std::vector<std::string> &nextHop);
+  /**
+   * @brief Function that forwards the bundle of a container.
+   *
+   * The bundle is forwarded as forward(Bundle&), and the destinations that
+   * received it are added to the forward count of the container. The
+   * destinations are kept in the container, so the queue can schedule the
+   * bundle again when one of them is in contact.
+   *
+   * @param bundleContainer The container of the bundle to forward.
+   * @param nextHop List of all the destinations to forward the bundle.
    */
-  void forward(Bundle bundle, std::vector<std::string> nextHop);
+  void forward(BundleContainer &bundleContainer,
+               const std::vector<std::string> &nextHop);
   /**
    * @brief Function that discards a bundle container.
    *
@@ -209,10 +240,32 @@ class BundleProcessor {
   std::shared_ptr<ListeningEndpointsTable> m_listeningAppsTable;
 
  private:
+  /**
+   * Joins the fragments that reach this node before their delivery.
+   */
+  std::unique_ptr<FragmentReassembler> m_reassembler;
+  /**
+   * Remembers the received bundles, to reject them when they are received
+   * again. nullptr if disabled.
+   */
+  std::unique_ptr<SeenFilter> m_seenFilter;
   /**
    * Function that processes the bundles.
    */
   void processBundles();
+  /**
+   * Processes the bundles scheduled by the neighbours that have appeared,
+   * if the contact scheduling is enabled. Otherwise each new neighbour is
+   * added to the queue process events.
+   *
+   * @return The number of neighbours that have scheduled bundles.
+   */
+  uint32_t processContacts();
+  /**
+   * Discards the queued bundles that have expired, if the proactive expiry
+   * is enabled.
+   */
+  void expireBundles();
   /**
    * Function that receives the bundles.
    */
@@ -223,6 +276,35 @@ class BundleProcessor {
    * @param sock Socket to read the message.
    */
   void receiveMessage(Socket sock);
+  /**
+   * @brief Saves a received bundle to disk and enqueues it.
+   *
+   * @param bundle The bundle received.
+   * @return The ACK for the sender.
+   */
+  BundleACK storeBundle(std::unique_ptr<Bundle> bundle);
+  /**
+   * @brief Sends a whole bundle to the listening apps.
+   *
+   * @param bundleContainer The bundle container to send.
+   * @param destinations List of all the destinations to delivery the bundle.
+   */
+  void deliverBundle(BundleContainer &bundleContainer,
+                     const std::vector<std::string> &destinations);
+  /**
+   * @brief Receives a bundle into an anonymous file in the data path.
+   *
+   * @param sock Socket to read the bundle.
+   * @param bundleLength The length of the bundle.
+   * @param file Set to the mapped file that holds the bundle.
+   * @return True if the bundle has been received.
+   */
+  bool receiveToFile(Socket &sock, uint32_t bundleLength,
+                     std::shared_ptr<const MappedFile> &file);
+  /**
+   * Number of bytes read at once when a bundle is received into a file.
+   */
+  static const uint32_t RECEIVE_CHUNK_SIZE = 64 * 1024;
   /**
    * Function that processes one given bundle container.
    * Virtual function, all the bundleProcessors must implement it.
@@ -242,6 +324,15 @@ class BundleProcessor {
    */
   virtual std::unique_ptr<BundleContainer> createBundleContainer(
       std::unique_ptr<Bundle> Bundle) = 0;
+  /**
+   * Function that loads a bundle container paged out by the queue.
+   * By default it generates a BundleContainer.
+   *
+   * @param data The serialized bundle container.
+   * @return The bundle container.
+   */
+  virtual std::unique_ptr<BundleContainer> loadBundleContainer(
+      const std::string &data);
 };
 
 #endif  // BUNDLEAGENT_NODE_BUNDLEPROCESSOR_BUNDLEPROCESSOR_H_
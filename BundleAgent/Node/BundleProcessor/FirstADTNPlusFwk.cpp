@@ -199,7 +199,7 @@ bool FirstADTNPlusFwk::processBundle(
     if (neighbours.size() > 0) {
       LOG(55) << "There are some neighbours. Sending the bundle to neighbours.";
       try {
-        forward(bundleContainer->getBundle(), neighbours);
+        forward(*bundleContainer, neighbours);
         bundleContainer->getState()["forwarded"] = true;
         if (bundleContainer->getState()["discard"]) {
           LOG(55) << "Discarding the bundle.";
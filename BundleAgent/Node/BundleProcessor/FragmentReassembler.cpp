@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE FragmentReassembler.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the FragmentReassembler class.
+ */
+
+#include "Node/BundleProcessor/FragmentReassembler.h"
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/IntegrityMEB.h"
+#include "Utils/Logger.h"
+#include "Utils/MappedFile.h"
+
+/**
+ * Writes all the data into the file, returns false on error.
+ */
+static bool writeAll(int fd, const char *data, size_t length) {
+  while (length > 0) {
+    ssize_t result = write(fd, data, length);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += result;
+    length -= result;
+  }
+  return true;
+}
+
+FragmentReassembler::PendingBundle::PendingBundle()
+    : totalLength(0),
+      hasHead(false),
+      hasTail(false),
+      fd(-1) {
+}
+
+FragmentReassembler::PendingBundle::~PendingBundle() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+FragmentReassembler::FragmentReassembler(const std::string &spoolPath,
+                                         uint64_t fileThreshold)
+    : m_spoolPath(spoolPath),
+      m_fileThreshold(fileThreshold) {
+}
+
+FragmentReassembler::~FragmentReassembler() {
+}
+
+std::unique_ptr<Bundle> FragmentReassembler::addFragment(
+    const Bundle &fragment) {
+  std::shared_ptr<const PrimaryBlock> primaryBlock = fragment.getPrimaryBlock();
+  std::shared_ptr<const PayloadBlock> payloadBlock =
+      fragment.getPayloadBlock();
+  if (!primaryBlock->checkPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT)
+      || payloadBlock == nullptr) {
+    throw BundleException("[FragmentReassembler] The bundle is not a fragment");
+  }
+  uint64_t offset = primaryBlock->getFragmentOffset();
+  uint64_t totalLength = primaryBlock->getTotalApplicationDataLength();
+  RawSegment payload = payloadBlock->getPayloadSegment();
+  if (offset + payload.length > totalLength) {
+    throw BundleException(
+        "[FragmentReassembler] The fragment exceeds the bundle payload");
+  }
+  std::lock_guard<std::mutex> lck(m_mutex);
+  removeExpired();
+  BundleKey key = fragment.getKey().getWholeBundleKey();
+  auto it = m_pending.find(key);
+  if (it == m_pending.end()) {
+    std::unique_ptr<PendingBundle> pending(new PendingBundle());
+    pending->totalLength = totalLength;
+    pending->expiration = std::chrono::steady_clock::now()
+        + std::chrono::seconds(primaryBlock->getLifetime());
+    if (m_fileThreshold > 0 && totalLength > m_fileThreshold) {
+      pending->fd = MappedFile::createTemporary(m_spoolPath);
+      if (pending->fd < 0) {
+        LOG(3) << "Cannot create a file for the fragments, reason: "
+               << strerror(errno);
+      }
+    }
+    if (pending->fd < 0) {
+      pending->payload.resize(totalLength);
+    }
+    it = m_pending.emplace(key, std::move(pending)).first;
+  } else if (it->second->totalLength != totalLength) {
+    throw BundleException(
+        "[FragmentReassembler] The fragment does not match the bundle length");
+  }
+  PendingBundle &pending = *it->second;
+  LOG(51) << "Adding fragment of bundle " << key.toString() << " at offset "
+          << offset << " with length " << payload.length;
+  // Only the ranges not received yet have to be written.
+  if (!pending.received.contains(offset, offset + payload.length)) {
+    writePayload(pending, offset, payload.data(), payload.length);
+    pending.received.insert(offset, offset + payload.length);
+  }
+  bool first = offset == 0;
+  bool last = offset + payload.length == totalLength;
+  if ((first && !pending.hasHead) || (last && !pending.hasTail)) {
+    std::vector<std::shared_ptr<const Block>> blocks = fragment.getBlocks();
+    std::string before, after;
+    bool payloadFound = false;
+    for (size_t i = 1; i < blocks.size(); ++i) {
+      if (blocks[i] == payloadBlock) {
+        payloadFound = true;
+      } else if (std::dynamic_pointer_cast<const IntegrityMEB>(blocks[i])) {
+        // The checksums of the fragment are not valid for the bundle.
+        continue;
+      } else {
+        RawSegment segment = blocks[i]->getRawSegment();
+        (payloadFound ? after : before).append(segment.data(),
+                                               segment.length);
+      }
+    }
+    if (first && !pending.hasHead) {
+      PrimaryBlock primary(*primaryBlock);
+      primary.unsetPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT);
+      pending.head = primary.toRaw() + before;
+      pending.payloadFlags = payloadBlock->getProcFlags();
+      pending.hasHead = true;
+    }
+    if (last && !pending.hasTail) {
+      pending.tail = after;
+      pending.hasTail = true;
+    }
+  }
+  if (!pending.hasHead || !pending.hasTail
+      || pending.received.getCoveredLength() < pending.totalLength) {
+    return nullptr;
+  }
+  LOG(51) << "Reassembled bundle " << key.toString();
+  std::unique_ptr<Bundle> bundle = build(pending);
+  m_pending.erase(it);
+  return bundle;
+}
+
+size_t FragmentReassembler::getPendingBundles() {
+  std::lock_guard<std::mutex> lck(m_mutex);
+  return m_pending.size();
+}
+
+void FragmentReassembler::writePayload(PendingBundle &pending,
+                                       uint64_t offset, const char *data,
+                                       size_t length) {
+  if (pending.fd < 0) {
+    pending.payload.replace(offset, length, data, length);
+    return;
+  }
+  while (length > 0) {
+    ssize_t result = pwrite(pending.fd, data, length, offset);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw BundleException(
+          "[FragmentReassembler] Cannot write the fragment, reason: "
+              + std::string(strerror(errno)));
+    }
+    data += result;
+    offset += result;
+    length -= result;
+  }
+}
+
+std::unique_ptr<Bundle> FragmentReassembler::build(PendingBundle &pending) {
+  std::bitset<7> flags = pending.payloadFlags;
+  flags.set(static_cast<uint32_t>(CanonicalBlockControlFlags::LAST_BLOCK),
+            pending.tail.empty());
+  std::string header = PayloadBlock::encodeHeader(flags, pending.totalLength);
+  if (pending.fd < 0) {
+    std::string raw;
+    raw.reserve(pending.head.size() + header.size() + pending.totalLength
+        + pending.tail.size());
+    raw.append(pending.head).append(header).append(pending.payload).append(
+        pending.tail);
+    return std::unique_ptr<Bundle>(new Bundle(std::move(raw)));
+  }
+  // The bundle is written into a new file, so it never has to fit into memory.
+  MappedFile payload(pending.fd);
+  int fd = MappedFile::createTemporary(m_spoolPath);
+  if (fd < 0) {
+    throw BundleException(
+        "[FragmentReassembler] Cannot create a file for the bundle, reason: "
+            + std::string(strerror(errno)));
+  }
+  std::shared_ptr<const MappedFile> file;
+  try {
+    if (!writeAll(fd, pending.head.data(), pending.head.size())
+        || !writeAll(fd, header.data(), header.size())
+        || !writeAll(fd, payload.data(), payload.size())
+        || !writeAll(fd, pending.tail.data(), pending.tail.size())) {
+      throw BundleException(
+          "[FragmentReassembler] Cannot write the bundle, reason: "
+              + std::string(strerror(errno)));
+    }
+    file = std::make_shared<const MappedFile>(fd);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return std::unique_ptr<Bundle>(new Bundle(file));
+}
+
+void FragmentReassembler::removeExpired() {
+  auto now = std::chrono::steady_clock::now();
+  for (auto it = m_pending.begin(); it != m_pending.end();) {
+    if (it->second->expiration < now) {
+      LOG(51) << "Discarding the fragments of expired bundle "
+              << it->first.toString();
+      it = m_pending.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
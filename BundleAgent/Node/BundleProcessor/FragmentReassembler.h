@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE FragmentReassembler.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the FragmentReassembler class.
+ */
+#ifndef BUNDLEAGENT_NODE_BUNDLEPROCESSOR_FRAGMENTREASSEMBLER_H_
+#define BUNDLEAGENT_NODE_BUNDLEPROCESSOR_FRAGMENTREASSEMBLER_H_
+
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Bundle/BundleKey.h"
+#include "Utils/IntervalIndex.h"
+
+class Bundle;
+
+/**
+ * CLASS FragmentReassembler
+ * This class joins the fragments of a bundle into the original bundle.
+ *
+ * The fragments are grouped by the key of the original bundle, the received
+ * payload ranges are kept into an IntervalIndex, so repeated or overlapping
+ * fragments are accepted and the completion check does not depend on the
+ * number of fragments. Payloads bigger than the file threshold are written
+ * into an anonymous file instead of memory.
+ */
+class FragmentReassembler {
+ public:
+  /**
+   * @brief Generates a FragmentReassembler.
+   *
+   * @param spoolPath The directory of the files of the big payloads, ending
+   *                  with a slash.
+   * @param fileThreshold Payloads bigger than this are written into a file,
+   *                      0 to keep all of them in memory.
+   */
+  explicit FragmentReassembler(const std::string &spoolPath = "",
+                               uint64_t fileThreshold = 0);
+  /**
+   * Destructor of the class.
+   */
+  virtual ~FragmentReassembler();
+  FragmentReassembler(const FragmentReassembler&) = delete;
+  FragmentReassembler& operator=(const FragmentReassembler&) = delete;
+  /**
+   * @brief Adds a fragment.
+   *
+   * The pending bundles whose lifetime has passed are discarded.
+   * Throws a BundleException if the fragment does not match the other
+   * fragments of its bundle.
+   *
+   * @param fragment The fragment received.
+   * @return The original bundle if this fragment completes it, nullptr
+   *         otherwise.
+   */
+  std::unique_ptr<Bundle> addFragment(const Bundle &fragment);
+  /**
+   * @brief Returns the number of bundles waiting for fragments.
+   *
+   * @return The number of pending bundles.
+   */
+  size_t getPendingBundles();
+
+ private:
+  /**
+   * Fragments received of one bundle.
+   */
+  struct PendingBundle {
+    PendingBundle();
+    ~PendingBundle();
+    /**
+     * Ranges of the payload received.
+     */
+    IntervalIndex received;
+    /**
+     * Length of the original payload.
+     */
+    uint64_t totalLength;
+    /**
+     * Primary block and blocks before the payload, from the first fragment.
+     */
+    std::string head;
+    /**
+     * Blocks after the payload, from the last fragment.
+     */
+    std::string tail;
+    bool hasHead;
+    bool hasTail;
+    /**
+     * Processing flags of the payload block.
+     */
+    std::bitset<7> payloadFlags;
+    /**
+     * Payload, when it is kept in memory.
+     */
+    std::string payload;
+    /**
+     * File that holds the payload, -1 if it is kept in memory.
+     */
+    int fd;
+    /**
+     * Moment when the bundle lifetime ends.
+     */
+    std::chrono::steady_clock::time_point expiration;
+  };
+  /**
+   * @brief Writes a fragment payload into the pending bundle.
+   *
+   * @param pending The pending bundle.
+   * @param offset The offset of the fragment into the payload.
+   * @param data The fragment payload.
+   * @param length The length of the fragment payload.
+   */
+  void writePayload(PendingBundle &pending, uint64_t offset, const char *data,
+                    size_t length);
+  /**
+   * @brief Generates the original bundle from its fragments.
+   *
+   * @param pending The complete pending bundle.
+   * @return The original bundle.
+   */
+  std::unique_ptr<Bundle> build(PendingBundle &pending);
+  /**
+   * Removes the pending bundles whose lifetime has passed.
+   */
+  void removeExpired();
+  /**
+   * Directory of the payload files.
+   */
+  std::string m_spoolPath;
+  /**
+   * Payload length from which the payload is written into a file.
+   */
+  uint64_t m_fileThreshold;
+  /**
+   * Pending bundles by the key of the original bundle.
+   */
+  std::unordered_map<BundleKey, std::unique_ptr<PendingBundle>> m_pending;
+  /**
+   * Mutex for the pending bundles.
+   */
+  std::mutex m_mutex;
+};
+
+#endif  // BUNDLEAGENT_NODE_BUNDLEPROCESSOR_FRAGMENTREASSEMBLER_H_
@@ -142,10 +142,10 @@ bool RouteReportingBundleProcessor::processBundle(
         auto it = std::find(
             neighbours.begin(),
             neighbours.end(),
-            bundleContainer->getBundle().getPrimaryBlock()->getDestination()
+            bundleContainer->getInfo()->getDestination()
                 .substr(
                 0,
-                bundleContainer->getBundle().getPrimaryBlock()->getDestination()
+                bundleContainer->getInfo()->getDestination()
                     .find(":")));
         if (it != neighbours.end()) {
           LOG(55) << "Destination found, sending the bundle to it.";
@@ -158,7 +158,7 @@ bool RouteReportingBundleProcessor::processBundle(
                 dynamic_cast<RouteReportingBC*>(bundleContainer.get());
             rrbc->setDepartureTime(departureTime);
             checkRouteReporting(*rrbc);
-            forward(bundleContainer->getBundle(), nextHop);
+            forward(*bundleContainer, nextHop);
             LOG(55) << "Discarding the bundle.";
             discard(std::move(bundleContainer));
           } catch (const ForwardException &e) {
@@ -176,7 +176,7 @@ bool RouteReportingBundleProcessor::processBundle(
                 dynamic_cast<RouteReportingBC*>(bundleContainer.get());
             rrbc->setDepartureTime(departureTime);
             checkRouteReporting(*rrbc);
-            forward(bundleContainer->getBundle(), neighbours);
+            forward(*bundleContainer, neighbours);
             LOG(55) << "Discarding the bundle.";
             discard(std::move(bundleContainer));
           } catch (const ForwardException &e) {
@@ -194,6 +194,11 @@ bool RouteReportingBundleProcessor::processBundle(
   return true;
 }
 
+std::unique_ptr<BundleContainer>
+RouteReportingBundleProcessor::loadBundleContainer(const std::string &data) {
+  return std::unique_ptr<BundleContainer>(new RouteReportingBC(data));
+}
+
 void RouteReportingBundleProcessor::restoreRawBundleContainer(
     const std::string &data) {
   try {
@@ -70,6 +70,15 @@ class RouteReportingBundleProcessor : public BasicBundleProcessor {
    *
    */
   virtual void restoreRawBundleContainer(const std::string &data);
+  /**
+   * Function that loads a route reporting bundle container paged out by the
+   * queue.
+   *
+   * @param data The serialized route reporting bundle container.
+   * @return The bundle container.
+   */
+  virtual std::unique_ptr<BundleContainer> loadBundleContainer(
+      const std::string &data);
 };
 
 #endif  // BUNDLEAGENT_NODE_BUNDLEPROCESSOR_ROUTEREPORTINGBUNDLEPROCESSOR_H_
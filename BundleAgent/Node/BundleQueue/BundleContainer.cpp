@@ -30,67 +30,124 @@
 #include <cstring>
 #include <exception>
 #include <iostream>
+#include <utility>
+#include <vector>
 #include "Bundle/Bundle.h"
+#include "Bundle/BundleInfo.h"
 
 BundleContainer::BundleContainer(std::unique_ptr<Bundle> bundle)
     : m_bundle(std::move(bundle)),
-      m_state() {
+      m_state(),
+      m_forwards(0) {
 }
 
 BundleContainer::BundleContainer()
     : m_bundle(),
-      m_state() {
+      m_state(),
+      m_forwards(0) {
 }
 
 BundleContainer::~BundleContainer() {
 }
 
-BundleContainer::BundleContainer(const std::string &data) {
+BundleContainer::BundleContainer(const std::string &data)
+    : m_forwards(0) {
   deserialize(data);
 }
 
 BundleContainer::BundleContainer(BundleContainer&& bc)
     : m_bundle(std::move(bc.m_bundle)),
-      m_state(bc.m_state) {
+      m_state(bc.m_state),
+      m_info(std::move(bc.m_info)),
+      m_forwards(bc.m_forwards),
+      m_nextHops(std::move(bc.m_nextHops)),
+      m_savedPath(std::move(bc.m_savedPath)) {
 }
 
 Bundle& BundleContainer::getBundle() {
+  m_info.reset();
+  m_savedPath.clear();
   return *m_bundle;
 }
 
+const Bundle& BundleContainer::readBundle() const {
+  return *m_bundle;
+}
+
+std::shared_ptr<const BundleInfo> BundleContainer::getInfo() {
+  if (!m_info) {
+    m_info = std::make_shared<const BundleInfo>(*m_bundle);
+  }
+  return m_info;
+}
+
+uint32_t BundleContainer::getForwards() const {
+  return m_forwards;
+}
+
+void BundleContainer::addForwards(uint32_t forwards) {
+  m_forwards += forwards;
+}
+
+const std::vector<std::string>& BundleContainer::getNextHops() const {
+  return m_nextHops;
+}
+
+void BundleContainer::setNextHops(const std::vector<std::string> &nextHops) {
+  m_nextHops = nextHops;
+}
+
 nlohmann::json& BundleContainer::getState() {
+  m_savedPath.clear();
   return m_state;
 }
 
 void BundleContainer::setState(nlohmann::json state) {
+  m_savedPath.clear();
   m_state = state;
 }
 
 void BundleContainer::setFrom(const std::string& from) {
+  m_savedPath.clear();
   m_state["from"] = from;
 }
 
+const std::string& BundleContainer::getSavedPath() const {
+  return m_savedPath;
+}
+
+void BundleContainer::setSavedPath(const std::string &path) {
+  m_savedPath = path;
+}
+
 std::string BundleContainer::serialize() {
   std::stringstream ss;
-  ss << m_header << m_state << " " << m_bundle->toRaw() << m_footer;
+  serialize(ss);
   return ss.str();
 }
 
+void BundleContainer::serialize(std::ostream &output) {
+  output << m_header << m_state << " ";
+  for (auto &segment : m_bundle->toRawSegments()) {
+    output.write(segment.data(), segment.length);
+  }
+  output << m_footer;
+}
+
 void BundleContainer::deserialize(const std::string &data) {
   // Check header
   std::stringstream size;
   // Get the header size in chars
   size << m_header;
-  int headerSize = size.str().length();
-  uint16_t header = std::atoi(data.substr(0, size.str().length()).c_str());
+  size_t headerSize = size.str().length();
+  uint16_t header = std::atoi(data.substr(0, headerSize).c_str());
   if (header == m_header) {
-    std::string newData = data.substr(headerSize);
     size.clear();
     size.str(std::string());
-    // Get the state
-    std::stringstream aux(newData);
-    std::string state;
-    aux >> state;
+    // The fields are taken by position, so the raw bundle is only copied once.
+    // Get the state, it ends with a space.
+    size_t stateEnd = data.find_first_of(" \t\n\v\f\r", headerSize);
+    std::string state = data.substr(headerSize, stateEnd - headerSize);
     try {
       m_state = nlohmann::json::parse(state);
     } catch (const std::invalid_argument &e) {
@@ -98,20 +155,24 @@ void BundleContainer::deserialize(const std::string &data) {
       error << "[BundleContainer] Bad state format: " << e.what();
       throw BundleContainerCreationException(error.str());
     }
-    newData = aux.str().substr(state.size() + 1);
     size << m_footer;
-    int footerSize = size.str().length();
-    // The raw bundle is from the start to the size - footer size
-    std::string bundleData = newData.substr(0, newData.length() - (footerSize));
-    std::unique_ptr<Bundle> b;
+    size_t footerSize = size.str().length();
+    size_t bundleStart = headerSize + state.size() + 1;
+    if (bundleStart + footerSize > data.size()) {
+      throw BundleContainerCreationException(
+          "[BundleContainer] Bad bundle raw format");
+    }
+    // The raw bundle is from the state to the size - footer size
+    std::string bundleData = data.substr(
+        bundleStart, data.size() - footerSize - bundleStart);
     try {
-      m_bundle = std::unique_ptr<Bundle>(new Bundle(bundleData));
+      m_bundle = std::unique_ptr<Bundle>(new Bundle(std::move(bundleData)));
+      m_info.reset();
     } catch (const std::exception &e) {
       throw BundleContainerCreationException(
           "[BundleContainer] Bad bundle raw format");
     }
-    uint16_t footer = std::atoi(
-        newData.substr(newData.length() - (footerSize)).c_str());
+    uint16_t footer = std::atoi(data.substr(data.size() - footerSize).c_str());
     if (footer != m_footer) {
       throw BundleContainerCreationException(
           "[BundleContainer] Bad footer in bundle container");
@@ -24,11 +24,15 @@
 #ifndef BUNDLEAGENT_NODE_BUNDLEQUEUE_BUNDLECONTAINER_H_
 #define BUNDLEAGENT_NODE_BUNDLEQUEUE_BUNDLECONTAINER_H_
 
+#include <cstdint>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 #include "ExternTools/json/json.hpp"
 
 class Bundle;
+class BundleInfo;
 
 class BundleContainerCreationException : public std::runtime_error {
  public:
@@ -71,12 +75,65 @@ class BundleContainer {
   /**
    * Get the held bundle.
    *
+   * The bundle can be changed through the returned reference, so the cached
+   * information of the bundle and its saved file are dropped.
+   *
    * @return The held bundle.
    */
   Bundle& getBundle();
+  /**
+   * Get the held bundle to read it.
+   *
+   * Unlike getBundle() the cached information of the bundle is kept, as the
+   * bundle can not be changed through the returned reference.
+   *
+   * @return The held bundle.
+   */
+  const Bundle& readBundle() const;
+  /**
+   * @brief Get the information of the held bundle.
+   *
+   * The information is generated the first time it is requested and cached
+   * until the bundle is accessed with getBundle(), so the queue can check
+   * the bundles without generating their raw format again.
+   *
+   * @return The information of the held bundle.
+   */
+  std::shared_ptr<const BundleInfo> getInfo();
+  /**
+   * @brief Get the number of times that the bundle has been forwarded.
+   *
+   * The count is only kept while the node is running, it is not serialized.
+   *
+   * @return The number of neighbours the bundle has been sent to.
+   */
+  uint32_t getForwards() const;
+  /**
+   * @brief Adds forwards to the count of the bundle.
+   *
+   * @param forwards The number of neighbours the bundle has been sent to.
+   */
+  void addForwards(uint32_t forwards);
+  /**
+   * @brief Get the nodes the bundle was last forwarded to.
+   *
+   * They are only kept while the node is running, they are not serialized.
+   *
+   * @return The ids of the nodes.
+   */
+  const std::vector<std::string>& getNextHops() const;
+  /**
+   * @brief Sets the nodes the bundle is forwarded to.
+   *
+   * @param nextHops The ids of the nodes.
+   */
+  void setNextHops(const std::vector<std::string> &nextHops);
   /**
    * Get the state of the Container.
    *
+   * The state can be changed through the returned reference, so the saved
+   * file of the container is dropped.
+   *
    * @return The state of the container.
    */
   nlohmann::json& getState();
@@ -92,12 +149,34 @@ class BundleContainer {
    * @param from the from value.
    */
   void setFrom(const std::string& from);
+  /**
+   * @brief Get the file that holds the container as it is.
+   *
+   * @return The path of the file, empty if the container has not been saved
+   *         or it may have changed since.
+   */
+  const std::string& getSavedPath() const;
+  /**
+   * @brief Sets the file that holds the container as it is.
+   *
+   * @param path The path of the file.
+   */
+  void setSavedPath(const std::string &path);
   /**
    * Convert the BundleContainer into a string to save it to disk.
    *
    * @return The serialized form of the BundleContainer.
    */
   virtual std::string serialize();
+  /**
+   * Writes the serialized BundleContainer into a stream.
+   *
+   * The bundle is written from the buffers that hold its blocks, so a
+   * payload that lives into a mapped file is not loaded into memory.
+   *
+   * @param output The stream to write to.
+   */
+  virtual void serialize(std::ostream &output);
   /**
    * Generates a BunldeContainer from a serialized one.
    *
@@ -121,6 +200,22 @@ class BundleContainer {
    * Variable that contains the state of the BundleContainer.
    */
   nlohmann::json m_state;
+  /**
+   * The cached information of the bundle, nullptr if it must be generated.
+   */
+  std::shared_ptr<const BundleInfo> m_info;
+  /**
+   * Number of times that the bundle has been forwarded.
+   */
+  uint32_t m_forwards;
+  /**
+   * The nodes the bundle was last forwarded to.
+   */
+  std::vector<std::string> m_nextHops;
+  /**
+   * The file that holds the container as it is, empty if unknown.
+   */
+  std::string m_savedPath;
   /**
    * Header to check serialization integrity and version.
    * 0x1vff, where v is the version.
@@ -23,75 +23,641 @@
  */
 
 #include "Node/BundleQueue/BundleQueue.h"
+#include <cstdio>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <chrono>
 #include <string>
+#include <thread>
 #include <deque>
 #include <numeric>
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <utility>
 #include "Node/BundleQueue/BundleContainer.h"
 #include "Bundle/Bundle.h"
 #include "Bundle/BundleInfo.h"
+#include "Utils/Logger.h"
 
 BundleQueue::BundleQueue(const std::string &trashPath,
                          const std::string &dropPath,
-                         const uint64_t &queueByteSize)
+                         const uint64_t &queueByteSize, bool priority,
+                         size_t ingestCapacity)
     : m_bundles(),
+      m_priority(priority),
+      m_sequence(0),
+      m_round(0),
+      m_lastDequeuedId(),
+      m_dropPolicy(DropPolicy::OLDEST),
+      m_dropIndex(),
+      m_endpointIndex(),
+      m_scheduled(),
+      m_expirations(),
+      m_ingest(ingestCapacity),
       m_count(0),
+      m_waiting(false),
+      m_size(0),
       m_trashPath(trashPath),
       m_dropPath(dropPath),
       m_queueMaxByteSize(queueByteSize),
       m_queueByteSize(0),
-      m_lastBundleId("") {
+      m_lastBundleId(),
+      m_pagePath(),
+      m_memoryMaxByteSize(0),
+      m_memoryByteSize(0),
+      m_resident(),
+      m_loader() {
 }
 
 BundleQueue::~BundleQueue() {
+  IngestEntry entry;
+  while (m_ingest.pop(entry)) {
+    delete entry.bundleContainer;
+  }
   m_bundles.clear();
 }
 
 BundleQueue::BundleQueue(BundleQueue&& bc)
     : m_bundles(std::move(bc.m_bundles)),
-      m_count(bc.m_count),
+      m_priority(bc.m_priority),
+      m_sequence(bc.m_sequence),
+      m_round(bc.m_round),
+      m_lastDequeuedId(bc.m_lastDequeuedId),
+      m_dropPolicy(bc.m_dropPolicy),
+      m_dropIndex(std::move(bc.m_dropIndex)),
+      m_endpointIndex(std::move(bc.m_endpointIndex)),
+      m_scheduled(std::move(bc.m_scheduled)),
+      m_expirations(std::move(bc.m_expirations)),
+      m_ingest(bc.m_ingest.getCapacity()),
+      m_bundleIds(std::move(bc.m_bundleIds)),
+      m_count(bc.m_count.load()),
+      m_waiting(false),
+      m_size(bc.m_size.load()),
       m_trashPath(bc.m_trashPath),
       m_dropPath(bc.m_dropPath),
       m_queueMaxByteSize(bc.m_queueMaxByteSize),
-      m_queueByteSize(bc.m_queueByteSize),
-      m_lastBundleId(bc.m_lastBundleId) {
+      m_queueByteSize(bc.m_queueByteSize.load()),
+      m_lastBundleId(bc.m_lastBundleId),
+      m_pagePath(bc.m_pagePath),
+      m_memoryMaxByteSize(bc.m_memoryMaxByteSize),
+      m_memoryByteSize(bc.m_memoryByteSize),
+      m_resident(std::move(bc.m_resident)),
+      m_loader(std::move(bc.m_loader)) {
+  IngestEntry entry;
+  while (bc.m_ingest.pop(entry)) {
+    m_ingest.push(entry);
+  }
 }
 
 void BundleQueue::wait_for(int time) {
+  if (consume()) {
+    return;
+  }
   std::unique_lock<std::mutex> lck(m_mutex);
-  while (m_count == 0) {
-    while (m_conditionVariable.wait_for(lck, std::chrono::seconds(time))
-        == std::cv_status::timeout) {
-      throw EmptyBundleQueueException("[BundleQueue] The queue is empty");
-    }
+  // The producers only take the mutex to notify when the consumer waits.
+  m_waiting = true;
+  bool notified = m_conditionVariable.wait_for(
+      lck, std::chrono::seconds(time), [this]() {
+        return consume();
+      });
+  m_waiting = false;
+  if (!notified) {
+    throw EmptyBundleQueueException("[BundleQueue] The queue is empty");
+  }
+}
+
+bool BundleQueue::consume() {
+  int count = m_count.load();
+  while (count > 0 && !m_count.compare_exchange_weak(count, count - 1)) {
+  }
+  return count > 0;
+}
+
+void BundleQueue::notify() {
+  ++m_count;
+  if (m_waiting) {
+    std::unique_lock<std::mutex> lck(m_mutex);
+    m_conditionVariable.notify_one();
   }
-  --m_count;
 }
 
 std::unique_ptr<BundleContainer> BundleQueue::dequeue() {
-  if (m_bundles.size() > 0) {
-    std::unique_lock<std::mutex> lock(m_insertMutex);
-    std::unique_ptr<BundleContainer> bc = std::move(m_bundles.front());
-    m_bundleIds.erase(bc->getBundle().getId());
-    m_bundles.pop_front();
-    m_lastBundleId = bc->getBundle().getId();
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  drain();
+  // A posted bundle can be behind one that is still being written, let its
+  // producer finish without holding the lock.
+  while (m_bundles.empty() && m_size > 0) {
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+    drain();
+  }
+  while (m_bundles.size() > 0) {
+    QueueEntry entry = take(m_bundles.begin());
+    // A paged out bundle is loaded without the lock.
+    lock.unlock();
+    std::unique_ptr<BundleContainer> bc = pageIn(entry);
+    if (bc) {
+      return bc;
+    }
+    lock.lock();
+    lose(entry);
+    // The lost bundle will not be dequeued.
+    consume();
+  }
+  lock.unlock();
+  throw EmptyBundleQueueException("[BundleQueue] The queue is empty");
+}
+
+BundleQueue::QueueEntry BundleQueue::take(BundleMap::iterator position) {
+  m_round = position->first.round;
+  m_lastBundleId = position->second.info->getKey();
+  m_lastDequeuedId = m_lastBundleId;
+  return erase(position);
+}
+
+void BundleQueue::lose(const QueueEntry &entry) {
+  LOG(3) << "[BundleQueue] Removing lost bundle "
+         << entry.info->getKey().toString();
+  if (m_lastBundleId == entry.info->getKey()) {
+    m_lastBundleId = BundleKey();
+  }
+  if (m_lastDequeuedId == entry.info->getKey()) {
+    m_lastDequeuedId = BundleKey();
+  }
+}
+
+uint32_t BundleQueue::schedule(const std::vector<std::string> &endpoints) {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  drain();
+  size_t scheduled = m_scheduled.size();
+  for (auto &endpoint : endpoints) {
+    auto it = m_endpointIndex.find(endpoint);
+    if (it != m_endpointIndex.end()) {
+      m_scheduled.insert(it->second.begin(), it->second.end());
+    }
+  }
+  uint32_t added = m_scheduled.size() - scheduled;
+  if (m_memoryMaxByteSize == 0) {
+    return added;
+  }
+  // The contact will take its bundles soon, load the ones that fit. They are
+  // read without the lock, and kept if they are still in the queue.
+  std::vector<std::pair<QueueKey, std::shared_ptr<const BundleInfo>>> pages;
+  uint64_t memoryByteSize = m_memoryByteSize;
+  for (auto &key : m_scheduled) {
+    auto it = m_bundles.find(key);
+    if (!it->second.bundleContainer
+        && memoryByteSize + it->second.info->getSize()
+            <= m_memoryMaxByteSize) {
+      memoryByteSize += it->second.info->getSize();
+      pages.push_back(std::make_pair(key, it->second.info));
+    }
+  }
+  if (pages.empty()) {
+    return added;
+  }
+  lock.unlock();
+  std::vector<std::unique_ptr<BundleContainer>> loaded;
+  loaded.reserve(pages.size());
+  for (auto &page : pages) {
+    loaded.push_back(loadPage(*page.second));
+  }
+  lock.lock();
+  for (size_t i = 0; i < pages.size(); ++i) {
+    auto it = m_bundles.find(pages[i].first);
+    if (!loaded[i] || it == m_bundles.end() || it->second.bundleContainer
+        || m_memoryByteSize + it->second.info->getSize()
+            > m_memoryMaxByteSize) {
+      continue;
+    }
+    QueueEntry &entry = it->second;
+    entry.bundleContainer = std::move(loaded[i]);
+    entry.bundleContainer->addForwards(entry.forwards);
+    entry.bundleContainer->setNextHops(entry.nextHops);
+    std::vector<std::string>().swap(entry.nextHops);
+    m_memoryByteSize += entry.info->getSize();
+    m_resident.insert(it->first);
+  }
+  return added;
+}
+
+std::unique_ptr<BundleContainer> BundleQueue::dequeueScheduled() {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  while (!m_scheduled.empty()) {
+    QueueEntry entry = take(m_bundles.find(*m_scheduled.begin()));
+    // The bundle is not dequeued after a wait_for().
+    consume();
+    // A paged out bundle is loaded without the lock.
     lock.unlock();
-    m_queueByteSize -= bc->getBundle().getRaw().length();
-    return bc;
+    std::unique_ptr<BundleContainer> bc = pageIn(entry);
+    if (bc) {
+      return bc;
+    }
+    lock.lock();
+    lose(entry);
+  }
+  lock.unlock();
+  throw EmptyBundleQueueException("[BundleQueue] No bundle scheduled");
+}
+
+std::vector<std::unique_ptr<BundleContainer>> BundleQueue::expire(
+    uint64_t now) {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  drain();
+  std::vector<QueueKey> keys;
+  m_expirations.advance(now, keys);
+  std::vector<std::unique_ptr<BundleContainer>> expired;
+  expired.reserve(keys.size());
+  for (auto &key : keys) {
+    QueueEntry entry = erase(m_bundles.find(key), true);
+    if (entry.bundleContainer) {
+      expired.push_back(std::move(entry.bundleContainer));
+    } else {
+      // A paged out bundle is not loaded to be discarded.
+      LOG(55) << "[BundleQueue] Bundle " << entry.info->getId()
+              << " expired, moving it to the trash.";
+      movePage(*entry.info, m_trashPath);
+    }
+  }
+  lock.unlock();
+  // The expired bundles will not be dequeued.
+  for (size_t i = 0; i < keys.size(); ++i) {
+    consume();
+  }
+  return expired;
+}
+
+std::vector<std::string> BundleQueue::getEndpoints(
+    const BundleContainer &bundleContainer, const BundleInfo &info) {
+  std::vector<std::string> endpoints;
+  std::string destination = info.getDestination();
+  endpoints.push_back(destination);
+  std::string node = destination.substr(0, destination.find(":"));
+  if (node != destination) {
+    endpoints.push_back(node);
+  }
+  for (auto &nextHop : bundleContainer.getNextHops()) {
+    if (std::find(endpoints.begin(), endpoints.end(), nextHop)
+        == endpoints.end()) {
+      endpoints.push_back(nextHop);
+    }
+  }
+  return endpoints;
+}
+
+void BundleQueue::post(std::unique_ptr<BundleContainer> bundleContainer,
+                       bool drop) {
+  std::shared_ptr<const BundleInfo> bi = bundleContainer->getInfo();
+  if (bi->getSize() > m_queueMaxByteSize) {
+    saveBundleToDisk(m_dropPath, *bundleContainer, true);
+    throw DroppedBundleQueueException(
+        "[BundleQueue] Bundle larger than queue.");
+  }
+  // The room of the bundle is reserved, so the size of the queue is checked
+  // without ordering it.
+  uint64_t queueByteSize = m_queueByteSize.fetch_add(bi->getSize())
+      + bi->getSize();
+  if (drop && queueByteSize > m_queueMaxByteSize) {
+    m_queueByteSize -= bi->getSize();
+    saveBundleToDisk(m_dropPath, *bundleContainer, true);
+    throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
+  }
+  // The bundle is counted before it can be popped from the ring.
+  ++m_size;
+  if (!m_ingest.push(IngestEntry { bundleContainer.get(), drop })) {
+    --m_size;
+    m_queueByteSize -= bi->getSize();
+    enqueue(std::move(bundleContainer), drop);
+    return;
+  }
+  bundleContainer.release();
+  notify();
+}
+
+void BundleQueue::drain() {
+  IngestEntry entry;
+  while (m_ingest.pop(entry)) {
+    std::unique_ptr<BundleContainer> bc(entry.bundleContainer);
+    std::shared_ptr<const BundleInfo> bi = bc->getInfo();
+    if (m_bundleIds.find(bi->getKey()) != m_bundleIds.end()
+        || bi->getKey() == m_lastBundleId) {
+      LOG(40) << "[BundleQueue] Bundle already in queue";
+      m_queueByteSize -= bi->getSize();
+      --m_size;
+      consume();
+      saveBundleToDisk(m_trashPath, *bc, true);
+      continue;
+    }
+    if (!entry.drop) {
+      // The bundle has its room reserved, drop the first bundles of the
+      // policy index until the queue fits.
+      while (m_queueByteSize > m_queueMaxByteSize && !m_dropIndex.empty()) {
+        dropBundle(m_bundles.find(m_dropIndex.begin()->second));
+      }
+    }
+    m_bundleIds.insert(bi->getKey());
+    insert(std::move(bc), *bi);
+  }
+}
+
+void BundleQueue::insert(std::unique_ptr<BundleContainer> bundleContainer,
+                         const BundleInfo &info) {
+  QueueKey key = { 0, 0, 0, m_sequence++ };
+  if (m_priority) {
+    // The bundle that is back from processing goes to the next pass.
+    key.round = m_round;
+    if (info.getKey() == m_lastDequeuedId) {
+      key.round++;
+      m_lastDequeuedId = BundleKey();
+    }
+    key.rank = 2 - info.getPriority();
+    key.deadline = info.getDeadline();
+  }
+  uint32_t forwards = bundleContainer->getForwards();
+  uint64_t dropKey = getDropKey(info, forwards, key.sequence);
+  std::vector<std::string> endpoints = getEndpoints(*bundleContainer, info);
+  for (auto &endpoint : endpoints) {
+    m_endpointIndex[endpoint].insert(key);
+  }
+  std::shared_ptr<const BundleInfo> bi = bundleContainer->getInfo();
+  m_bundles.emplace(
+      key, QueueEntry { std::move(bundleContainer), bi, forwards, dropKey,
+          std::move(endpoints), m_expirations.add(info.getDeadline(), key),
+          std::vector<std::string>() });
+  m_dropIndex.emplace(dropKey, key);
+  m_memoryByteSize += info.getSize();
+  if (m_memoryMaxByteSize > 0) {
+    m_resident.insert(key);
+    page();
+  }
+}
+
+void BundleQueue::enqueue(std::unique_ptr<BundleContainer> bundleContainer,
+                          bool drop) {
+  std::unique_lock<std::mutex> insertLock(m_insertMutex);
+  drain();
+  std::shared_ptr<const BundleInfo> bi = bundleContainer->getInfo();
+  checkEnqueueable(insertLock, *bundleContainer, *bi, drop);
+  // The bundle can fit in the queue, so drop the first bundles of the policy
+  // index until there is room for it.
+  while (m_queueByteSize + bi->getSize() > m_queueMaxByteSize) {
+    if (m_dropIndex.empty()) {
+      // The room is held by posted bundles that are not ordered yet.
+      insertLock.unlock();
+      saveBundleToDisk(m_dropPath, *bundleContainer, true);
+      throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
+    }
+    dropBundle(m_bundles.find(m_dropIndex.begin()->second));
+  }
+  push(insertLock, std::move(bundleContainer), *bi);
+}
+
+void BundleQueue::checkEnqueueable(std::unique_lock<std::mutex> &insertLock,
+                                   BundleContainer &bundleContainer,
+                                   const BundleInfo &info, bool drop) {
+  // Check if the bundle currently exist in the queue
+  if (m_bundleIds.find(info.getKey()) != m_bundleIds.end()
+      || info.getKey() == m_lastBundleId) {
+    insertLock.unlock();
+    saveBundleToDisk(m_trashPath, bundleContainer, true);
+    throw InBundleQueueException("[BundleQueue] Bundle already in queue");
+  }
+  // Check if by size it can be pushed
+  if (m_queueByteSize + info.getSize() <= m_queueMaxByteSize) {
+    return;
+  }
+  // Check if the bundle is biggest than the queue
+  if (info.getSize() > m_queueMaxByteSize) {
+    insertLock.unlock();
+    saveBundleToDisk(m_dropPath, bundleContainer, true);
+    throw DroppedBundleQueueException(
+        "[BundleQueue] Bundle larger than queue.");
+  }
+  if (drop) {
+    // Drop the message and throw an exception.
+    insertLock.unlock();
+    saveBundleToDisk(m_dropPath, bundleContainer, true);
+    throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
+  }
+}
+
+void BundleQueue::push(std::unique_lock<std::mutex> &insertLock,
+                       std::unique_ptr<BundleContainer> bundleContainer,
+                       const BundleInfo &info) {
+  m_queueByteSize += info.getSize();
+  m_bundleIds.insert(info.getKey());
+  insert(std::move(bundleContainer), info);
+  ++m_size;
+  insertLock.unlock();
+  notify();
+}
+
+BundleQueue::QueueEntry BundleQueue::erase(BundleMap::iterator position,
+                                           bool expired) {
+  QueueKey key = position->first;
+  QueueEntry entry = std::move(position->second);
+  m_bundles.erase(position);
+  const BundleInfo &info = *entry.info;
+  if (entry.bundleContainer) {
+    m_memoryByteSize -= info.getSize();
+    m_resident.erase(key);
+  }
+  m_dropIndex.erase(std::make_pair(entry.dropKey, key));
+  for (auto &endpoint : entry.endpoints) {
+    auto it = m_endpointIndex.find(endpoint);
+    it->second.erase(key);
+    if (it->second.empty()) {
+      m_endpointIndex.erase(it);
+    }
+  }
+  m_scheduled.erase(key);
+  if (!expired) {
+    m_expirations.remove(entry.expiration);
+  }
+  m_bundleIds.erase(info.getKey());
+  m_queueByteSize -= info.getSize();
+  --m_size;
+  return entry;
+}
+
+void BundleQueue::dropBundle(BundleMap::iterator position) {
+  QueueEntry entry = erase(position);
+  if (entry.bundleContainer) {
+    saveBundleToDisk(m_dropPath, *entry.bundleContainer, true);
   } else {
-    throw EmptyBundleQueueException("[BundleQueue] The queue is empty");
+    // A paged out bundle is not loaded to be dropped.
+    movePage(*entry.info, m_dropPath);
+  }
+  // The dropped bundle will not be dequeued.
+  consume();
+}
+
+uint64_t BundleQueue::getDropKey(const BundleInfo &info, uint32_t forwards,
+                                 uint64_t sequence) const {
+  switch (m_dropPolicy) {
+    case DropPolicy::LARGEST:
+      return std::numeric_limits<uint64_t>::max() - info.getSize();
+    case DropPolicy::SHORTEST_LIFETIME:
+      return info.getDeadline();
+    case DropPolicy::MOST_FORWARDED:
+      return std::numeric_limits<uint64_t>::max() - forwards;
+    case DropPolicy::LEAST_RECENTLY_USED:
+      return sequence;
+    case DropPolicy::OLDEST:
+    default:
+      return info.getCreationTimestamp();
+  }
+}
+
+void BundleQueue::setDropPolicy(DropPolicy dropPolicy) {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  m_dropPolicy = dropPolicy;
+  m_dropIndex.clear();
+  for (auto &entry : m_bundles) {
+    entry.second.dropKey = getDropKey(*entry.second.info,
+                                      entry.second.forwards,
+                                      entry.first.sequence);
+    m_dropIndex.emplace(entry.second.dropKey, entry.first);
+  }
+}
+
+DropPolicy BundleQueue::toDropPolicy(const std::string &name) {
+  if (name == "oldest") {
+    return DropPolicy::OLDEST;
+  } else if (name == "largest") {
+    return DropPolicy::LARGEST;
+  } else if (name == "lifetime") {
+    return DropPolicy::SHORTEST_LIFETIME;
+  } else if (name == "forwarded") {
+    return DropPolicy::MOST_FORWARDED;
+  } else if (name == "lru") {
+    return DropPolicy::LEAST_RECENTLY_USED;
+  }
+  throw std::invalid_argument("[BundleQueue] Unknown drop policy " + name);
+}
+
+void BundleQueue::setPaging(const std::string &pagePath,
+                            uint64_t memoryByteSize,
+                            ContainerLoader loader) {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  m_pagePath = pagePath;
+  m_memoryMaxByteSize = memoryByteSize;
+  m_loader = loader;
+  if (!m_loader) {
+    m_loader = [](const std::string &data) {
+      return std::unique_ptr<BundleContainer>(new BundleContainer(data));
+    };
+  }
+  m_resident.clear();
+  if (m_memoryMaxByteSize > 0) {
+    for (auto &entry : m_bundles) {
+      if (entry.second.bundleContainer) {
+        m_resident.insert(entry.first);
+      }
+    }
+    page();
+  }
+}
+
+uint64_t BundleQueue::getMemoryByteSize() {
+  std::unique_lock<std::mutex> lock(m_insertMutex);
+  return m_memoryByteSize;
+}
+
+std::string BundleQueue::getPageFile(const BundleInfo &info) const {
+  return m_pagePath + info.getId() + ".bundle";
+}
+
+bool BundleQueue::pageOut(BundleMap::iterator position) {
+  QueueEntry &entry = position->second;
+  std::string path = getPageFile(*entry.info);
+  // The bundles are usually persisted there when received, so they are only
+  // written if they have changed since.
+  if (entry.bundleContainer->getSavedPath() != path) {
+    // The bundle is written apart and renamed, so the persisted bundle is
+    // never half written.
+    std::string temporary = path + ".page";
+    std::ofstream file(temporary, std::ofstream::out | std::ofstream::binary);
+    entry.bundleContainer->serialize(file);
+    file.close();
+    if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+      LOG(3) << "[BundleQueue] Cannot page out bundle " << path;
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  entry.nextHops = entry.bundleContainer->getNextHops();
+  entry.bundleContainer.reset();
+  m_memoryByteSize -= entry.info->getSize();
+  m_resident.erase(position->first);
+  return true;
+}
+
+std::unique_ptr<BundleContainer> BundleQueue::loadPage(
+    const BundleInfo &info) {
+  std::string path = getPageFile(info);
+  std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+  if (!file) {
+    LOG(3) << "[BundleQueue] Cannot page in bundle " << path;
+    return nullptr;
+  }
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  std::unique_ptr<BundleContainer> bc;
+  try {
+    bc = m_loader(data);
+  } catch (const std::runtime_error &e) {
+    LOG(3) << "[BundleQueue] Cannot page in bundle " << path << ", reason: "
+           << e.what();
+    return nullptr;
+  }
+  // The file is kept, so the bundle is not written again when paged out.
+  bc->setSavedPath(path);
+  return bc;
+}
+
+std::unique_ptr<BundleContainer> BundleQueue::pageIn(QueueEntry &entry) {
+  if (entry.bundleContainer) {
+    return std::move(entry.bundleContainer);
+  }
+  std::unique_ptr<BundleContainer> bc = loadPage(*entry.info);
+  if (bc) {
+    bc->addForwards(entry.forwards);
+    bc->setNextHops(entry.nextHops);
+  }
+  return bc;
+}
+
+void BundleQueue::movePage(const BundleInfo &info, const std::string &path) {
+  std::stringstream ss;
+  auto time = std::chrono::high_resolution_clock::now();
+  ss << path << info.getId() << "_" << time.time_since_epoch().count()
+     << ".bundle";
+  if (std::rename(getPageFile(info).c_str(), ss.str().c_str()) != 0) {
+    LOG(3) << "[BundleQueue] Cannot move paged out bundle "
+           << getPageFile(info) << " to " << ss.str();
+  }
+}
+
+void BundleQueue::page() {
+  while (m_memoryByteSize > m_memoryMaxByteSize && !m_resident.empty()) {
+    if (!pageOut(m_bundles.find(*m_resident.rbegin()))) {
+      break;
+    }
   }
 }
 
 uint32_t BundleQueue::getSize() {
-  return m_bundles.size();
+  return m_size;
 }
 
 void BundleQueue::resetLast() {
-  m_lastBundleId = "";
+  m_lastBundleId = BundleKey();
 }
 
 void BundleQueue::saveBundleToDisk(const std::string &path,
@@ -99,13 +665,17 @@ void BundleQueue::saveBundleToDisk(const std::string &path,
                                    bool timestamp) {
   std::ofstream bundleFile;
   std::stringstream ss;
-  ss << path << bundleContainer.getBundle().getId();
+  ss << path << bundleContainer.readBundle().getId();
   if (timestamp) {
     auto time = std::chrono::high_resolution_clock::now();
     ss << "_" << time.time_since_epoch().count();
   }
   ss << ".bundle";
   bundleFile.open(ss.str(), std::ofstream::out | std::ofstream::binary);
-  bundleFile << bundleContainer.serialize();
+  bundleContainer.serialize(bundleFile);
   bundleFile.close();
+  if (!timestamp && bundleFile) {
+    // The persisted bundle is reused when the queue pages it out.
+    bundleContainer.setSavedPath(ss.str());
+  }
 }
@@ -24,8 +24,12 @@
 #ifndef BUNDLEAGENT_NODE_BUNDLEQUEUE_BUNDLEQUEUE_H_
 #define BUNDLEAGENT_NODE_BUNDLEQUEUE_BUNDLEQUEUE_H_
 
+#include <atomic>
 #include <memory>
 #include <deque>
+#include <map>
+#include <set>
+#include <utility>
 #include <string>
 #include <exception>
 #include <mutex>
@@ -34,10 +38,15 @@
 #include <vector>
 #include <condition_variable>
 #include <chrono>
+#include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <tuple>
 #include "Bundle/BundleInfo.h"
+#include "Bundle/BundleKey.h"
 #include "Node/BundleQueue/BundleContainer.h"
+#include "Utils/MpscRing.h"
+#include "Utils/TimingWheel.h"
 
 class EmptyBundleQueueException : public std::runtime_error {
  public:
@@ -66,18 +75,64 @@ struct compare {
   }
 };
 
+/**
+ * Policies to choose the bundles dropped when the queue is full.
+ */
+enum class DropPolicy : uint8_t {
+  /**
+   * The bundles with the oldest creation timestamp.
+   */
+  OLDEST,
+  /**
+   * The biggest bundles.
+   */
+  LARGEST,
+  /**
+   * The bundles that expire first.
+   */
+  SHORTEST_LIFETIME,
+  /**
+   * The bundles sent to more neighbours.
+   */
+  MOST_FORWARDED,
+  /**
+   * The bundles that have been more time without being processed.
+   */
+  LEAST_RECENTLY_USED
+};
+
 /**
  * CLASS BundleQueue
  * This class implements a queue for the bundle containers.
  */
 class BundleQueue {
  public:
+  /**
+   * Generates a bundle container from a serialized one.
+   */
+  typedef std::function<std::unique_ptr<BundleContainer>(
+      const std::string &data)> ContainerLoader;
   /**
    * Default constructor.
+   *
+   * By default the bundles are dequeued in arrival order. In priority mode
+   * the expedited bundles are dequeued before the normal ones, and these
+   * before the bulk ones, and the bundles of the same class are dequeued in
+   * order of expiration. A bundle that is enqueued again after being
+   * dequeued waits until the rest of the bundles have been dequeued once, so
+   * a bundle that can not be sent does not block the others.
+   *
+   * @param trashPath Path to save the bundles already in the queue.
+   * @param dropPath Path to save the dropped bundles.
+   * @param queueByteSize Max size in bytes of the queue.
+   * @param priority True to use the priority mode.
+   * @param ingestCapacity Number of bundles that can wait to be ordered
+   *                       after being posted.
    */
   explicit BundleQueue(const std::string &trashPath,
                        const std::string &dropPath,
-                       const uint64_t &queueByteSize);
+                       const uint64_t &queueByteSize, bool priority = false,
+                       size_t ingestCapacity = 1024);
   /**
    * Destructor of the class.
    */
@@ -86,13 +141,41 @@ class BundleQueue {
   BundleQueue(BundleQueue&& bc);
   /**
    * Enqueues a bundle container to the queue.
-   * It has a drop policy. By default the old one, but can be changed with the
-   * comp parameter. The policy will drop all the needed elements in order of
-   * small to big (or from first to last) so the comp has to take this in account.
+   * When the queue is full, the bundle is dropped, or the bundles chosen by
+   * the drop policy of the queue are dropped to make room for it. The bundles
+   * are kept indexed by the policy, so choosing and removing each one is
+   * O(log n).
+   *
+   * @param bundleContainer the bundle container to add to the queue.
+   * @param drop True if when full queue drop message, false to apply policy and
+   *             remove messages to fit. (True by default)
+   */
+  void enqueue(std::unique_ptr<BundleContainer> bundleContainer, bool drop =
+                   true);
+  /**
+   * Posts a bundle container to the queue without taking its locks.
+   * The bundle waits into a lock-free ring until it is ordered, by the next
+   * dequeue() or enqueue(), so many receivers can post at the same time.
+   * Only its size is checked when posted. A bundle that is already in the
+   * queue is saved to the trash path when it is ordered. If the ring is full
+   * the bundle is enqueued.
    *
    * @param bundleContainer the bundle container to add to the queue.
    * @param drop True if when full queue drop message, false to apply policy and
    *             remove messages to fit. (True by default)
+   */
+  void post(std::unique_ptr<BundleContainer> bundleContainer, bool drop =
+                true);
+  /**
+   * Enqueues a bundle container to the queue with a custom drop policy.
+   * The policy will drop all the needed elements in order of small to big
+   * (or from first to last) so the comp has to take this in account.
+   * All the queued bundles are sorted with the policy each time that the
+   * queue is full, use the drop policy of the queue when possible.
+   *
+   * @param bundleContainer the bundle container to add to the queue.
+   * @param drop True if when full queue drop message, false to apply policy and
+   *             remove messages to fit.
    * @param comp Binary function that accepts two elements in the range as
    *             arguments, and returns a value convertible to bool.
    *             The value returned indicates whether the element passed as
@@ -104,93 +187,95 @@ class BundleQueue {
    *             priority, it will be dropped. (False by default)
    */
   template<class T = compare>
-  void enqueue(std::unique_ptr<BundleContainer> bundleContainer, bool drop =
-                   true,
-               T comp = T(), bool checkEnqueue = false) {
+  void enqueue(std::unique_ptr<BundleContainer> bundleContainer, bool drop,
+               T comp, bool checkEnqueue = false) {
     std::unique_lock<std::mutex> insertLock(m_insertMutex);
-    BundleInfo bi = BundleInfo(bundleContainer->getBundle());
-    // Check if the bundle currently exist in the queue
-    bool notExist = !(m_bundleIds.find(bi.getId()) != m_bundleIds.end()
-        || bi.getId() == m_lastBundleId);
-    if (notExist) {
-      // Check if by size it can be pushed
-      if (m_queueByteSize + bi.getSize() <= m_queueMaxByteSize) {
-        m_queueByteSize += bi.getSize();
-        m_bundles.push_back(std::move(bundleContainer));
-        m_bundleIds.insert(bi.getId());
-        insertLock.unlock();
-        std::unique_lock<std::mutex> lck(m_mutex);
-        ++m_count;
-        m_conditionVariable.notify_one();
-      } else {
-        // Check if the bundle is biggest than the queue
-        if (bi.getSize() > m_queueMaxByteSize) {
+    drain();
+    std::shared_ptr<const BundleInfo> bi = bundleContainer->getInfo();
+    const BundleKey &key = bi->getKey();
+    checkEnqueueable(insertLock, *bundleContainer, *bi, drop);
+    if (m_queueByteSize + bi->getSize() > m_queueMaxByteSize) {
+      // The bundle can fit in the queue, so order the bundles as the policy.
+      // The cached information of the bundles is used, so no bundle is
+      // converted to raw.
+      std::vector<std::shared_ptr<const BundleInfo>> toOrder;
+      std::vector<BundleMap::iterator> positions;
+      toOrder.reserve(m_bundles.size() + 1);
+      positions.reserve(m_bundles.size());
+      // create an order vector, that will be sort with the policy
+      for (auto it = m_bundles.begin(); it != m_bundles.end(); ++it) {
+        toOrder.push_back(it->second.info);
+        positions.push_back(it);
+      }
+      if (checkEnqueue) {
+        toOrder.push_back(bi);
+      }
+      std::deque<int> order(toOrder.size(), 0);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+                indexGenerator<std::vector<
+                    std::shared_ptr<const BundleInfo>>, T>(toOrder, comp));
+      uint64_t accumulatedSize = m_queueByteSize;
+      std::vector<int> toRemove;
+      // Remove the n elements needed to make space for the new one
+      while (accumulatedSize + bi->getSize() > m_queueMaxByteSize) {
+        if (order.empty()) {
+          // The room is held by posted bundles that are not ordered yet.
           insertLock.unlock();
           saveBundleToDisk(m_dropPath, *bundleContainer, true);
-          throw DroppedBundleQueueException(
-              "[BundleQueue] Bundle larger than queue.");
+          throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
         }
-        if (drop) {
-          // Drop the message and throw an exception.
+        accumulatedSize -= toOrder[order.front()]->getSize();
+        toRemove.push_back(order.front());
+        if (checkEnqueue
+            && toOrder[order.front()]->getKey() == key) {
           insertLock.unlock();
           saveBundleToDisk(m_dropPath, *bundleContainer, true);
           throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
         }
-        // The bundle can fit in the queue, so order the bundles as the policy
-        std::deque<BundleInfo> toOrder;
-        // create an order deque, that will be sort with the policy
-        for (auto &ptr : m_bundles) {
-          toOrder.push_back(BundleInfo(ptr->getBundle()));
-        }
-        if (checkEnqueue) {
-          toOrder.push_back(BundleInfo(bundleContainer->getBundle()));
-        }
-        std::deque<int> order(toOrder.size(), 0);
-        std::iota(order.begin(), order.end(), 0);
-        std::sort(order.begin(), order.end(),
-                  indexGenerator<std::deque<BundleInfo>, T>(toOrder, comp));
-        uint64_t accumulatedSize = m_queueByteSize;
-        std::vector<int> toRemove;
-        // Remove the n elements needed to make space for the new one
-        while ((m_queueMaxByteSize - accumulatedSize) < bi.getSize()) {
-          accumulatedSize -= toOrder[order.front()].getSize();
-          toRemove.push_back(order.front());
-          if (checkEnqueue
-              && toOrder[order.front()].getId()
-                  == bundleContainer->getBundle().getId()) {
-            insertLock.unlock();
-            saveBundleToDisk(m_dropPath, *bundleContainer, true);
-            throw DroppedBundleQueueException("[BundleQueue] Full Queue.");
-          }
-          order.pop_front();
-        }
-        std::sort(toRemove.begin(), toRemove.end(), std::greater<int>());
-        for (auto i : toRemove) {
-          std::string bundleId = m_bundles[i]->getBundle().getId();
-          m_bundleIds.erase(bundleId);
-          saveBundleToDisk(m_dropPath, *m_bundles[i], true);
-          m_bundles.erase(m_bundles.begin() + i);
-        }
-        m_queueByteSize -= bi.getSize();
-        m_bundles.push_back(std::move(bundleContainer));
-        m_bundleIds.insert(bi.getId());
-        insertLock.unlock();
-        std::unique_lock<std::mutex> lck(m_mutex);
-        ++m_count;
-        m_conditionVariable.notify_one();
+        order.pop_front();
+      }
+      for (auto i : toRemove) {
+        dropBundle(positions[i]);
       }
-    } else {
-      insertLock.unlock();
-      saveBundleToDisk(m_trashPath, *bundleContainer, true);
-      throw InBundleQueueException("[BundleQueue] Bundle already in queue");
     }
+    push(insertLock, std::move(bundleContainer), *bi);
   }
   /**
    * Dequeues a bundle container from the queue.
    * The bundle dequeued is removed from the container.
+   * The posted bundles are ordered first.
    * @return The oldest bundle container.
    */
   std::unique_ptr<BundleContainer> dequeue();
+  /**
+   * Schedules the queued bundles that can go to a contact, the ones whose
+   * destination, or the destination node, is one of the given endpoints, and
+   * the ones that were last forwarded to one of them.
+   * The bundles are found with an index, so the rest of the queue is not
+   * checked.
+   *
+   * @param endpoints The id and the endpoints of the contact.
+   * @return The number of bundles scheduled.
+   */
+  uint32_t schedule(const std::vector<std::string> &endpoints);
+  /**
+   * Dequeues the first scheduled bundle container.
+   * If there is no scheduled bundle, a exception is thrown.
+   * @return The scheduled bundle container.
+   */
+  std::unique_ptr<BundleContainer> dequeueScheduled();
+  /**
+   * Removes the queued bundles that have expired, the ones whose creation
+   * timestamp plus lifetime is before the given time.
+   * The bundles are kept into a timing wheel by their expiration, so only
+   * the expired bundles are checked, and each one is removed in O(1)
+   * amortized time.
+   *
+   * @param now The current time, in seconds from the year 2000.
+   * @return The expired bundle containers.
+   */
+  std::vector<std::unique_ptr<BundleContainer>> expire(uint64_t now);
   /**
    * Waits for a enqueue notification.
    * If no notification is given in time, a exception is thrown.
@@ -198,10 +283,47 @@ class BundleQueue {
    */
   void wait_for(int time);
   /**
-   * Returns the number of bundles in the queue.
+   * Returns the number of bundles in the queue, including the posted ones.
    * @return The size of the queue.
    */
   uint32_t getSize();
+  /**
+   * Sets the policy used to choose the bundles dropped when the queue is
+   * full. By default the oldest bundles are dropped.
+   *
+   * @param dropPolicy The policy.
+   */
+  void setDropPolicy(DropPolicy dropPolicy);
+  /**
+   * Converts the name of a policy, as written in the configuration.
+   * Throws std::invalid_argument if the name is unknown.
+   *
+   * @param name The name, oldest, largest, lifetime, forwarded or lru.
+   * @return The policy.
+   */
+  static DropPolicy toDropPolicy(const std::string &name);
+  /**
+   * Keeps in memory only the first bundles to dequeue, up to the given size,
+   * and pages out the rest to disk. A paged out bundle only keeps its
+   * information in memory, and it is loaded without the queue lock when it
+   * is dequeued, or before when a contact schedules it and it fits in
+   * memory. When it is dropped or expires its file is moved to the drop or
+   * trash path without loading it.
+   *
+   * @param pagePath Path to save the paged out bundles. It is the data path,
+   *                 so the saved bundle is also the persisted one.
+   * @param memoryByteSize Max size in bytes of the bundles kept in memory,
+   *                       0 to keep all of them.
+   * @param loader Generates the paged out bundle containers, by default they
+   *               are BundleContainer.
+   */
+  void setPaging(const std::string &pagePath, uint64_t memoryByteSize,
+                 ContainerLoader loader = nullptr);
+  /**
+   * Returns the size in bytes of the queued bundles kept in memory.
+   * @return The size in bytes.
+   */
+  uint64_t getMemoryByteSize();
   /**
    * Resets the last bundle dequeued to empty.
    */
@@ -216,29 +338,296 @@ class BundleQueue {
                         bool timestamp = false);
 
  private:
+  /**
+   * Compares the positions of two bundles with the policy. The sort copies
+   * it, so it only holds a reference to the bundle information.
+   */
   template<class T, class F>
   class indexGenerator {
    public:
-    explicit indexGenerator(const T array, const F compare)
+    explicit indexGenerator(const T &array, const F compare)
         : m_array(array),
           m_compare(compare) {
     }
     bool operator()(const size_t a, const size_t b) const {
-      return m_compare(m_array[a], m_array[b]);
+      return m_compare(*m_array[a], *m_array[b]);
     }
    private:
-    const T m_array;
+    const T &m_array;
     const F m_compare;
   };
 
   /**
-   * List that holds the container bundles.
+   * Position of a bundle into the queue, the bundles are dequeued in
+   * ascending order.
    */
-  std::deque<std::unique_ptr<BundleContainer>> m_bundles;
+  struct QueueKey {
+    /**
+     * The pass over the queue where the bundle is dequeued.
+     */
+    uint64_t round;
+    /**
+     * The priority class, 0 for expedited, 1 for normal and 2 for bulk.
+     */
+    uint8_t rank;
+    /**
+     * The time when the bundle expires.
+     */
+    uint64_t deadline;
+    /**
+     * The arrival order.
+     */
+    uint64_t sequence;
+
+    bool operator<(const QueueKey &other) const {
+      return std::tie(round, rank, deadline, sequence)
+          < std::tie(other.round, other.rank, other.deadline, other.sequence);
+    }
+  };
+  /**
+   * A queued bundle.
+   */
+  struct QueueEntry {
+    /**
+     * The bundle container, nullptr while it is paged out.
+     */
+    std::unique_ptr<BundleContainer> bundleContainer;
+    /**
+     * The information of the bundle.
+     */
+    std::shared_ptr<const BundleInfo> info;
+    /**
+     * The number of times that the bundle has been forwarded.
+     */
+    uint32_t forwards;
+    /**
+     * The position of the bundle into the drop policy index.
+     */
+    uint64_t dropKey;
+    /**
+     * The keys of the bundle into the endpoint index.
+     */
+    std::vector<std::string> endpoints;
+    /**
+     * The position of the bundle into the expiration wheel.
+     */
+    TimingWheel<QueueKey>::Handle expiration;
+    /**
+     * The nodes the bundle was last forwarded to, while it is paged out.
+     */
+    std::vector<std::string> nextHops;
+  };
+  typedef std::map<QueueKey, QueueEntry> BundleMap;
+  /**
+   * A posted bundle.
+   */
+  struct IngestEntry {
+    /**
+     * The bundle container, owned by the ring.
+     */
+    BundleContainer *bundleContainer;
+    /**
+     * True if the bundle is dropped when the queue is full.
+     */
+    bool drop;
+  };
+  /**
+   * Orders the posted bundles.
+   * The insert mutex must be held, so only one thread reads the ring.
+   */
+  void drain();
+  /**
+   * Notifies that a bundle can be consumed.
+   */
+  void notify();
+  /**
+   * Removes a notification.
+   *
+   * @return False if there was no notification.
+   */
+  bool consume();
+  /**
+   * Throws the exception and saves the bundle if it can not be enqueued,
+   * because it is already in the queue, it is bigger than the queue or the
+   * queue is full and it must be dropped.
+   * The insert mutex must be held, it is unlocked when throwing.
+   *
+   * @param insertLock the lock of the insert mutex.
+   * @param bundleContainer the bundle container to enqueue.
+   * @param info the information of the bundle.
+   * @param drop True if the bundle is dropped when the queue is full.
+   */
+  void checkEnqueueable(std::unique_lock<std::mutex> &insertLock,
+                        BundleContainer &bundleContainer,
+                        const BundleInfo &info, bool drop);
+  /**
+   * Adds a bundle container to the queue and notifies it.
+   * The insert mutex must be held, it is unlocked.
+   *
+   * @param insertLock the lock of the insert mutex.
+   * @param bundleContainer the bundle container to add.
+   * @param info the information of the bundle.
+   */
+  void push(std::unique_lock<std::mutex> &insertLock,
+            std::unique_ptr<BundleContainer> bundleContainer,
+            const BundleInfo &info);
+  /**
+   * Inserts a bundle container at its position and into the drop policy
+   * index.
+   * The insert mutex must be held.
+   *
+   * @param bundleContainer the bundle container to insert.
+   * @param info the information of the bundle.
+   */
+  void insert(std::unique_ptr<BundleContainer> bundleContainer,
+              const BundleInfo &info);
+  /**
+   * Removes a bundle from the queue and from its indexes.
+   * The insert mutex must be held. A paged out bundle is not loaded.
+   *
+   * @param position The position of the bundle.
+   * @param expired True if the bundle has already left the expiration wheel.
+   * @return The removed entry, its container is nullptr if it is paged out.
+   */
+  QueueEntry erase(BundleMap::iterator position, bool expired = false);
+  /**
+   * Removes a bundle from the queue to be processed.
+   * The insert mutex must be held. A paged out bundle is not loaded.
+   *
+   * @param position The position of the bundle.
+   * @return The removed entry, its container is nullptr if it is paged out.
+   */
+  QueueEntry take(BundleMap::iterator position);
+  /**
+   * Forgets a bundle taken from the queue that can not be loaded.
+   * The insert mutex must be held.
+   *
+   * @param entry The removed entry.
+   */
+  void lose(const QueueEntry &entry);
+  /**
+   * Returns the keys of a bundle into the endpoint index, its destination,
+   * the node of its destination and the nodes it was last forwarded to.
+   *
+   * @param bundleContainer the bundle container.
+   * @param info the information of the bundle.
+   * @return The keys.
+   */
+  static std::vector<std::string> getEndpoints(
+      const BundleContainer &bundleContainer, const BundleInfo &info);
+  /**
+   * Removes a bundle from the queue and saves it into the drop path.
+   * The insert mutex must be held.
+   *
+   * @param position The position of the bundle.
+   */
+  void dropBundle(BundleMap::iterator position);
+  /**
+   * Returns the position of a bundle into the drop policy index, the bundles
+   * are dropped in ascending order.
+   *
+   * @param info the information of the bundle.
+   * @param forwards the forwards of the bundle.
+   * @param sequence the arrival order of the bundle.
+   * @return The position.
+   */
+  uint64_t getDropKey(const BundleInfo &info, uint32_t forwards,
+                      uint64_t sequence) const;
+  /**
+   * Returns the file of a bundle into the page path.
+   *
+   * @param info the information of the bundle.
+   * @return The path of the file.
+   */
+  std::string getPageFile(const BundleInfo &info) const;
+  /**
+   * Saves a bundle to the page path and releases its container.
+   * The file is not written again if the container is already saved there.
+   * The insert mutex must be held.
+   *
+   * @param position The position of the bundle.
+   * @return False if the bundle can not be saved, it is kept in memory then.
+   */
+  bool pageOut(BundleMap::iterator position);
+  /**
+   * Loads a paged out bundle from the page path.
+   * It reads the disk, so the insert mutex must not be held.
+   *
+   * @param info the information of the bundle.
+   * @return The bundle container, nullptr if it can not be loaded.
+   */
+  std::unique_ptr<BundleContainer> loadPage(const BundleInfo &info);
+  /**
+   * Gets the container of an entry removed from the queue, it is loaded if
+   * the bundle is paged out.
+   * It reads the disk, so the insert mutex must not be held.
+   *
+   * @param entry The removed entry.
+   * @return The bundle container, nullptr if it can not be loaded.
+   */
+  std::unique_ptr<BundleContainer> pageIn(QueueEntry &entry);
+  /**
+   * Moves the file of a paged out bundle from the page path to another path,
+   * like saveBundleToDisk() with a timestamp, without loading it.
+   *
+   * @param info the information of the bundle.
+   * @param path the path to move the bundle to.
+   */
+  void movePage(const BundleInfo &info, const std::string &path);
+  /**
+   * Pages out the last bundles to dequeue until the bundles in memory fit.
+   * The insert mutex must be held.
+   */
+  void page();
+  /**
+   * Map that holds the container bundles, in dequeue order.
+   */
+  BundleMap m_bundles;
+  /**
+   * True to order the bundles by priority and expiration.
+   */
+  bool m_priority;
+  /**
+   * Number of bundles inserted, it gives the arrival order.
+   */
+  uint64_t m_sequence;
+  /**
+   * The pass over the queue of the last bundle dequeued.
+   */
+  uint64_t m_round;
+  /**
+   * The key of the last bundle dequeued, even after resetLast(), to know
+   * when it is enqueued again.
+   */
+  BundleKey m_lastDequeuedId;
+  /**
+   * The policy to choose the dropped bundles.
+   */
+  DropPolicy m_dropPolicy;
+  /**
+   * The bundles ordered by the drop policy.
+   */
+  std::set<std::pair<uint64_t, QueueKey>> m_dropIndex;
+  /**
+   * The bundles that can go to each endpoint.
+   */
+  std::unordered_map<std::string, std::set<QueueKey>> m_endpointIndex;
+  /**
+   * The bundles scheduled by a contact, in dequeue order.
+   */
+  std::set<QueueKey> m_scheduled;
+  /**
+   * The bundles by expiration time.
+   */
+  TimingWheel<QueueKey> m_expirations;
+  /**
+   * The posted bundles.
+   */
+  MpscRing<IngestEntry> m_ingest;
   /**
    * Map to check if a id already exists in the queue.
    */
-  std::unordered_set<std::string> m_bundleIds;
+  std::unordered_set<BundleKey> m_bundleIds;
   /**
    * Mutex for the condition variable.
    */
@@ -254,7 +643,15 @@ class BundleQueue {
   /**
    * Count of elements to consume.
    */
-  int m_count;
+  std::atomic<int> m_count;
+  /**
+   * True while the consumer waits on the condition variable.
+   */
+  std::atomic<bool> m_waiting;
+  /**
+   * Number of bundles in the queue, including the posted ones.
+   */
+  std::atomic<uint32_t> m_size;
   /**
    * Path to save trashed bundles.
    */
@@ -268,13 +665,33 @@ class BundleQueue {
    */
   uint64_t m_queueMaxByteSize;
   /**
-   * Current size in bytes of the queue.
+   * Current size in bytes of the queue, including the posted bundles.
+   */
+  std::atomic<uint64_t> m_queueByteSize;
+  /**
+   * The key of the last bundle dequeued.
+   */
+  BundleKey m_lastBundleId;
+  /**
+   * Path to save the paged out bundles.
+   */
+  std::string m_pagePath;
+  /**
+   * Max size in bytes of the bundles in memory, 0 to keep all of them.
+   */
+  uint64_t m_memoryMaxByteSize;
+  /**
+   * Current size in bytes of the bundles in memory.
+   */
+  uint64_t m_memoryByteSize;
+  /**
+   * The bundles in memory in dequeue order, only kept when paging.
    */
-  uint64_t m_queueByteSize;
+  std::set<QueueKey> m_resident;
   /**
-   * The id of the last bundle dequeued.
+   * Generates the paged out bundle containers.
    */
-  std::string m_lastBundleId;
+  ContainerLoader m_loader;
 };
 
 #endif  // BUNDLEAGENT_NODE_BUNDLEQUEUE_BUNDLEQUEUE_H_
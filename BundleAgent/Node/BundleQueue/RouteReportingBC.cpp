@@ -30,6 +30,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <exception>
+#include <utility>
 
 #include "RouteReportingBC.h"
 #include "Node/BundleQueue/BundleContainer.h"
@@ -64,12 +65,13 @@ time_t RouteReportingBC::getDepartureTime() {
   return m_departureTime;
 }
 
-std::string RouteReportingBC::serialize() {
-  std::stringstream ss;
-  ss << m_header << m_state << std::endl << m_bundle->toRaw() << std::endl
-     << std::to_string(m_arrivalTime) << std::endl
-     << std::to_string(m_departureTime) << m_footer;
-  return ss.str();
+void RouteReportingBC::serialize(std::ostream &output) {
+  output << m_header << m_state << std::endl;
+  for (auto &segment : m_bundle->toRawSegments()) {
+    output.write(segment.data(), segment.length);
+  }
+  output << std::endl << std::to_string(m_arrivalTime) << std::endl
+         << std::to_string(m_departureTime) << m_footer;
 }
 
 void RouteReportingBC::deserialize(const std::string &data) {
@@ -96,29 +98,34 @@ void RouteReportingBC::deserialize(const std::string &data) {
       throw BundleContainerCreationException(error.str());
     }
     newData = aux.str().substr(state.size() + 1);
-    size_t position = newData.find("\n");
     size << m_footer;
-    int footerSize = size.str().length();
-    // The raw bundle is from the start to the size - footer size
-    // std::string bundleData = newData.substr(
-    // 0, newData.length() - (footerSize));
+    size_t footerSize = size.str().length();
+    // The times are after the last two new lines, the raw bundle before them
+    // can also hold new lines.
+    size_t departure = newData.rfind("\n");
+    size_t position = std::string::npos;
+    if (departure != std::string::npos && departure > 0) {
+      position = newData.rfind("\n", departure - 1);
+    }
+    if (position == std::string::npos
+        || departure + 1 + footerSize > newData.length()) {
+      throw BundleContainerCreationException(
+          "[BundleContainer] Bad bundle raw format");
+    }
     std::string bundleData = newData.substr(0, position);
-    std::unique_ptr<Bundle> b;
     try {
-      m_bundle = std::unique_ptr<Bundle>(new Bundle(bundleData));
+      m_bundle = std::unique_ptr<Bundle>(new Bundle(std::move(bundleData)));
+      m_info.reset();
     } catch (const std::exception &e) {
       throw BundleContainerCreationException(
           "[BundleContainer] Bad bundle raw format");
     }
     m_nodeId = "";
-    // int pos = newData.find("\n");
-    std::string subData = newData.substr(position + 1, data.size());
-    position = subData.find("\n");
-    std::string arrivalTime = subData.substr(0, position);
+    std::string arrivalTime = newData.substr(position + 1,
+                                             departure - position - 1);
     m_arrivalTime = atoi(arrivalTime.c_str());
-    subData = subData.substr(position + 1, subData.size());
-    std::string departureTime = subData.substr(0,
-                                               subData.size() - (footerSize));
+    std::string departureTime = newData.substr(
+        departure + 1, newData.length() - footerSize - departure - 1);
     m_departureTime = atoi(departureTime.c_str());
     uint16_t footer = std::atoi(
         newData.substr(newData.length() - (footerSize)).c_str());
@@ -142,6 +149,7 @@ std::string RouteReportingBC::toString() {
 }
 
 void RouteReportingBC::setDepartureTime(time_t departureTime) {
+  m_savedPath.clear();
   m_departureTime = departureTime;
 }
 
@@ -88,11 +88,12 @@ class RouteReportingBC : public BundleContainer {
    */
   time_t getDepartureTime();
   /**
-   * Convert a bundle into string to save it to disk.
+   * Writes the serialized RouteReportingBC into a stream.
    *
-   * @return The serialized of the RouteReportingBC.
+   * @param output The stream to write to.
    */
-  virtual std::string serialize();
+  virtual void serialize(std::ostream &output);
+  using BundleContainer::serialize;
   /**
    * Generates a RouteReportingBC from a serialized one.
    *
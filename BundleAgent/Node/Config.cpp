@@ -27,6 +27,23 @@
 #include <sstream>
 #include "Utils/ConfigLoader.h"
 
+/**
+ * Converts a size in bytes, K M and G can be used to express KB, MB and GB.
+ */
+static uint64_t toByteSize(const std::string &value) {
+  std::stringstream ss(value);
+  uint64_t size = 0;
+  char exponent = 0;
+  ss >> size >> exponent;
+  if (exponent == 'K' || exponent == 'k')
+    size *= 1024;
+  else if (exponent == 'M' || exponent == 'm')
+    size = size * 1024 * 1024;
+  else if (exponent == 'G' || exponent == 'g')
+    size = size * 1024 * 1024 * 1024;
+  return size;
+}
+
 /**
  * Default values definition.
  */
@@ -56,9 +73,31 @@ const std::string Config::TRASHDELIVERYPATH =
 const std::string Config::TRASHRECEPTIONPATH =
     "/tmp/adtn/trash/aggregation/reception";
 const std::string Config::TRASHDROPPATH = "/tmp/adtn/trash/drop";
+const std::string Config::SEENFILTERPATH = "/tmp/adtn/SeenBundles.filter";
 const std::string Config::QUEUEBYTESIZE = "100M";
 const uint64_t Config::QUEUEBYTESIZEVALUE = 100 * 1024 * 1024;
+const std::string Config::QUEUEMEMORYSIZE = "0";
+const bool Config::PRIORITYQUEUE = false;
+const std::string Config::DROPPOLICY = "";
+const bool Config::CONTACTSCHEDULING = false;
+const bool Config::PROACTIVEEXPIRY = false;
 const int Config::PROCESSTIMEOUT = 20;
+const int Config::BUNDLEARENASIZE = 0;
+const uint64_t Config::SEENWINDOW = 0;
+const uint64_t Config::SEENCAPACITY = 100000;
+const uint64_t Config::PAYLOADFILETHRESHOLD = 0;
+const uint64_t Config::FRAGMENTSIZE = 0;
+const uint64_t Config::COMPRESSIONTHRESHOLD = 0;
+const int Config::COMPRESSIONLEVEL = 6;
+const bool Config::BLOCKCHECKSUMS = false;
+const std::string Config::BUNDLEENCODING = "rfc5050";
+
+/**
+ * Converts a configured encoding, any value but "bpv7" is RFC 5050.
+ */
+static BundleEncoding toBundleEncoding(const std::string &encoding) {
+  return encoding == "bpv7" ? BundleEncoding::BPV7 : BundleEncoding::RFC5050;
+}
 
 Config::Config()
     : m_nodeId(NODEID),
@@ -84,8 +123,23 @@ Config::Config()
       m_trashDeliveryPath(TRASHDELIVERYPATH),
       m_trashReceptionPath(TRASHRECEPTIONPATH),
       m_trashDropPath(TRASHDROPPATH),
+      m_seenFilterPath(SEENFILTERPATH),
       m_queueByteSize(QUEUEBYTESIZEVALUE),
-      m_processTimeout(PROCESSTIMEOUT) {
+      m_queueMemorySize(0),
+      m_priorityQueue(PRIORITYQUEUE),
+      m_dropPolicy(DROPPOLICY),
+      m_contactScheduling(CONTACTSCHEDULING),
+      m_proactiveExpiry(PROACTIVEEXPIRY),
+      m_processTimeout(PROCESSTIMEOUT),
+      m_bundleArenaSize(BUNDLEARENASIZE),
+      m_seenWindow(SEENWINDOW),
+      m_seenCapacity(SEENCAPACITY),
+      m_payloadFileThreshold(PAYLOADFILETHRESHOLD),
+      m_fragmentSize(FRAGMENTSIZE),
+      m_compressionThreshold(COMPRESSIONTHRESHOLD),
+      m_compressionLevel(COMPRESSIONLEVEL),
+      m_blockChecksums(BLOCKCHECKSUMS),
+      m_bundleEncoding(BUNDLEENCODING) {
 }
 
 Config::Config(const std::string &configFilename) {
@@ -143,21 +197,51 @@ Config::Config(const std::string &configFilename) {
         "BundleProcess", "trashAggregationReception", TRASHRECEPTIONPATH);
     m_trashDropPath = m_configLoader.m_reader.Get("BundleProcess", "trashDropp",
                                                   TRASHDROPPATH);
+    m_seenFilterPath = m_configLoader.m_reader.Get("BundleProcess",
+                                                   "seenFilterPath",
+                                                   SEENFILTERPATH);
     std::string queueByteSize = m_configLoader.m_reader.Get("Constants",
                                                             "queueByteSize",
                                                             QUEUEBYTESIZE);
-    std::stringstream ss(queueByteSize);
-    char exponent;
-    ss >> m_queueByteSize >> exponent;
-    if (exponent == 'K' || exponent == 'k')
-      m_queueByteSize *= 1024;
-    else if (exponent == 'M' || exponent == 'm')
-      m_queueByteSize = m_queueByteSize * 1024 * 1024;
-    else if (exponent == 'G' || exponent == 'g')
-      m_queueByteSize = m_queueByteSize * 1024 * 1024 * 1024;
+    m_queueByteSize = toByteSize(queueByteSize);
+    m_queueMemorySize = toByteSize(m_configLoader.m_reader.Get(
+        "Constants", "queueMemorySize", QUEUEMEMORYSIZE));
+    m_priorityQueue = m_configLoader.m_reader.GetBoolean("Constants",
+                                                         "priorityQueue",
+                                                         PRIORITYQUEUE);
+    m_dropPolicy = m_configLoader.m_reader.Get("Constants", "dropPolicy",
+                                               DROPPOLICY);
+    m_contactScheduling = m_configLoader.m_reader.GetBoolean(
+        "Constants", "contactScheduling", CONTACTSCHEDULING);
+    m_proactiveExpiry = m_configLoader.m_reader.GetBoolean(
+        "Constants", "proactiveExpiry", PROACTIVEEXPIRY);
     m_processTimeout = m_configLoader.m_reader.GetInteger("Constants",
                                                    "processTimeout",
                                                    PROCESSTIMEOUT);
+    m_bundleArenaSize = m_configLoader.m_reader.GetInteger("Constants",
+                                                    "bundleArenaSize",
+                                                    BUNDLEARENASIZE);
+    m_seenWindow = m_configLoader.m_reader.GetInteger("Constants",
+                                                      "seenWindow",
+                                                      SEENWINDOW);
+    m_seenCapacity = m_configLoader.m_reader.GetInteger("Constants",
+                                                        "seenCapacity",
+                                                        SEENCAPACITY);
+    m_payloadFileThreshold = m_configLoader.m_reader.GetInteger(
+        "Constants", "payloadFileThreshold", PAYLOADFILETHRESHOLD);
+    m_fragmentSize = m_configLoader.m_reader.GetInteger("Constants",
+                                                        "fragmentSize",
+                                                        FRAGMENTSIZE);
+    m_compressionThreshold = m_configLoader.m_reader.GetInteger(
+        "Constants", "compressionThreshold", COMPRESSIONTHRESHOLD);
+    m_compressionLevel = m_configLoader.m_reader.GetInteger(
+        "Constants", "compressionLevel", COMPRESSIONLEVEL);
+    m_blockChecksums = m_configLoader.m_reader.GetBoolean("Constants",
+                                                          "blockChecksums",
+                                                          BLOCKCHECKSUMS);
+    m_bundleEncoding = m_configLoader.m_reader.Get("Constants",
+                                                   "bundleEncoding",
+                                                   BUNDLEENCODING);
   }
 }
 
@@ -256,10 +340,72 @@ std::string Config::getTrashDrop() {
   return m_trashDropPath;
 }
 
+std::string Config::getSeenFilterPath() {
+  return m_seenFilterPath;
+}
+
 uint64_t Config::getQueueByteSize() {
   return m_queueByteSize;
 }
 
+uint64_t Config::getQueueMemorySize() {
+  return m_queueMemorySize;
+}
+
+bool Config::getPriorityQueue() {
+  return m_priorityQueue;
+}
+
+std::string Config::getDropPolicy() {
+  return m_dropPolicy;
+}
+
+bool Config::getContactScheduling() {
+  return m_contactScheduling;
+}
+
+bool Config::getProactiveExpiry() {
+  return m_proactiveExpiry;
+}
+
 int Config::getProcessTimeout() {
   return m_processTimeout;
 }
+
+int Config::getBundleArenaSize() {
+  return m_bundleArenaSize;
+}
+
+uint64_t Config::getSeenWindow() {
+  return m_seenWindow;
+}
+
+uint64_t Config::getSeenCapacity() {
+  return m_seenCapacity;
+}
+
+uint64_t Config::getPayloadFileThreshold() {
+  return m_payloadFileThreshold;
+}
+
+uint64_t Config::getFragmentSize() {
+  return m_fragmentSize;
+}
+
+uint64_t Config::getCompressionThreshold() {
+  return m_compressionThreshold;
+}
+
+int Config::getCompressionLevel() {
+  return m_compressionLevel;
+}
+
+bool Config::getBlockChecksums() {
+  return m_blockChecksums;
+}
+
+BundleEncoding Config::getBundleEncoding(const std::string &neighbour) {
+  return toBundleEncoding(m_configLoader.m_reader.Get("BundleEncodings",
+                                                      neighbour,
+                                                      m_bundleEncoding));
+}
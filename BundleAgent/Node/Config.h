@@ -26,6 +26,7 @@
 
 #include <cstdint>
 #include <string>
+#include "Bundle/BundleTypes.h"
 #include "Utils/ConfigLoader.h"
 
 /**
@@ -193,18 +194,115 @@ class Config {
    * @return The path to save the bundles.
    */
   std::string getTrashDrop();
+  /**
+   * Get the path to save the filter of the seen bundles.
+   *
+   * @return The path of the file, empty to not save it.
+   */
+  std::string getSeenFilterPath();
   /**
    * Get the size of the queue in bytes.
    *
    * @return The size of the queue in bytes.
    */
   uint64_t getQueueByteSize();
+  /**
+   * Get the size in bytes of the queued bundles kept in memory.
+   *
+   * @return The size in bytes, 0 to keep all the queued bundles in memory.
+   */
+  uint64_t getQueueMemorySize();
+  /**
+   * Get if the queue orders the bundles by priority and expiration.
+   *
+   * @return True if the bundles are ordered, false to keep arrival order.
+   */
+  bool getPriorityQueue();
+  /**
+   * Get the policy to drop the queued bundles when the queue is full.
+   *
+   * @return The name of the policy, empty to drop the received bundle.
+   */
+  std::string getDropPolicy();
+  /**
+   * Get if a new neighbour only wakes the bundles that can go to it.
+   *
+   * @return True to process only the bundles indexed by the neighbour, false
+   * to process all the queue.
+   */
+  bool getContactScheduling();
+  /**
+   * Get if the bundles are removed from the queue as soon as they expire.
+   *
+   * @return True to remove the expired bundles from the queue, and to reject
+   * the expired bundles received.
+   */
+  bool getProactiveExpiry();
   /**
    * Get the process timeout.
    *
    * @return The process timeout.
    */
   int getProcessTimeout();
+  /**
+   * Get the size of the first chunk of the bundle arenas.
+   *
+   * @return The size in bytes, 0 if the arenas are disabled.
+   */
+  int getBundleArenaSize();
+  /**
+   * Get the time that the received bundles are remembered, to reject them
+   * when they are received again.
+   *
+   * @return The time in seconds, 0 if the bundles are not remembered.
+   */
+  uint64_t getSeenWindow();
+  /**
+   * Get the number of bundles remembered in a window.
+   *
+   * @return The number of bundles.
+   */
+  uint64_t getSeenCapacity();
+  /**
+   * Get the size above which the received bundles are stored into a file.
+   *
+   * @return The size in bytes, 0 if the bundles are always kept in memory.
+   */
+  uint64_t getPayloadFileThreshold();
+  /**
+   * Get the size above which the bundles to other nodes are fragmented.
+   *
+   * @return The size in bytes, 0 if the bundles are never fragmented.
+   */
+  uint64_t getFragmentSize();
+  /**
+   * Get the payload size above which the bundles created in this node are
+   * compressed.
+   *
+   * @return The size in bytes, 0 if the bundles are never compressed.
+   */
+  uint64_t getCompressionThreshold();
+  /**
+   * Get the level used to compress the payloads.
+   *
+   * @return The level, from 1 (fastest) to 9 (smallest).
+   */
+  int getCompressionLevel();
+  /**
+   * Get if the blocks of the bundles carry their checksums.
+   *
+   * @return True if the checksums are added and checked.
+   */
+  bool getBlockChecksums();
+  /**
+   * Get the encoding of the bundles sent to a neighbour.
+   *
+   * The encoding of the node is used if the neighbour has not its own one.
+   *
+   * @param neighbour The node id of the neighbour.
+   * @return The bundle encoding.
+   */
+  BundleEncoding getBundleEncoding(const std::string &neighbour);
 
  private:
   /**
@@ -299,14 +397,75 @@ class Config {
    * The path to save the trashed bundles when dropped in enqueue.
    */
   std::string m_trashDropPath;
+  /**
+   * The path to save the filter of the seen bundles.
+   */
+  std::string m_seenFilterPath;
   /**
    * The size of the queue in bytes.
    */
   uint64_t m_queueByteSize;
+  /**
+   * The size in bytes of the queued bundles kept in memory.
+   */
+  uint64_t m_queueMemorySize;
+  /**
+   * True if the queue orders the bundles by priority and expiration.
+   */
+  bool m_priorityQueue;
+  /**
+   * The policy to drop the queued bundles when the queue is full.
+   */
+  std::string m_dropPolicy;
+  /**
+   * True if a new neighbour only wakes the bundles that can go to it.
+   */
+  bool m_contactScheduling;
+  /**
+   * True if the bundles are removed from the queue as soon as they expire.
+   */
+  bool m_proactiveExpiry;
   /**
    * The timeout for processing bundles if static scenario.
    */
   int m_processTimeout;
+  /**
+   * The size of the first chunk of the bundle arenas, 0 to disable them.
+   */
+  int m_bundleArenaSize;
+  /**
+   * The time in seconds that the received bundles are remembered.
+   */
+  uint64_t m_seenWindow;
+  /**
+   * The number of bundles remembered in a window.
+   */
+  uint64_t m_seenCapacity;
+  /**
+   * The bundle size above which the payload lives into a file, 0 to disable.
+   */
+  uint64_t m_payloadFileThreshold;
+  /**
+   * The maximum size of a bundle to another node, 0 to disable fragmentation.
+   */
+  uint64_t m_fragmentSize;
+  /**
+   * The payload size above which the created bundles are compressed, 0 to
+   * disable compression.
+   */
+  uint64_t m_compressionThreshold;
+  /**
+   * The compression level.
+   */
+  int m_compressionLevel;
+  /**
+   * True if the block checksums are added and checked.
+   */
+  bool m_blockChecksums;
+  /**
+   * The encoding of the bundles sent by this node, "rfc5050" or "bpv7".
+   */
+  std::string m_bundleEncoding;
   /**
    * Variable that holds the Config Loader.
    */
@@ -337,9 +496,24 @@ class Config {
   static const std::string TRASHDELIVERYPATH;
   static const std::string TRASHRECEPTIONPATH;
   static const std::string TRASHDROPPATH;
+  static const std::string SEENFILTERPATH;
   static const std::string QUEUEBYTESIZE;
   static const uint64_t QUEUEBYTESIZEVALUE;
+  static const std::string QUEUEMEMORYSIZE;
+  static const bool PRIORITYQUEUE;
+  static const std::string DROPPOLICY;
+  static const bool CONTACTSCHEDULING;
+  static const bool PROACTIVEEXPIRY;
   static const int PROCESSTIMEOUT;
+  static const int BUNDLEARENASIZE;
+  static const uint64_t SEENWINDOW;
+  static const uint64_t SEENCAPACITY;
+  static const uint64_t PAYLOADFILETHRESHOLD;
+  static const uint64_t FRAGMENTSIZE;
+  static const uint64_t COMPRESSIONTHRESHOLD;
+  static const int COMPRESSIONLEVEL;
+  static const bool BLOCKCHECKSUMS;
+  static const std::string BUNDLEENCODING;
 };
 
 #endif  // BUNDLEAGENT_NODE_CONFIG_H_
@@ -83,10 +83,10 @@ Socket Endpoint::getSocket() {
   return m_socket;
 }
 
-bool Endpoint::checkDeliveredId(const std::string &id) {
+bool Endpoint::checkDeliveredId(const BundleKey &id) {
   return (m_deliveredIds.find(id) != m_deliveredIds.end());
 }
 
-void Endpoint::addDeliveredId(const std::string &id) {
+void Endpoint::addDeliveredId(const BundleKey &id) {
   m_deliveredIds.insert(id);
 }
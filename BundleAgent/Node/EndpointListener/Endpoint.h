@@ -29,6 +29,7 @@
 #include <chrono>
 #include <memory>
 #include <unordered_set>
+#include "Bundle/BundleKey.h"
 #include "Utils/Socket.h"
 
 /**
@@ -91,9 +92,9 @@ class Endpoint {
    */
   bool operator==(const Endpoint &endpoint) const;
 
-  bool checkDeliveredId(const std::string &id);
+  bool checkDeliveredId(const BundleKey &id);
 
-  void addDeliveredId(const std::string &id);
+  void addDeliveredId(const BundleKey &id);
 
  private:
   /**
@@ -115,7 +116,7 @@ class Endpoint {
   /**
    * Set of delivered bundle id, to calculate aggregation.
    */
-  std::unordered_set<std::string> m_deliveredIds;
+  std::unordered_set<BundleKey> m_deliveredIds;
   /**
    * Time of the last activity of the endpoint.
    */
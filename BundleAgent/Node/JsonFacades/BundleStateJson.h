@@ -97,9 +97,10 @@ class BundleStateJson : public Json {
    */
   static const std::vector<std::string> m_bundleLifetime;
   /**
-   * Variable that holds the bundle used when asked any of the given paths.
+   * Variable that holds the bundle used when asked any of the given paths,
+   * it must outlive this object.
    */
-  Bundle m_bundle;
+  Bundle &m_bundle;
 };
 
 #endif  // BUNDLEAGENT_NODE_JSONFACADES_BUNDLESTATEJSON_H_
@@ -63,8 +63,9 @@ void NeighbourTable::update(std::shared_ptr<Neighbour> neighbour) {
   } else {
     m_neigbours[neighbour->getId()] = neighbour;
     insert(neighbour->getEndpoints(), neighbour->getId());
-    // Notify Processor that a new neighbour has appeared, so it can process
-    g_queueProcessEvents++;
+    // Notify Processor that a new neighbour has appeared, so it can process,
+    // the new neighbours are counted apart from the queue events.
+    m_appeared.push_back(neighbour->getId());
     std::unique_lock<std::mutex> lck(g_processorMutex);
     g_processorConditionVariable.notify_one();
     PERF(NEIGH_APPEAR) << neighbour->getId();
@@ -140,6 +141,14 @@ void NeighbourTable::clean(int expirationTime) {
   m_mutex.unlock();
 }
 
+std::vector<std::string> NeighbourTable::takeAppeared() {
+  std::vector<std::string> appeared;
+  m_mutex.lock();
+  appeared.swap(m_appeared);
+  m_mutex.unlock();
+  return appeared;
+}
+
 void NeighbourTable::insert(std::vector<std::string> endpoints,
                             std::string neighbour) {
   for (auto endpoint : endpoints) {
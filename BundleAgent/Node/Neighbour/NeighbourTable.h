@@ -101,6 +101,12 @@ class NeighbourTable {
    * @param expirationTime Minimum time to expire a neighbour.
    */
   void clean(int expirationTime);
+  /**
+   * @brief Returns the neighbours that have appeared since the last call.
+   *
+   * @return The ids of the new neighbours.
+   */
+  std::vector<std::string> takeAppeared();
 
  private:
   /**
@@ -136,6 +142,10 @@ class NeighbourTable {
    * Map that holds the neighbours.
    */
   std::unordered_map<std::string, std::shared_ptr<Neighbour>> m_neigbours;
+  /**
+   * The neighbours that have appeared since takeAppeared() was called.
+   */
+  std::vector<std::string> m_appeared;
 };
 
 #endif  // BUNDLEAGENT_NODE_NEIGHBOUR_NEIGHBOURTABLE_H_
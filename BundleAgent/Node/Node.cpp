@@ -30,6 +30,7 @@
 #include <fstream>
 #include <memory>
 #include <algorithm>
+#include <stdexcept>
 #include <thread>
 #include "Node/Node.h"
 #include "Node/Neighbour/NeighbourTable.h"
@@ -61,7 +62,17 @@ Node::Node(std::string filename) {
   LOG(6) << "Starting BundleQueue";
   m_bundleQueue = std::shared_ptr<BundleQueue>(
       new BundleQueue(m_config.getTrashReception(), m_config.getTrashDrop(),
-                      m_config.getQueueByteSize()));
+                      m_config.getQueueByteSize(),
+                      m_config.getPriorityQueue()));
+  if (!m_config.getDropPolicy().empty()) {
+    try {
+      m_bundleQueue->setDropPolicy(
+          BundleQueue::toDropPolicy(m_config.getDropPolicy()));
+    } catch (const std::invalid_argument &e) {
+      LOG(1) << "Bad drop policy \"" << m_config.getDropPolicy()
+             << "\", using the default one, reason: " << e.what();
+    }
+  }
   LOG(6) << "Starting EndpointListener";
   m_appListener = std::shared_ptr<EndpointListener>(
       new EndpointListener(m_config, m_listeningAppsTable));
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE Arena.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the Arena class.
+ */
+
+#include "Utils/Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+const size_t Arena::DEFAULT_CHUNK_SIZE;
+const size_t Arena::MAX_CHUNK_SIZE;
+
+Arena::Arena(size_t chunkSize)
+    : m_head(nullptr),
+      m_position(nullptr),
+      m_end(nullptr),
+      m_nextChunkSize(std::max<size_t>(chunkSize, 64)),
+      m_allocatedBytes(0),
+      m_reservedBytes(0) {
+}
+
+Arena::~Arena() {
+  while (m_head != nullptr) {
+    Chunk *next = m_head->next;
+    ::operator delete(m_head);
+    m_head = next;
+  }
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+  uintptr_t position = reinterpret_cast<uintptr_t>(m_position);
+  uintptr_t aligned = (position + alignment - 1) & ~(alignment - 1);
+  if (m_position == nullptr
+      || aligned + size > reinterpret_cast<uintptr_t>(m_end)) {
+    size_t needed = sizeof(Chunk) + size + alignment;
+    size_t chunkSize = std::max(m_nextChunkSize, needed);
+    Chunk *chunk = static_cast<Chunk*>(::operator new(chunkSize));
+    chunk->next = m_head;
+    chunk->size = chunkSize;
+    m_head = chunk;
+    m_position = reinterpret_cast<char*>(chunk + 1);
+    m_end = reinterpret_cast<char*>(chunk) + chunkSize;
+    m_reservedBytes += chunkSize;
+    m_nextChunkSize = std::min(m_nextChunkSize * 2, MAX_CHUNK_SIZE);
+    position = reinterpret_cast<uintptr_t>(m_position);
+    aligned = (position + alignment - 1) & ~(alignment - 1);
+  }
+  m_position = reinterpret_cast<char*>(aligned + size);
+  m_allocatedBytes += size;
+  return reinterpret_cast<void*>(aligned);
+}
+
+size_t Arena::getAllocatedBytes() const {
+  return m_allocatedBytes;
+}
+
+size_t Arena::getReservedBytes() const {
+  return m_reservedBytes;
+}
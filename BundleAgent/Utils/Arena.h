@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE Arena.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the Arena class and its allocator.
+ */
+#ifndef BUNDLEAGENT_UTILS_ARENA_H_
+#define BUNDLEAGENT_UTILS_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * CLASS Arena
+ * This class is a monotonic memory region.
+ *
+ * Memory is carved from chunks that are only released, all at once, when the
+ * arena is destroyed. Deallocations are ignored. The arena is not thread safe.
+ */
+class Arena {
+ public:
+  /**
+   * @brief Constructor.
+   *
+   * No memory is reserved until the first allocation.
+   *
+   * @param chunkSize The size of the first chunk, the next ones double it.
+   */
+  explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+  /**
+   * Destructor of the class, releases all the chunks.
+   */
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  /**
+   * @brief Allocates memory from the arena.
+   *
+   * @param size The number of bytes.
+   * @param alignment The alignment of the memory, must be a power of two.
+   * @return A pointer to the memory.
+   */
+  void* allocate(size_t size, size_t alignment);
+  /**
+   * @brief Returns the number of bytes allocated from the arena.
+   *
+   * @return The allocated bytes.
+   */
+  size_t getAllocatedBytes() const;
+  /**
+   * @brief Returns the number of bytes reserved by the chunks.
+   *
+   * @return The reserved bytes.
+   */
+  size_t getReservedBytes() const;
+  /**
+   * Default size of the first chunk.
+   */
+  static const size_t DEFAULT_CHUNK_SIZE = 4096;
+
+ private:
+  /**
+   * Header of each chunk, the memory follows it.
+   */
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+  /**
+   * Maximum size of a chunk, bigger allocations get their own chunk.
+   */
+  static const size_t MAX_CHUNK_SIZE = 64 * 1024;
+  /**
+   * Last reserved chunk.
+   */
+  Chunk *m_head;
+  /**
+   * Next free byte of the last chunk.
+   */
+  char *m_position;
+  /**
+   * End of the last chunk.
+   */
+  char *m_end;
+  /**
+   * Size of the next chunk.
+   */
+  size_t m_nextChunkSize;
+  /**
+   * Bytes allocated from the arena.
+   */
+  size_t m_allocatedBytes;
+  /**
+   * Bytes reserved by the chunks.
+   */
+  size_t m_reservedBytes;
+};
+
+/**
+ * CLASS ArenaAllocator
+ * Standard allocator that takes its memory from an Arena.
+ *
+ * The allocator shares the ownership of the arena, so anything allocated with
+ * it keeps the arena alive.
+ */
+template<class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(const std::shared_ptr<Arena> &arena)
+      : m_arena(arena) {
+  }
+
+  template<class U>
+  ArenaAllocator(const ArenaAllocator<U> &other)  // NOLINT
+      : m_arena(other.getArena()) {
+  }
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) {
+  }
+
+  const std::shared_ptr<Arena>& getArena() const {
+    return m_arena;
+  }
+
+  template<class U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return m_arena == other.getArena();
+  }
+
+  template<class U>
+  bool operator!=(const ArenaAllocator<U> &other) const {
+    return m_arena != other.getArena();
+  }
+
+ private:
+  std::shared_ptr<Arena> m_arena;
+};
+
+/**
+ * @brief Generates a shared object, from the arena if there is one.
+ *
+ * @param arena The arena, or nullptr to use the heap.
+ * @param args The arguments of the constructor.
+ * @return The shared object.
+ */
+template<class T, class ... Args>
+std::shared_ptr<T> makeShared(const std::shared_ptr<Arena> &arena,
+                              Args&&... args) {
+  if (arena) {
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                   std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+#endif  // BUNDLEAGENT_UTILS_ARENA_H_
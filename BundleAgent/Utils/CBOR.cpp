@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CBOR.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the CBOR functions.
+ */
+
+#include "Utils/CBOR.h"
+#include <stdexcept>
+#include <string>
+
+size_t CBOR::encodeHead(uint8_t majorType, uint64_t value, uint8_t *data) {
+  uint8_t type = static_cast<uint8_t>(majorType << 5);
+  if (value < 24) {
+    data[0] = type | static_cast<uint8_t>(value);
+    return 1;
+  }
+  size_t length = getHeadLength(value) - 1;
+  // The additional information 24, 25, 26 and 27 are followed by 1, 2, 4 and
+  // 8 bytes in network order.
+  static const uint8_t additionalInfo[] = { 0, 24, 25, 0, 26, 0, 0, 0, 27 };
+  data[0] = type | additionalInfo[length];
+  for (size_t i = length; i > 0; --i) {
+    data[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+  return length + 1;
+}
+
+void CBOR::appendHead(std::string &buffer, uint8_t majorType, uint64_t value) {
+  uint8_t head[MAX_HEAD_LENGTH];
+  size_t length = encodeHead(majorType, value, head);
+  buffer.append(reinterpret_cast<const char*>(head), length);
+}
+
+size_t CBOR::getHeadLength(uint64_t value) {
+  if (value < 24) {
+    return 1;
+  } else if (value <= 0xFF) {
+    return 2;
+  } else if (value <= 0xFFFF) {
+    return 3;
+  } else if (value <= 0xFFFFFFFF) {
+    return 5;
+  }
+  return 9;
+}
+
+size_t CBOR::decodeHead(const uint8_t *data, const uint8_t *end,
+                        uint8_t &majorType, uint64_t &value) {
+  if (data >= end) {
+    throw std::out_of_range("[CBOR] Item out of the buffer");
+  }
+  majorType = data[0] >> 5;
+  uint8_t additionalInfo = data[0] & 0x1F;
+  if (additionalInfo < 24) {
+    value = additionalInfo;
+    return 1;
+  }
+  if (additionalInfo > 27) {
+    throw std::invalid_argument("[CBOR] Indefinite or reserved length");
+  }
+  size_t length = static_cast<size_t>(1) << (additionalInfo - 24);
+  if (static_cast<size_t>(end - data) <= length) {
+    throw std::out_of_range("[CBOR] Item out of the buffer");
+  }
+  value = 0;
+  for (size_t i = 1; i <= length; ++i) {
+    value = (value << 8) | data[i];
+  }
+  return length + 1;
+}
+
+uint64_t CBOR::decodeHead(const uint8_t *&data, const uint8_t *end,
+                          uint8_t majorType) {
+  uint8_t type;
+  uint64_t value;
+  data += decodeHead(data, end, type, value);
+  if (type != majorType) {
+    throw std::invalid_argument("[CBOR] Unexpected item type");
+  }
+  return value;
+}
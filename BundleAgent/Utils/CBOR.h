@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CBOR.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the functions to work with the CBOR items used by the
+ * bundles, as defined into the RFC 8949.
+ */
+#ifndef BUNDLEAGENT_UTILS_CBOR_H_
+#define BUNDLEAGENT_UTILS_CBOR_H_
+
+#include <cstdint>
+#include <string>
+
+namespace CBOR {
+  /**
+   * Major types of the items.
+   */
+  const uint8_t UNSIGNED_INTEGER = 0;
+  const uint8_t BYTE_STRING = 2;
+  const uint8_t TEXT_STRING = 3;
+  const uint8_t ARRAY = 4;
+  /**
+   * Initial byte of an indefinite length array.
+   */
+  const uint8_t INDEFINITE_ARRAY = 0x9F;
+  /**
+   * Byte that ends an indefinite length item.
+   */
+  const uint8_t BREAK = 0xFF;
+  /**
+   * Maximum number of bytes of the head of an item.
+   */
+  const size_t MAX_HEAD_LENGTH = 9;
+  /**
+   * Encodes the head of an item, using the shortest form of the value.
+   * The buffer must have room for MAX_HEAD_LENGTH bytes.
+   *
+   * @param majorType The major type of the item.
+   * @param value The value, or the length of strings and arrays.
+   * @param data Pointer to the first byte to write.
+   * @return The number of bytes written.
+   */
+  size_t encodeHead(uint8_t majorType, uint64_t value, uint8_t *data);
+  /**
+   * Appends the head of an item to a buffer.
+   *
+   * @param buffer The buffer to append to.
+   * @param majorType The major type of the item.
+   * @param value The value, or the length of strings and arrays.
+   */
+  void appendHead(std::string &buffer, uint8_t majorType, uint64_t value);
+  /**
+   * Returns the number of bytes of the head of an item.
+   *
+   * @param value The value, or the length of strings and arrays.
+   * @return The length of the head.
+   */
+  size_t getHeadLength(uint64_t value);
+  /**
+   * Decodes the head of an item that starts at data.
+   * Throws std::out_of_range if the head does not end before end, and
+   * std::invalid_argument if it has an indefinite length or a reserved value.
+   *
+   * @param data Pointer to the first byte of the item.
+   * @param end Pointer past the last readable byte.
+   * @param majorType The decoded major type.
+   * @param value The decoded value.
+   * @return The number of bytes read.
+   */
+  size_t decodeHead(const uint8_t *data, const uint8_t *end,
+                    uint8_t &majorType, uint64_t &value);
+  /**
+   * Decodes the head of an item of the given major type and moves data to the
+   * first byte after it.
+   * Throws like decodeHead, and std::invalid_argument if the item is of
+   * another type.
+   *
+   * @param data Pointer to the first byte of the item, moved after its head.
+   * @param end Pointer past the last readable byte.
+   * @param majorType The expected major type.
+   * @return The decoded value.
+   */
+  uint64_t decodeHead(const uint8_t *&data, const uint8_t *end,
+                      uint8_t majorType);
+}
+
+#endif  // BUNDLEAGENT_UTILS_CBOR_H_
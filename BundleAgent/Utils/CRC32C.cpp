@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CRC32C.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the CRC32C functions.
+ */
+
+#include "Utils/CRC32C.h"
+#include <cstring>
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace CRC32C {
+
+/**
+ * Reversed Castagnoli polynomial.
+ */
+static const uint32_t POLYNOMIAL = 0x82F63B78;
+
+/**
+ * Lookup tables to process 8 bytes at once.
+ */
+struct Tables {
+  Tables() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+      }
+      values[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+      for (int t = 1; t < 8; ++t) {
+        values[t][i] = (values[t - 1][i] >> 8)
+            ^ values[0][values[t - 1][i] & 0xFF];
+      }
+    }
+  }
+  uint32_t values[8][256];
+};
+
+static const Tables& getTables() {
+  static const Tables tables;
+  return tables;
+}
+
+uint32_t extendPortable(uint32_t crc, const char *data, size_t length) {
+  const Tables &tables = getTables();
+  const uint8_t *p = reinterpret_cast<const uint8_t*>(data);
+  uint32_t c = ~crc;
+  while (length >= 8) {
+    uint32_t low, high;
+    std::memcpy(&low, p, 4);
+    std::memcpy(&high, p + 4, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    low = __builtin_bswap32(low);
+    high = __builtin_bswap32(high);
+#endif
+    low ^= c;
+    c = tables.values[7][low & 0xFF] ^ tables.values[6][(low >> 8) & 0xFF]
+        ^ tables.values[5][(low >> 16) & 0xFF] ^ tables.values[4][low >> 24]
+        ^ tables.values[3][high & 0xFF] ^ tables.values[2][(high >> 8) & 0xFF]
+        ^ tables.values[1][(high >> 16) & 0xFF] ^ tables.values[0][high >> 24];
+    p += 8;
+    length -= 8;
+  }
+  while (length-- > 0) {
+    c = (c >> 8) ^ tables.values[0][(c ^ *p++) & 0xFF];
+  }
+  return ~c;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("sse4.2")))
+static uint32_t extendHardware(uint32_t crc, const char *data, size_t length) {
+  const uint8_t *p = reinterpret_cast<const uint8_t*>(data);
+  uint64_t c = ~crc;
+  while (length >= 8) {
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    c = _mm_crc32_u64(c, value);
+    p += 8;
+    length -= 8;
+  }
+  uint32_t c32 = static_cast<uint32_t>(c);
+  while (length-- > 0) {
+    c32 = _mm_crc32_u8(c32, *p++);
+  }
+  return ~c32;
+}
+
+static bool hasHardware() {
+  return __builtin_cpu_supports("sse4.2");
+}
+
+#elif defined(__aarch64__)
+
+__attribute__((target("+crc")))
+static uint32_t extendHardware(uint32_t crc, const char *data, size_t length) {
+  const uint8_t *p = reinterpret_cast<const uint8_t*>(data);
+  uint32_t c = ~crc;
+  while (length >= 8) {
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    c = __crc32cd(c, value);
+    p += 8;
+    length -= 8;
+  }
+  while (length-- > 0) {
+    c = __crc32cb(c, *p++);
+  }
+  return ~c;
+}
+
+static bool hasHardware() {
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+#else
+
+static uint32_t extendHardware(uint32_t crc, const char *data, size_t length) {
+  return extendPortable(crc, data, length);
+}
+
+static bool hasHardware() {
+  return false;
+}
+
+#endif
+
+typedef uint32_t (*ExtendFunction)(uint32_t, const char*, size_t);
+
+/**
+ * Selects the implementation the first time it is needed.
+ */
+static ExtendFunction getExtendFunction() {
+  static const ExtendFunction function =
+      hasHardware() ? &extendHardware : &extendPortable;
+  return function;
+}
+
+uint32_t extend(uint32_t crc, const char *data, size_t length) {
+  return getExtendFunction()(crc, data, length);
+}
+
+uint32_t compute(const char *data, size_t length) {
+  return extend(0, data, length);
+}
+
+bool isHardwareAccelerated() {
+  return getExtendFunction() != &extendPortable;
+}
+
+}  // namespace CRC32C
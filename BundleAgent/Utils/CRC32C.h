@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CRC32C.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the CRC32C (Castagnoli) functions.
+ */
+#ifndef BUNDLEAGENT_UTILS_CRC32C_H_
+#define BUNDLEAGENT_UTILS_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CRC32C {
+  /**
+   * Extends the CRC of some data with the data that follows it, so the CRC
+   * can be computed while the data arrives. The CRC of the empty data is 0.
+   *
+   * The SSE4.2 or ARMv8 CRC instructions are used if the processor has them.
+   *
+   * @param crc The CRC of the previous data.
+   * @param data Pointer to the first byte of the data.
+   * @param length The length of the data.
+   * @return The CRC of the previous data followed by the new one.
+   */
+  uint32_t extend(uint32_t crc, const char *data, size_t length);
+  /**
+   * Computes the CRC of the data.
+   *
+   * @param data Pointer to the first byte of the data.
+   * @param length The length of the data.
+   * @return The CRC of the data.
+   */
+  uint32_t compute(const char *data, size_t length);
+  /**
+   * Same as extend but always with the lookup tables, used when the processor
+   * has no CRC instructions.
+   */
+  uint32_t extendPortable(uint32_t crc, const char *data, size_t length);
+  /**
+   * Checks if the processor CRC instructions are used.
+   *
+   * @return True if extend uses the processor instructions.
+   */
+  bool isHardwareAccelerated();
+}  // namespace CRC32C
+
+#endif  // BUNDLEAGENT_UTILS_CRC32C_H_
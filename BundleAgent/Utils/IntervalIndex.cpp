@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntervalIndex.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the IntervalIndex class.
+ */
+
+#include "Utils/IntervalIndex.h"
+#include <algorithm>
+#include <map>
+
+IntervalIndex::IntervalIndex()
+    : m_intervals(),
+      m_coveredLength(0) {
+}
+
+IntervalIndex::~IntervalIndex() {
+}
+
+uint64_t IntervalIndex::insert(uint64_t begin, uint64_t end) {
+  if (begin >= end) {
+    return 0;
+  }
+  uint64_t added = end - begin;
+  // First range that may overlap or touch the new one.
+  auto it = m_intervals.upper_bound(begin);
+  if (it != m_intervals.begin() && std::prev(it)->second >= begin) {
+    --it;
+  }
+  // Absorb all the ranges that overlap or touch the new one.
+  while (it != m_intervals.end() && it->first <= end) {
+    uint64_t overlapBegin = std::max(begin, it->first);
+    uint64_t overlapEnd = std::min(end, it->second);
+    if (overlapEnd > overlapBegin) {
+      added -= overlapEnd - overlapBegin;
+    }
+    begin = std::min(begin, it->first);
+    end = std::max(end, it->second);
+    it = m_intervals.erase(it);
+  }
+  m_intervals.emplace_hint(it, begin, end);
+  m_coveredLength += added;
+  return added;
+}
+
+bool IntervalIndex::contains(uint64_t begin, uint64_t end) const {
+  if (begin >= end) {
+    return true;
+  }
+  auto it = m_intervals.upper_bound(begin);
+  if (it == m_intervals.begin()) {
+    return false;
+  }
+  --it;
+  return it->second >= end;
+}
+
+uint64_t IntervalIndex::getCoveredLength() const {
+  return m_coveredLength;
+}
+
+size_t IntervalIndex::getNumberOfIntervals() const {
+  return m_intervals.size();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntervalIndex.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the IntervalIndex class.
+ */
+#ifndef BUNDLEAGENT_UTILS_INTERVALINDEX_H_
+#define BUNDLEAGENT_UTILS_INTERVALINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+/**
+ * CLASS IntervalIndex
+ * This class holds a set of byte ranges.
+ *
+ * The ranges are kept sorted and merged, so inserting a range and checking if
+ * a range is covered take logarithmic time in the number of disjoint ranges.
+ */
+class IntervalIndex {
+ public:
+  /**
+   * Empty constructor.
+   */
+  IntervalIndex();
+  /**
+   * Destructor of the class.
+   */
+  ~IntervalIndex();
+  /**
+   * @brief Adds the range [begin, end).
+   *
+   * The range is merged with the ranges it overlaps or touches.
+   *
+   * @param begin The first position of the range.
+   * @param end The position after the last one of the range.
+   * @return The number of positions that were not covered before.
+   */
+  uint64_t insert(uint64_t begin, uint64_t end);
+  /**
+   * @brief Checks if the range [begin, end) is fully covered.
+   *
+   * @param begin The first position of the range.
+   * @param end The position after the last one of the range.
+   * @return True if all the positions of the range are covered.
+   */
+  bool contains(uint64_t begin, uint64_t end) const;
+  /**
+   * @brief Returns the number of positions covered.
+   *
+   * @return The covered positions.
+   */
+  uint64_t getCoveredLength() const;
+  /**
+   * @brief Returns the number of disjoint ranges.
+   *
+   * @return The number of ranges.
+   */
+  size_t getNumberOfIntervals() const;
+
+ private:
+  /**
+   * Disjoint ranges, the key is the begin and the value the end.
+   */
+  std::map<uint64_t, uint64_t> m_intervals;
+  /**
+   * Number of positions covered by the ranges.
+   */
+  uint64_t m_coveredLength;
+};
+
+#endif  // BUNDLEAGENT_UTILS_INTERVALINDEX_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE MappedFile.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the MappedFile class.
+ */
+
+#include "Utils/MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+MappedFile::MappedFile(const std::string &path)
+    : m_data(nullptr),
+      m_size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw MappedFileException(
+        "[MappedFile] Cannot open " + path + ", reason: "
+            + std::string(strerror(errno)));
+  }
+  try {
+    map(fd);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+}
+
+MappedFile::MappedFile(int fd)
+    : m_data(nullptr),
+      m_size(0) {
+  map(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (m_size > 0) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+void MappedFile::map(int fd) {
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    throw MappedFileException(
+        "[MappedFile] Cannot stat the file, reason: "
+            + std::string(strerror(errno)));
+  }
+  m_size = info.st_size;
+  if (m_size == 0) {
+    // Empty files can not be mapped.
+    m_data = "";
+    return;
+  }
+  void *data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    m_size = 0;
+    throw MappedFileException(
+        "[MappedFile] Cannot map the file, reason: "
+            + std::string(strerror(errno)));
+  }
+  // The files are mostly read from the start to the end, when sent.
+  madvise(data, m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<const char*>(data);
+}
+
+const char* MappedFile::data() const {
+  return m_data;
+}
+
+size_t MappedFile::size() const {
+  return m_size;
+}
+
+int MappedFile::createTemporary(const std::string &directory) {
+  std::string name = directory + ".spool_XXXXXX";
+  std::vector<char> path(name.begin(), name.end());
+  path.push_back('\0');
+  int fd = mkstemp(path.data());
+  if (fd >= 0) {
+    unlink(path.data());
+  }
+  return fd;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE MappedFile.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the MappedFile class.
+ */
+#ifndef BUNDLEAGENT_UTILS_MAPPEDFILE_H_
+#define BUNDLEAGENT_UTILS_MAPPEDFILE_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+class MappedFileException : public std::runtime_error {
+ public:
+  explicit MappedFileException(const std::string &what)
+      : runtime_error(what) {
+  }
+};
+
+/**
+ * CLASS MappedFile
+ * This class maps a whole file, read only, into memory.
+ *
+ * The pages are loaded by the kernel when they are read and, as they are
+ * backed by the file, they can be dropped again under memory pressure. This
+ * allows to hold data bigger than the available RAM. The mapping stays valid
+ * if the file is removed or replaced by a rename.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Maps a file.
+   *
+   * Throws a MappedFileException if the file can not be mapped.
+   *
+   * @param path The path of the file.
+   */
+  explicit MappedFile(const std::string &path);
+  /**
+   * @brief Maps an open file.
+   *
+   * The descriptor is not closed, the mapping does not need it.
+   * Throws a MappedFileException if the file can not be mapped.
+   *
+   * @param fd The file descriptor.
+   */
+  explicit MappedFile(int fd);
+  /**
+   * Destructor of the class, unmaps the file.
+   */
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  /**
+   * @brief Returns a pointer to the first byte of the file.
+   *
+   * @return The pointer to the mapped bytes.
+   */
+  const char* data() const;
+  /**
+   * @brief Returns the size of the file.
+   *
+   * @return The size in bytes.
+   */
+  size_t size() const;
+  /**
+   * @brief Creates an anonymous temporary file.
+   *
+   * The file is created into the given directory and removed at once, so it
+   * is released when its descriptor and its mappings are closed, even if the
+   * process dies.
+   *
+   * @param directory The directory of the file, ending with a slash.
+   * @return The file descriptor, -1 if the file can not be created.
+   */
+  static int createTemporary(const std::string &directory);
+
+ private:
+  /**
+   * @brief Maps the file.
+   *
+   * @param fd The file descriptor.
+   */
+  void map(int fd);
+  /**
+   * First byte of the mapping.
+   */
+  const char *m_data;
+  /**
+   * Size of the mapping.
+   */
+  size_t m_size;
+};
+
+#endif  // BUNDLEAGENT_UTILS_MAPPEDFILE_H_
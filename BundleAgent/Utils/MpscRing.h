@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE MpscRing.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the MpscRing class.
+ */
+#ifndef BUNDLEAGENT_UTILS_MPSCRING_H_
+#define BUNDLEAGENT_UTILS_MPSCRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * CLASS MpscRing
+ * This class implements a bounded ring of values where many threads can
+ * push and one thread pops, without locks.
+ *
+ * Every cell holds a sequence number that tells if it is free for the
+ * producer of a round or filled for the consumer. The producers claim a
+ * position with a compare and swap of the tail and publish the value with
+ * the sequence of the cell, so a producer never waits for another one, and
+ * the consumer only reads the cells that are already published.
+ *
+ * The values must be cheap to copy, like pointers.
+ */
+template<class T>
+class MpscRing {
+ public:
+  /**
+   * @brief Generates an empty ring.
+   *
+   * @param capacity The minimum number of values, it is rounded up to a
+   * power of two.
+   */
+  explicit MpscRing(size_t capacity)
+      : m_mask(roundUp(capacity) - 1),
+        m_cells(new Cell[m_mask + 1]),
+        m_tail(0),
+        m_head(0) {
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  /**
+   * Destructor of the class.
+   */
+  ~MpscRing() {
+  }
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+  /**
+   * @brief Adds a value at the end of the ring.
+   *
+   * It can be called from any thread.
+   *
+   * @param value The value to add.
+   * @return False if the ring is full.
+   */
+  bool push(const T &value) {
+    size_t position = m_tail.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = m_cells[position & m_mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t>(sequence)
+          - static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (m_tail.compare_exchange_weak(position, position + 1,
+                                         std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        // The consumer has not freed the cell of the previous round.
+        return false;
+      } else {
+        position = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  /**
+   * @brief Removes the first value of the ring.
+   *
+   * It must only be called from one thread at a time.
+   *
+   * @param value The removed value.
+   * @return False if the ring is empty, or the first value is still being
+   * written.
+   */
+  bool pop(T &value) {
+    Cell &cell = m_cells[m_head & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_head + 1) {
+      return false;
+    }
+    value = cell.value;
+    // The cell is free for the next round.
+    cell.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    ++m_head;
+    return true;
+  }
+  /**
+   * @brief Returns the number of values that the ring can hold.
+   *
+   * @return The capacity of the ring.
+   */
+  size_t getCapacity() const {
+    return m_mask + 1;
+  }
+
+ private:
+  /**
+   * A position of the ring.
+   */
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+  /**
+   * Returns the first power of two equal or bigger than the value.
+   */
+  static size_t roundUp(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+      power <<= 1;
+    }
+    return power;
+  }
+  /**
+   * The capacity minus one, to get the cell of a position.
+   */
+  const size_t m_mask;
+  /**
+   * The cells of the ring.
+   */
+  std::unique_ptr<Cell[]> m_cells;
+  /**
+   * The next position to write, shared by the producers.
+   */
+  std::atomic<size_t> m_tail;
+  /**
+   * Keeps the tail and the head into different cache lines.
+   */
+  char m_padding[64];
+  /**
+   * The next position to read, only used by the consumer.
+   */
+  size_t m_head;
+};
+
+#endif  // BUNDLEAGENT_UTILS_MPSCRING_H_
@@ -24,39 +24,64 @@
 
 #include "Utils/SDNV.h"
 #include <string>
-#include <sstream>
+#include <stdexcept>
 
-std::string SDNV::encode(uint64_t value) {
-  unsigned char buffer[10];  // Max bytes for a SDNV codifying
-                             // a value of 2^64 - 1
-  unsigned char *bufferPosition = &buffer[0];
+size_t SDNV::encode(uint64_t value, uint8_t *data, const uint8_t *end) {
   const size_t length_value = SDNV::getLength(value);
-  bufferPosition += length_value;
-  unsigned char high_bit = 0;  // for the last byte
+  if (static_cast<size_t>(end - data) < length_value) {
+    throw std::out_of_range("[SDNV] Buffer too small to encode the value");
+  }
+  uint8_t *bufferPosition = data + length_value;
+  uint8_t high_bit = 0;  // for the last byte
   uint64_t auxValue = value;
   do {
     --bufferPosition;
-    *bufferPosition = (unsigned char) (high_bit | (auxValue & 0x7f));
+    *bufferPosition = static_cast<uint8_t>(high_bit | (auxValue & 0x7f));
     high_bit = (1 << 7);  // for all but the last byte
     auxValue = auxValue >> 7;
   } while (auxValue != 0);
-  std::string ret = std::string((const char*)&buffer[0], length_value);
-  return ret;
+  return length_value;
 }
 
-uint64_t SDNV::decode(std::string encodedValue) {
-  size_t value_length = 0;
-  unsigned char bufferPosition = 0;
+size_t SDNV::decode(const uint8_t *data, const uint8_t *end,
+                    uint64_t &value) {
+  const uint8_t *bufferPosition = data;
+  const uint8_t *limit = (static_cast<size_t>(end - data) > MAX_LENGTH) ?
+      data + MAX_LENGTH : end;
+  uint64_t auxValue = 0;
+  while (bufferPosition < limit) {
+    uint8_t byte = *bufferPosition++;
+    if ((auxValue >> 57) != 0) {
+      throw std::out_of_range("[SDNV] Value does not fit in 64 bits");
+    }
+    auxValue = (auxValue << 7) | (byte & 0x7f);
+    if ((byte & 0x80) == 0) {
+      value = auxValue;
+      return bufferPosition - data;
+    }
+  }
+  throw std::out_of_range("[SDNV] Value out of the buffer");
+}
+
+size_t SDNV::decode(const uint8_t *data, const uint8_t *end, uint64_t *values,
+                    size_t count) {
+  const uint8_t *bufferPosition = data;
+  for (size_t i = 0; i < count; ++i) {
+    bufferPosition += SDNV::decode(bufferPosition, end, values[i]);
+  }
+  return bufferPosition - data;
+}
+
+std::string SDNV::encode(uint64_t value) {
+  uint8_t buffer[MAX_LENGTH];
+  size_t length = SDNV::encode(value, buffer, buffer + MAX_LENGTH);
+  return std::string(reinterpret_cast<const char*>(buffer), length);
+}
+
+uint64_t SDNV::decode(const std::string &encodedValue) {
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(encodedValue.data());
   uint64_t value = 0;
-  std::stringstream ss;
-  ss << encodedValue;
-  do {
-    ss.get((char&)bufferPosition);
-    value = (value << 7) | (bufferPosition & 0x7f);
-    ++value_length;
-    if ((bufferPosition & (1 << 7)) == 0)
-      break;  // all done;
-  } while (true);
+  SDNV::decode(data, data + encodedValue.size(), value);
   return value;
 }
 
@@ -70,15 +95,8 @@ size_t SDNV::getLength(uint64_t value) {
   return value_length;
 }
 
-size_t SDNV::getLength(std::string encodedValue) {
-  size_t value_length = 0;
-  unsigned char bufferPosition = 0;
-  std::stringstream ss;
-  ss << encodedValue;
-  do {
-    ++value_length;
-    ss.get((char&)bufferPosition);
-  } while (bufferPosition & 0x80);
-  return value_length;
+size_t SDNV::getLength(const std::string &encodedValue) {
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(encodedValue.data());
+  uint64_t value = 0;
+  return SDNV::decode(data, data + encodedValue.size(), value);
 }
-
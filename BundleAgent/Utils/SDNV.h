@@ -24,13 +24,51 @@
 #ifndef BUNDLEAGENT_UTILS_SDNV_H_
 #define BUNDLEAGENT_UTILS_SDNV_H_
 
+#include <cstdint>
 #include <string>
 
 namespace SDNV {
+  /**
+   * Maximum number of bytes of a SDNV codifying a value of 2^64 - 1.
+   */
+  const size_t MAX_LENGTH = 10;
+  /**
+   * Encodes a value into the caller buffer.
+   * Throws std::out_of_range if the SDNV does not fit into the buffer.
+   *
+   * @param value The value to encode.
+   * @param data Pointer to the first byte to write.
+   * @param end Pointer past the last writable byte.
+   * @return The number of bytes written.
+   */
+  size_t encode(uint64_t value, uint8_t *data, const uint8_t *end);
+  /**
+   * Decodes the SDNV that starts at data, without copying it.
+   * Throws std::out_of_range if the SDNV does not end before end, or if it is
+   * longer than MAX_LENGTH or its value does not fit in 64 bits.
+   *
+   * @param data Pointer to the first byte of the SDNV.
+   * @param end Pointer past the last readable byte.
+   * @param value The decoded value.
+   * @return The number of bytes read.
+   */
+  size_t decode(const uint8_t *data, const uint8_t *end, uint64_t &value);
+  /**
+   * Decodes a run of count consecutive SDNVs that starts at data.
+   * Throws std::out_of_range under the same conditions as decode.
+   *
+   * @param data Pointer to the first byte of the first SDNV.
+   * @param end Pointer past the last readable byte.
+   * @param values Array where the count decoded values are stored.
+   * @param count The number of SDNVs to decode.
+   * @return The number of bytes read.
+   */
+  size_t decode(const uint8_t *data, const uint8_t *end, uint64_t *values,
+                size_t count);
   std::string encode(uint64_t value);
-  uint64_t decode(std::string encodedValue);
+  uint64_t decode(const std::string &encodedValue);
   size_t getLength(uint64_t value);
-  size_t getLength(std::string encodedValue);
+  size_t getLength(const std::string &encodedValue);
 }
 
 #endif  // BUNDLEAGENT_UTILS_SDNV_H_
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE SeenFilter.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the implementation of the SeenFilter class.
+ */
+
+#include "Utils/SeenFilter.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const char SEEN_FILTER_MAGIC[8] = { 'a', 'D', 'T', 'N', 'S', 'E', 'E',
+    'N' };
+static const uint32_t SEEN_FILTER_VERSION = 1;
+
+const uint64_t SeenFilter::BITS_PER_KEY;
+const uint32_t SeenFilter::HASHES;
+
+SeenFilter::SeenFilter(uint64_t window, uint64_t capacity)
+    : m_window(window),
+      m_capacity(std::max<uint64_t>(capacity, 1)),
+      m_bitCount(((m_capacity * BITS_PER_KEY + 63) / 64) * 64),
+      m_current(0),
+      m_changed(false) {
+  for (auto &generation : m_generations) {
+    generation.start = 0;
+    generation.count = 0;
+    generation.bits.assign(m_bitCount / 8, 0);
+  }
+}
+
+SeenFilter::~SeenFilter() {
+}
+
+bool SeenFilter::contains(const std::string &key, uint64_t now) {
+  std::vector<uint64_t> keyPositions = positions(key);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  rotate(now);
+  return test(m_generations[m_current], keyPositions)
+      || test(m_generations[1 - m_current], keyPositions);
+}
+
+void SeenFilter::insert(const std::string &key, uint64_t now) {
+  std::vector<uint64_t> keyPositions = positions(key);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  rotate(now);
+  Generation &generation = m_generations[m_current];
+  for (auto position : keyPositions) {
+    generation.bits[position / 8] |= static_cast<uint8_t>(1 << (position % 8));
+  }
+  generation.count++;
+  m_changed = true;
+}
+
+void SeenFilter::rotate(uint64_t now) {
+  Generation &current = m_generations[m_current];
+  if (now < current.start + m_window && current.count < m_capacity) {
+    return;
+  }
+  Generation &previous = m_generations[1 - m_current];
+  if (current.count == 0) {
+    // Nothing has been inserted for a window, so the keys of the previous
+    // generation are older than it.
+    if (previous.count > 0) {
+      std::fill(previous.bits.begin(), previous.bits.end(), 0);
+      previous.count = 0;
+      m_changed = true;
+    }
+    current.start = now;
+    return;
+  }
+  std::fill(previous.bits.begin(), previous.bits.end(), 0);
+  previous.count = 0;
+  previous.start = now;
+  m_current = 1 - m_current;
+  // The keys of the old current generation are also older than the window.
+  if (now >= current.start + 2 * m_window) {
+    std::fill(current.bits.begin(), current.bits.end(), 0);
+    current.count = 0;
+  }
+  m_changed = true;
+}
+
+std::vector<uint64_t> SeenFilter::positions(const std::string &key) const {
+  // FNV-1a, and a second hash mixed from it, combined as h1 + i * h2.
+  uint64_t h1 = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    h1 ^= c;
+    h1 *= 1099511628211ULL;
+  }
+  uint64_t h2 = h1 + 0x9E3779B97F4A7C15ULL;
+  h2 = (h2 ^ (h2 >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  h2 = (h2 ^ (h2 >> 27)) * 0x94D049BB133111EBULL;
+  h2 = (h2 ^ (h2 >> 31)) | 1;
+  std::vector<uint64_t> keyPositions(HASHES);
+  for (uint32_t i = 0; i < HASHES; ++i) {
+    keyPositions[i] = (h1 + i * h2) % m_bitCount;
+  }
+  return keyPositions;
+}
+
+bool SeenFilter::test(const Generation &generation,
+                      const std::vector<uint64_t> &positions) {
+  if (generation.count == 0) {
+    return false;
+  }
+  for (auto position : positions) {
+    if (!(generation.bits[position / 8] & (1 << (position % 8)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SeenFilter::save(const std::string &path) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_changed) {
+    return true;
+  }
+  // The filter is written to a temporary file and renamed, so a crash never
+  // leaves a half written filter.
+  std::string temporary = path + ".tmp";
+  std::ofstream file(temporary, std::ofstream::out | std::ofstream::binary);
+  if (!file) {
+    return false;
+  }
+  file.write(SEEN_FILTER_MAGIC, sizeof(SEEN_FILTER_MAGIC));
+  file.write(reinterpret_cast<const char*>(&SEEN_FILTER_VERSION),
+             sizeof(SEEN_FILTER_VERSION));
+  file.write(reinterpret_cast<const char*>(&m_window), sizeof(m_window));
+  file.write(reinterpret_cast<const char*>(&m_capacity), sizeof(m_capacity));
+  file.write(reinterpret_cast<const char*>(&m_current), sizeof(m_current));
+  for (auto &generation : m_generations) {
+    file.write(reinterpret_cast<const char*>(&generation.start),
+               sizeof(generation.start));
+    file.write(reinterpret_cast<const char*>(&generation.count),
+               sizeof(generation.count));
+    file.write(reinterpret_cast<const char*>(generation.bits.data()),
+               generation.bits.size());
+  }
+  file.close();
+  if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  m_changed = false;
+  return true;
+}
+
+bool SeenFilter::load(const std::string &path) {
+  std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+  if (!file) {
+    return false;
+  }
+  char magic[sizeof(SEEN_FILTER_MAGIC)];
+  uint32_t version = 0;
+  uint64_t window = 0;
+  uint64_t capacity = 0;
+  int current = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  file.read(reinterpret_cast<char*>(&window), sizeof(window));
+  file.read(reinterpret_cast<char*>(&capacity), sizeof(capacity));
+  file.read(reinterpret_cast<char*>(&current), sizeof(current));
+  if (!file || !std::equal(magic, magic + sizeof(magic), SEEN_FILTER_MAGIC)
+      || version != SEEN_FILTER_VERSION || window != m_window
+      || capacity != m_capacity || (current != 0 && current != 1)) {
+    return false;
+  }
+  Generation generations[2];
+  for (auto &generation : generations) {
+    generation.bits.resize(m_bitCount / 8);
+    file.read(reinterpret_cast<char*>(&generation.start),
+              sizeof(generation.start));
+    file.read(reinterpret_cast<char*>(&generation.count),
+              sizeof(generation.count));
+    file.read(reinterpret_cast<char*>(generation.bits.data()),
+              generation.bits.size());
+  }
+  if (!file) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (int i = 0; i < 2; ++i) {
+    m_generations[i] = std::move(generations[i]);
+  }
+  m_current = current;
+  m_changed = false;
+  return true;
+}
+
+uint64_t SeenFilter::getByteSize() const {
+  return 2 * m_bitCount / 8;
+}
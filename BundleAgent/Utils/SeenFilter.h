@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE SeenFilter.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the SeenFilter class.
+ */
+#ifndef BUNDLEAGENT_UTILS_SEENFILTER_H_
+#define BUNDLEAGENT_UTILS_SEENFILTER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * CLASS SeenFilter
+ * This class remembers the keys seen in a time window, with a fixed amount
+ * of memory.
+ *
+ * The keys are kept into two Bloom filters, the current generation and the
+ * previous one. When the current generation is older than the window, or it
+ * holds the given capacity, it becomes the previous one and the oldest is
+ * cleared. So a key is remembered at least for the window, unless more than
+ * the capacity keys are inserted meanwhile, and a key that has not been
+ * inserted is reported as seen with a probability of about 1%.
+ */
+class SeenFilter {
+ public:
+  /**
+   * @brief Generates an empty filter.
+   *
+   * @param window Seconds that a key is remembered.
+   * @param capacity Number of keys of a generation.
+   */
+  SeenFilter(uint64_t window, uint64_t capacity);
+  /**
+   * Destructor of the class.
+   */
+  ~SeenFilter();
+  /**
+   * @brief Checks if a key has been seen.
+   *
+   * @param key The key.
+   * @param now The current time in seconds.
+   * @return True if the key has been inserted in the window, or it is a
+   * false positive.
+   */
+  bool contains(const std::string &key, uint64_t now);
+  /**
+   * @brief Inserts a key.
+   *
+   * @param key The key.
+   * @param now The current time in seconds.
+   */
+  void insert(const std::string &key, uint64_t now);
+  /**
+   * @brief Saves the filter to a file, if it has changed since the last
+   * time it was saved or loaded.
+   *
+   * @param path The path of the file.
+   * @return False if the file cannot be written.
+   */
+  bool save(const std::string &path);
+  /**
+   * @brief Loads a filter saved with the same window and capacity.
+   *
+   * @param path The path of the file.
+   * @return False if the file cannot be read or it has other parameters,
+   * the filter does not change then.
+   */
+  bool load(const std::string &path);
+  /**
+   * @brief Returns the memory used by the filter.
+   *
+   * @return The size of the generations in bytes.
+   */
+  uint64_t getByteSize() const;
+
+ private:
+  /**
+   * A Bloom filter.
+   */
+  struct Generation {
+    /**
+     * The time when the generation was started.
+     */
+    uint64_t start;
+    /**
+     * Number of keys inserted.
+     */
+    uint64_t count;
+    /**
+     * The bits of the filter.
+     */
+    std::vector<uint8_t> bits;
+  };
+  /**
+   * Starts a new generation if the current one is full or old.
+   * The mutex must be held.
+   */
+  void rotate(uint64_t now);
+  /**
+   * Returns the positions of the bits of a key.
+   */
+  std::vector<uint64_t> positions(const std::string &key) const;
+  /**
+   * Checks if all the bits are set into a generation.
+   */
+  static bool test(const Generation &generation,
+                   const std::vector<uint64_t> &positions);
+  /**
+   * Seconds that a generation is current.
+   */
+  uint64_t m_window;
+  /**
+   * Number of keys of a generation.
+   */
+  uint64_t m_capacity;
+  /**
+   * Number of bits of a generation.
+   */
+  uint64_t m_bitCount;
+  /**
+   * The current generation and the previous one.
+   */
+  Generation m_generations[2];
+  /**
+   * The index of the current generation.
+   */
+  int m_current;
+  /**
+   * True if the filter has changed since it was saved or loaded.
+   */
+  bool m_changed;
+  /**
+   * Mutex for the generations.
+   */
+  std::mutex m_mutex;
+  /**
+   * Bits per key, with 7 hashes it gives a false positive rate below 1%.
+   */
+  static const uint64_t BITS_PER_KEY = 10;
+  /**
+   * Number of bits set for a key.
+   */
+  static const uint32_t HASHES = 7;
+};
+
+#endif  // BUNDLEAGENT_UTILS_SEENFILTER_H_
@@ -27,10 +27,14 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <sys/select.h>
+#include <sys/uio.h>
+#include <limits.h>
 #include <errno.h>
 #include <string>
 #include <utility>
 #include <cstring>
+#include <vector>
+#include <algorithm>
 #include "Socket.h"
 #include <iostream>
 
@@ -270,6 +274,48 @@ bool Socket::operator<<(const uint32_t &value) {
   return true;
 }
 
+bool Socket::operator<<(const std::vector<ConstBuffer> &buffers) {
+  std::vector<iovec> iov;
+  iov.reserve(buffers.size());
+  for (auto &buffer : buffers) {
+    if (buffer.second > 0) {
+      iov.push_back(iovec { const_cast<char*>(buffer.first), buffer.second });
+    }
+  }
+  size_t position = 0;
+  while (position < iov.size()) {
+    msghdr message{};
+    message.msg_iov = &iov[position];
+    message.msg_iovlen = std::min(iov.size() - position,
+                                  static_cast<size_t>(IOV_MAX));
+    if (!m_stream) {
+      message.msg_name = &m_destinationAddr;
+      message.msg_namelen = sizeof(m_destinationAddr);
+    }
+    ssize_t writed = sendmsg(m_socket, &message, MSG_NOSIGNAL);
+    if (writed < 0) {
+      m_lastError = std::string(strerror(errno));
+      return false;
+    }
+    if (!m_stream) {
+      position += message.msg_iovlen;
+      continue;
+    }
+    // Skip the buffers completely sent and advance the partially sent one.
+    size_t sent = static_cast<size_t>(writed);
+    while (position < iov.size() && sent >= iov[position].iov_len) {
+      sent -= iov[position].iov_len;
+      ++position;
+    }
+    if (sent > 0) {
+      iov[position].iov_base = static_cast<char*>(iov[position].iov_base)
+          + sent;
+      iov[position].iov_len -= sent;
+    }
+  }
+  return true;
+}
+
 bool Socket::operator>>(StringWithSize value) {
   char* buff = new char[value.second];
   uint32_t received = 0;
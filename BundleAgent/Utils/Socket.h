@@ -28,6 +28,7 @@
 #include <string>
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 /**
  * Type used to send a string of a fixed size
@@ -37,6 +38,11 @@ typedef std::pair<const std::string&, const uint32_t&> ConstStringWithSize;
  * Type used to receive a string of size.
  */
 typedef std::pair<std::string&, const uint32_t&> StringWithSize;
+/**
+ * Type used to send a buffer without copying it, a pointer to the first byte
+ * and the number of bytes.
+ */
+typedef std::pair<const char*, size_t> ConstBuffer;
 
 /**
  * CLASS Socket
@@ -186,6 +192,14 @@ class Socket {
    * @return True if the uint32 has been send without errors.
    */
   bool operator<<(const uint32_t &value);
+  /**
+   * Function to send a list of buffers, one after the other, with the
+   * minimum number of system calls and without joining them.
+   * If an error occurs lastError is set.
+   * @param buffers The buffers to send.
+   * @return True if all the buffers have been send without errors.
+   */
+  bool operator<<(const std::vector<ConstBuffer> &buffers);
   /**
    * Function that receives an string of a given size.
    * If an error occurs lastError is set.
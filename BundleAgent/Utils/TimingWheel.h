@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE TimingWheel.h
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the TimingWheel class.
+ */
+#ifndef BUNDLEAGENT_UTILS_TIMINGWHEEL_H_
+#define BUNDLEAGENT_UTILS_TIMINGWHEEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <vector>
+
+/**
+ * CLASS TimingWheel
+ * This class holds values that expire at a deadline, in seconds.
+ *
+ * The wheel has LEVELS levels of SLOTS slots, a slot of the first level holds
+ * the values of one second, and a slot of each level holds the time of a
+ * whole turn of the level below. A value is kept at the lowest level whose
+ * turn contains its deadline, and it moves to the level below when the time
+ * reaches its slot. So adding and removing a value is O(1), and each value
+ * moves at most LEVELS times before it expires. The values further than the
+ * last level are kept apart, and they are placed again at each turn of the
+ * last level.
+ */
+template<class T>
+class TimingWheel {
+ public:
+  /**
+   * A value into the wheel.
+   */
+  struct Timer {
+    /**
+     * The time when the value expires.
+     */
+    uint64_t deadline;
+    /**
+     * The value.
+     */
+    T value;
+    /**
+     * The slot that holds the value.
+     */
+    size_t slot;
+  };
+  /**
+   * Position of a value, to remove it.
+   */
+  typedef typename std::list<Timer>::iterator Handle;
+  /**
+   * @brief Generates an empty wheel.
+   *
+   * @param now The current time in seconds.
+   */
+  explicit TimingWheel(uint64_t now = 0)
+      : m_slots(LEVELS * SLOTS + 2),
+        m_occupied(),
+        m_time(now),
+        m_size(0) {
+  }
+  /**
+   * Destructor of the class.
+   */
+  ~TimingWheel() {
+  }
+  TimingWheel(TimingWheel&&) = default;
+  TimingWheel& operator=(TimingWheel&&) = default;
+  /**
+   * @brief Adds a value.
+   *
+   * A value whose deadline has already been passed by the wheel expires at
+   * the next advance().
+   *
+   * @param deadline The time when the value expires.
+   * @param value The value.
+   * @return The position of the value.
+   */
+  Handle add(uint64_t deadline, const T &value) {
+    ++m_size;
+    std::list<Timer> timer;
+    timer.push_back(Timer { deadline, value, 0 });
+    Handle handle = timer.begin();
+    place(timer, handle);
+    return handle;
+  }
+  /**
+   * @brief Removes a value that has not expired.
+   *
+   * @param handle The position of the value.
+   */
+  void remove(Handle handle) {
+    size_t slot = handle->slot;
+    m_slots[slot].erase(handle);
+    release(slot);
+    --m_size;
+  }
+  /**
+   * @brief Advances the time of the wheel and removes the expired values.
+   *
+   * The seconds without values are skipped, so a long advance costs the
+   * same as a short one.
+   *
+   * @param now The current time in seconds, the values with a deadline
+   * before it expire.
+   * @param expired The expired values are added to it.
+   */
+  void advance(uint64_t now, std::vector<T> &expired) {
+    take(DUE_SLOT, expired);
+    while (m_time < now) {
+      uint64_t next = nextEvent();
+      if (next >= now) {
+        m_time = now;
+        break;
+      }
+      m_time = next;
+      // The upper slots that start now go down, from the top.
+      if ((m_time & ((1ULL << (LEVELS * BITS)) - 1)) == 0) {
+        cascade(FAR_SLOT);
+      }
+      for (size_t level = LEVELS - 1; level > 0; --level) {
+        if ((m_time & ((1ULL << (level * BITS)) - 1)) == 0) {
+          cascade(level * SLOTS + ((m_time >> (level * BITS)) & (SLOTS - 1)));
+        }
+      }
+      take(m_time & (SLOTS - 1), expired);
+      ++m_time;
+    }
+  }
+  /**
+   * @brief Returns the number of values into the wheel.
+   *
+   * @return The number of values.
+   */
+  size_t getSize() const {
+    return m_size;
+  }
+  /**
+   * @brief Returns the time of the wheel.
+   *
+   * @return The time of the last advance().
+   */
+  uint64_t getTime() const {
+    return m_time;
+  }
+
+ private:
+  /**
+   * Bits of the time of each level.
+   */
+  static const size_t BITS = 6;
+  /**
+   * Number of slots of a level.
+   */
+  static const size_t SLOTS = 1 << BITS;
+  /**
+   * Number of levels, they hold the next 2^24 seconds, about 194 days.
+   */
+  static const size_t LEVELS = 4;
+  /**
+   * The slot of the values further than the last level.
+   */
+  static const size_t FAR_SLOT = LEVELS * SLOTS;
+  /**
+   * The slot of the values whose deadline has been passed.
+   */
+  static const size_t DUE_SLOT = LEVELS * SLOTS + 1;
+  /**
+   * Moves a timer from a list into the slot of its deadline.
+   */
+  void place(std::list<Timer> &from, Handle handle) {
+    size_t slot = FAR_SLOT;
+    if (handle->deadline < m_time) {
+      slot = DUE_SLOT;
+    } else {
+      for (size_t level = 0; level < LEVELS; ++level) {
+        if ((handle->deadline >> ((level + 1) * BITS))
+            == (m_time >> ((level + 1) * BITS))) {
+          size_t index = (handle->deadline >> (level * BITS)) & (SLOTS - 1);
+          slot = level * SLOTS + index;
+          m_occupied[level] |= 1ULL << index;
+          break;
+        }
+      }
+    }
+    handle->slot = slot;
+    m_slots[slot].splice(m_slots[slot].end(), from, handle);
+  }
+  /**
+   * Clears the bit of a slot of the levels if it is empty.
+   */
+  void release(size_t slot) {
+    if (slot < FAR_SLOT && m_slots[slot].empty()) {
+      m_occupied[slot / SLOTS] &= ~(1ULL << (slot % SLOTS));
+    }
+  }
+  /**
+   * Places again the timers of a slot, relative to the time of the wheel.
+   */
+  void cascade(size_t slot) {
+    std::list<Timer> timers;
+    timers.swap(m_slots[slot]);
+    release(slot);
+    while (!timers.empty()) {
+      place(timers, timers.begin());
+    }
+  }
+  /**
+   * Removes all the timers of a slot and adds their values to expired.
+   */
+  void take(size_t slot, std::vector<T> &expired) {
+    for (auto &timer : m_slots[slot]) {
+      expired.push_back(timer.value);
+    }
+    m_size -= m_slots[slot].size();
+    m_slots[slot].clear();
+    release(slot);
+  }
+  /**
+   * Returns the first second, from the time of the wheel, where a slot
+   * expires or goes down.
+   */
+  uint64_t nextEvent() const {
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (size_t level = 0; level < LEVELS; ++level) {
+      uint64_t span = 1ULL << (level * BITS);
+      size_t index = (m_time >> (level * BITS)) & (SLOTS - 1);
+      // The slot of the time only counts if it has not started yet.
+      size_t first = (m_time & (span - 1)) == 0 ? index : index + 1;
+      if (first >= SLOTS) {
+        continue;
+      }
+      uint64_t bits = m_occupied[level] & (~0ULL << first);
+      if (bits != 0) {
+        uint64_t turn = m_time & ~((span << BITS) - 1);
+        next = std::min<uint64_t>(
+            next, turn + __builtin_ctzll(bits) * span);
+      }
+    }
+    if (next == std::numeric_limits<uint64_t>::max()
+        && !m_slots[FAR_SLOT].empty()) {
+      // Only far values are left, go to the turn of the closest one.
+      uint64_t span = 1ULL << (LEVELS * BITS);
+      uint64_t closest = next;
+      for (auto &timer : m_slots[FAR_SLOT]) {
+        closest = std::min(closest, timer.deadline);
+      }
+      next = std::max(closest & ~(span - 1), (m_time + span - 1) & ~(span - 1));
+    }
+    return next;
+  }
+  /**
+   * The slots of the levels, the far values and the passed ones.
+   */
+  std::vector<std::list<Timer>> m_slots;
+  /**
+   * A bit for each slot of a level that holds values.
+   */
+  uint64_t m_occupied[LEVELS];
+  /**
+   * The first second that has not expired.
+   */
+  uint64_t m_time;
+  /**
+   * The number of values.
+   */
+  size_t m_size;
+};
+
+template<class T> const size_t TimingWheel<T>::BITS;
+template<class T> const size_t TimingWheel<T>::SLOTS;
+template<class T> const size_t TimingWheel<T>::LEVELS;
+template<class T> const size_t TimingWheel<T>::FAR_SLOT;
+template<class T> const size_t TimingWheel<T>::DUE_SLOT;
+
+#endif  // BUNDLEAGENT_UTILS_TIMINGWHEEL_H_
@@ -34,6 +34,7 @@
 #include "Bundle/Bundle.h"
 #include "Bundle/CanonicalBlock.h"
 #include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
 #include "Bundle/MetadataExtensionBlock.h"
 #include "Bundle/ForwardingMEB.h"
 #include "Bundle/RoutingSelectionMEB.h"
@@ -50,6 +51,8 @@ adtnSocket::adtnSocket(std::string ip, int sendPort, int recvPort,
       m_recvPort(recvPort),
       m_nodeName("_ADTN_LIB_"),
       m_sourceName("_ADTN_LIB_"),
+      m_priority(PrimaryBlockControlFlags::PRIORITY_BULK),
+      m_lifetime(0),
       m_recvSocket(-1),
       m_lastBundle(nullptr) {
 }
@@ -131,6 +134,10 @@ std::string adtnSocket::recv() {
 void adtnSocket::send(std::string destination, std::string message) {
   try {
     Bundle b = Bundle(m_sourceName, destination, message);
+    b.getPrimaryBlock()->setPrimaryProcFlag(m_priority);
+    if (m_lifetime != 0) {
+      b.getPrimaryBlock()->setLifetime(m_lifetime);
+    }
     if (m_frameworkExtensions.size() > 0) {
       for (auto it = m_frameworkExtensions.begin();
           it != m_frameworkExtensions.end(); ++it) {
@@ -180,6 +187,19 @@ void adtnSocket::changeSource(std::string name) {
   m_sourceName = name;
 }
 
+void adtnSocket::setPriority(PrimaryBlockControlFlags priority) {
+  if (priority != PrimaryBlockControlFlags::PRIORITY_BULK
+      && priority != PrimaryBlockControlFlags::PRIORITY_NORMAL
+      && priority != PrimaryBlockControlFlags::PRIORITY_EXPEDITED) {
+    throw adtnSocketException("The flag is not a priority.");
+  }
+  m_priority = priority;
+}
+
+void adtnSocket::setLifetime(uint64_t lifetime) {
+  m_lifetime = lifetime;
+}
+
 void adtnSocket::addRoutingSelection(uint8_t type) {
   m_blocksToAdd.push_back(std::make_shared<RoutingSelectionMEB>(type));
 }
@@ -192,8 +212,11 @@ void adtnSocket::clearBlocks() {
   m_blocksToAdd.clear();
 }
 
-void adtnSocket::addRouteReporting() {
-  m_blocksToAdd.push_back(std::make_shared<RouteReportingMEB>());
+void adtnSocket::addRouteReporting(uint64_t maxHops) {
+  std::shared_ptr<RouteReportingMEB> rrm = std::make_shared<
+      RouteReportingMEB>();
+  rrm->setMaxHops(maxHops);
+  m_blocksToAdd.push_back(rrm);
 }
 
 std::string adtnSocket::getRouteReporting() {
@@ -206,8 +229,8 @@ std::string adtnSocket::getRouteReporting() {
         if (static_cast<MetadataTypes>(std::static_pointer_cast<
             MetadataExtensionBlock>(block)->getMetadataType())
             == MetadataTypes::ROUTE_REPORTING_MEB) {
-          return std::static_pointer_cast<MetadataExtensionBlock>(block)
-              ->getMetadata();
+          return std::static_pointer_cast<RouteReportingMEB>(block)
+              ->getRouteReporting();
         }
       }
     }
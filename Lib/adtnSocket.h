@@ -121,6 +121,23 @@ class adtnSocket {
    * @param source The new sender id.
    */
   void changeSource(std::string source);
+  /**
+   * @brief Sets the priority of the bundles sent.
+   *
+   * The nodes with a priority queue process the expedited bundles first, then
+   * the normal ones and then the bulk ones. By default the bundles are bulk.
+   * Throws an adtnSocketException if the flag is not a priority.
+   *
+   * @param priority The priority, PRIORITY_BULK, PRIORITY_NORMAL or
+   *                 PRIORITY_EXPEDITED.
+   */
+  void setPriority(PrimaryBlockControlFlags priority);
+  /**
+   * @brief Sets the lifetime of the bundles sent.
+   *
+   * @param lifetime The lifetime in seconds, 0 to use the default one.
+   */
+  void setLifetime(uint64_t lifetime);
   /**
    * @brief Adds a Routing Selection MEB to the bundle.
    *
@@ -144,8 +161,12 @@ class adtnSocket {
    *
    * The route reporting block will log the arrival and the depart time of
    * the bundle in the different nodes it travels.
+   *
+   * @param maxHops The maximum number of hops to log, when reached the
+   *                first hop and the most recent ones are kept. 0 for no
+   *                limit.
    */
-  void addRouteReporting();
+  void addRouteReporting(uint64_t maxHops = 0);
   /**
    * If the last received bundle contains a routeReporting MEB it will
    * return the information.
@@ -202,6 +223,14 @@ class adtnSocket {
    * The source name used in the bundle source.
    */
   std::string m_sourceName;
+  /**
+   * The priority of the bundles sent.
+   */
+  PrimaryBlockControlFlags m_priority;
+  /**
+   * The lifetime of the bundles sent, 0 to use the default one.
+   */
+  uint64_t m_lifetime;
   /**
    * The socket used to receive the bundles.
    */
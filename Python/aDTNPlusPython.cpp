@@ -67,6 +67,12 @@ PYBIND11_MODULE(aDTNPlus, m) {
           " Socket must have been connected before using this function.")
       .def("changeSource", &adtnSocket::changeSource, "Allows to change the "
           "default sender id.", pybind11::arg("source"))
+      .def("setPriority", &adtnSocket::setPriority, "Sets the priority of "
+          "the bundles sent, PRIORITY_BULK (default), PRIORITY_NORMAL or "
+          "PRIORITY_EXPEDITED.", pybind11::arg("priority"))
+      .def("setLifetime", &adtnSocket::setLifetime, "Sets the lifetime in "
+          "seconds of the bundles sent, 0 to use the default one.",
+          pybind11::arg("lifetime"))
       .def("addRoutingSelection", &adtnSocket::addRoutingSelection, "Adds a "
           "Routing Selection MEB to the bundle.\nThe values can be:\n"
           "\t0x01 for anti-rebooting\n\t0x02 for flooding.",
@@ -78,7 +84,9 @@ PYBIND11_MODULE(aDTNPlus, m) {
       .def("addRouteReporting", &adtnSocket::addRouteReporting, "Adds a Route "
           "reporting MEB to the bundle.\nThe route reporting block will log"
           "the arrival and the depart time of the bundle in the different"
-          "node it travels.")
+          "node it travels.\nA maximum number of hops can be given, when "
+          "reached the first hop and the most recent ones are kept.",
+          pybind11::arg("maxHops") = 0)
       .def("getRoute", &adtnSocket::getRouteReporting, "If the last received "
           "bundle contains a routeReporting MEB it will return the route.")
       .def("addFrameworkExtension", &adtnSocket::addFrameworkExtension, "Adds "
@@ -99,7 +107,8 @@ PYBIND11_MODULE(aDTNPlus, m) {
       .def("__str__", &Bundle::toString, "")
       .def_property_readonly("id", &Bundle::getId, "")
       .def_property_readonly("raw", &Bundle::getRaw, "")
-      .def("toRaw", &Bundle::toRaw, "")
+      .def("toRaw", static_cast<const std::string& (Bundle::*)()>(
+          &Bundle::toRaw), "")
       .def_property_readonly("primaryBlock", &Bundle::getPrimaryBlock, "")
       .def_property_readonly("payloadBlock", &Bundle::getPayloadBlock, "")
       .def("blocks", &Bundle::getBlocks, "")
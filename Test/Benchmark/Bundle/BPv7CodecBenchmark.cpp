@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BPv7CodecBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the BPv7 codec.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Utils/MappedFile.h"
+#include "gtest/gtest.h"
+
+/**
+ * Codec benchmark, it prints the bundles encoded and decoded per second in
+ * each version for a small and a big bundle.
+ */
+TEST(BPv7CodecBenchmark, Codec) {
+  const size_t sizes[] = { 100, 1024 * 1024 };
+  const int iterations[] = { 20000, 50 };
+  const BundleEncoding versions[] = { BundleEncoding::RFC5050,
+      BundleEncoding::BPV7 };
+  for (int s = 0; s < 2; ++s) {
+    Bundle b("node1:100", "node2:200", std::string(sizes[s], 'a'));
+    b.addBlock(std::shared_ptr<ForwardingMEB>(new ForwardingMEB("code")));
+    for (auto version : versions) {
+      std::string raw;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations[s]; ++i) {
+        // The primary block is changed, as it happens when a bundle is
+        // forwarded, so it is encoded again.
+        b.getPrimaryBlock()->setLifetime(i);
+        raw = b.toRaw(version);
+      }
+      auto middle = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations[s]; ++i) {
+        Bundle decoded(raw);
+        ASSERT_NE(nullptr, decoded.getPayloadBlock());
+      }
+      auto end = std::chrono::steady_clock::now();
+      double encodeTime = std::chrono::duration<double>(middle - start)
+          .count();
+      double decodeTime = std::chrono::duration<double>(end - middle).count();
+      std::cout << "[ BENCH    ] "
+                << (version == BundleEncoding::BPV7 ? "BPv7    " : "RFC 5050")
+                << " bundle of " << raw.size() << " bytes: "
+                << iterations[s] / encodeTime << " encodes/s, "
+                << iterations[s] / decodeTime << " decodes/s" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BlockFactoryBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the BlockFactory class.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bundle/BlockFactory.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/CanonicalBlock.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/CodeDataCarrierMEB.h"
+#include "Bundle/FrameworkMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Utils/Logger.h"
+#include "gtest/gtest.h"
+
+extern std::atomic<uint64_t> g_allocations;
+
+/**
+ * Compare the allocations of the factory against parsing each block twice
+ * and copying it, as it was done before.
+ */
+TEST(BlockFactoryBenchmark, Allocation) {
+  Bundle b("Source", "Destination", "Payload");
+  b.addBlock(std::make_shared<RoutingSelectionMEB>(0x01));
+  b.addBlock(std::make_shared<ForwardingMEB>("code"));
+  b.addBlock(std::make_shared<RouteReportingMEB>("node", time(NULL),
+                                                 time(NULL)));
+  b.addBlock(std::make_shared<CodeDataCarrierMEB>("code", "{\"a\":1}"));
+  std::string raw = b.toRaw();
+  std::vector<BlockIndex> index = Bundle(raw).getBlockIndex();
+  const int iterations = 1000;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  uint64_t start = g_allocations;
+  for (int i = 0; i < iterations; ++i) {
+    Bundle b1(raw);
+    b1.getBlocks();
+  }
+  uint64_t factoryAllocations = (g_allocations - start) / iterations;
+  start = g_allocations;
+  for (int i = 0; i < iterations; ++i) {
+    std::vector<std::shared_ptr<Block>> blocks;
+    for (size_t j = 1; j < index.size(); ++j) {
+      std::string data = raw.substr(index[j].offset, index[j].length);
+      if (index[j].blockType
+          == static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)) {
+        blocks.push_back(std::make_shared<PayloadBlock>(PayloadBlock(data)));
+        continue;
+      }
+      MetadataExtensionBlock meb(data);
+      switch (static_cast<MetadataTypes>(meb.getMetadataType())) {
+        case MetadataTypes::ROUTING_SELECTION_MEB:
+          blocks.push_back(std::make_shared<RoutingSelectionMEB>(
+              RoutingSelectionMEB(data)));
+          break;
+        case MetadataTypes::FORWARDING_MEB:
+          blocks.push_back(std::make_shared<ForwardingMEB>(
+              ForwardingMEB(data, true)));
+          break;
+        case MetadataTypes::ROUTE_REPORTING_MEB:
+          blocks.push_back(std::make_shared<RouteReportingMEB>(
+              RouteReportingMEB(data)));
+          break;
+        default:
+          blocks.push_back(std::make_shared<CodeDataCarrierMEB>(
+              CodeDataCarrierMEB(data)));
+          break;
+      }
+    }
+  }
+  uint64_t switchAllocations = (g_allocations - start) / iterations;
+  Logger::getInstance()->setLogLevel(logLevel);
+  std::cout << "[ BENCH    ] Allocations per bundle (factory): "
+            << factoryAllocations << std::endl;
+  std::cout << "[ BENCH    ] Allocations per bundle (double parse + copy): "
+            << switchAllocations << std::endl;
+  ASSERT_LT(factoryAllocations, switchAllocations);
+}
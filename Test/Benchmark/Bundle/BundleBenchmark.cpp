@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the Bundle class.
+ */
+
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <iostream>
+#include <bitset>
+#include <atomic>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/CanonicalBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/BundleTypes.h"
+#include "Utils/SDNV.h"
+#include "Utils/TimestampManager.h"
+#include "Utils/MappedFile.h"
+#include "Bundle/FrameworkMEB.h"
+#include "Bundle/FrameworkExtension.h"
+
+/**
+ * Generates a raw bundle of approximately the given size, with a payload and
+ * some canonical blocks after it, and returns the time to parse it.
+ */
+static double parseTime(size_t bundleSize, int iterations) {
+  Bundle b = Bundle("Source", "Destination", std::string(bundleSize, 'a'));
+  for (int i = 0; i < 8; ++i) {
+    std::stringstream ss;
+    ss << static_cast<uint8_t>(2) << SDNV::encode(std::bitset<7>().to_ulong());
+    std::string data(128, static_cast<char>('b' + i));
+    ss << SDNV::encode(data.size()) << data;
+    b.addBlock(std::shared_ptr<CanonicalBlock>(new CanonicalBlock(ss.str())));
+  }
+  std::string raw = b.toRaw();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    Bundle b1 = Bundle(raw);
+    EXPECT_EQ(static_cast<size_t>(10), b1.getBlocks().size());
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count()
+      / iterations;
+}
+
+/**
+ * Parse benchmark, it prints the mean time to parse a raw bundle of 1KB, 1MB
+ * and 50MB.
+ */
+TEST(BundleBenchmark, Parse) {
+  std::cout << "[ BENCH    ] Parse 1KB: " << parseTime(1024, 1000) << " ms"
+            << std::endl;
+  std::cout << "[ BENCH    ] Parse 1MB: " << parseTime(1024 * 1024, 20)
+            << " ms" << std::endl;
+  std::cout << "[ BENCH    ] Parse 50MB: " << parseTime(50 * 1024 * 1024, 3)
+            << " ms" << std::endl;
+}
+
+/**
+ * Writes the data into an anonymous temporary file and maps it.
+ */
+static std::shared_ptr<const MappedFile> mapData(const std::string &data) {
+  int fd = MappedFile::createTemporary("/tmp/");
+  EXPECT_GE(fd, 0);
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t result = write(fd, data.data() + written, data.size() - written);
+    EXPECT_GT(result, 0);
+    written += result;
+  }
+  std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(
+      fd);
+  close(fd);
+  return file;
+}
+
+extern std::atomic<uint64_t> g_allocatedBytes;
+
+/**
+ * Payload file benchmark, it prints the heap requested to parse and send a
+ * bundle of 64MB from memory and from a mapped file.
+ */
+TEST(BundleBenchmark, PayloadFile) {
+  std::string raw = Bundle("Source", "Destination",
+                           std::string(64 * 1024 * 1024, 'a')).toRaw();
+  std::shared_ptr<const MappedFile> file = mapData(raw);
+  uint64_t before = g_allocatedBytes;
+  {
+    Bundle memory(raw);
+    memory.toRawSegments();
+  }
+  uint64_t memoryBytes = g_allocatedBytes - before;
+  before = g_allocatedBytes;
+  auto start = std::chrono::steady_clock::now();
+  {
+    Bundle mapped(file);
+    mapped.toRawSegments();
+  }
+  auto end = std::chrono::steady_clock::now();
+  uint64_t mappedBytes = g_allocatedBytes - before;
+  ASSERT_LT(mappedBytes, 64u * 1024);
+  std::cout << "[ BENCH    ] Heap for a 64MB bundle: " << memoryBytes
+            << " bytes in memory, " << mappedBytes << " bytes mapped ("
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms)" << std::endl;
+}
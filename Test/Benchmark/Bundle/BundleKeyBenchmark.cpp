@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleKeyBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the BundleKey class.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleKey.h"
+#include "Bundle/PrimaryBlock.h"
+#include "gtest/gtest.h"
+
+/**
+ * Compare the lookup time of string ids and keys.
+ */
+TEST(BundleKeyBenchmark, Lookup) {
+  const size_t numBundles = 100000;
+  std::vector<std::string> ids;
+  std::vector<BundleKey> keys;
+  for (size_t i = 0; i < numBundles; ++i) {
+    std::stringstream ss;
+    ss << "node" << (i % 16);
+    keys.push_back(BundleKey(ss.str(), 580000000 + i / 10, i % 10));
+    ids.push_back(keys.back().toString());
+  }
+  std::unordered_set<std::string> idSet(ids.begin(), ids.end());
+  std::unordered_set<BundleKey> keySet(keys.begin(), keys.end());
+  ASSERT_EQ(numBundles, idSet.size());
+  ASSERT_EQ(numBundles, keySet.size());
+  auto start = std::chrono::steady_clock::now();
+  size_t found = 0;
+  for (auto &id : ids) {
+    found += idSet.count(id);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double idMs = std::chrono::duration<double, std::milli>(end - start).count();
+  ASSERT_EQ(numBundles, found);
+  start = std::chrono::steady_clock::now();
+  found = 0;
+  for (auto &key : keys) {
+    found += keySet.count(key);
+  }
+  end = std::chrono::steady_clock::now();
+  double keyMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  ASSERT_EQ(numBundles, found);
+  std::cout << "[ BENCH    ] " << numBundles << " lookups (string id): "
+            << idMs << " ms" << std::endl;
+  std::cout << "[ BENCH    ] " << numBundles << " lookups (key): " << keyMs
+            << " ms, " << sizeof(BundleKey) << " bytes per key" << std::endl;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CompressionMEBBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the CompressionMEB class.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/CompressionMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "gtest/gtest.h"
+
+/**
+ * Generates a JSON telemetry payload.
+ */
+static std::string generateTelemetry(size_t records) {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < records; ++i) {
+    ss << "{\"node\":\"node" << i % 10 << "\",\"time\":" << 1476700000 + i
+       << ",\"temperature\":" << 20 + i % 7 << ".5,\"battery\":"
+       << 90 - i % 13 << "},";
+  }
+  ss << "{}]";
+  return ss.str();
+}
+
+/**
+ * Compression benchmark, it prints the ratio and the time to compress and
+ * decompress 1MB of JSON telemetry at the fastest and default levels.
+ */
+TEST(CompressionMEBBenchmark, Compression) {
+  std::string payload = generateTelemetry(14000);
+  Bundle b("Source", "Destination", payload);
+  for (int level : {1, 6}) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<Bundle> compressed = b.compressPayload(level);
+    auto middle = std::chrono::steady_clock::now();
+    Bundle received(compressed->toRaw());
+    std::unique_ptr<Bundle> original = received.decompressPayload();
+    auto end = std::chrono::steady_clock::now();
+    ASSERT_EQ(payload.size(), original->getPayloadBlock()->getPayloadLength());
+    std::cout << "[ BENCH    ] Level " << level << ": " << payload.size()
+              << " bytes to " << compressed->getRawLength() << " bytes, "
+              << std::chrono::duration<double, std::milli>(middle - start)
+                  .count() << " ms to compress, "
+              << std::chrono::duration<double, std::milli>(end - middle)
+                  .count() << " ms to decompress" << std::endl;
+  }
+}
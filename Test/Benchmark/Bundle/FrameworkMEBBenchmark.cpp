@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE FrameworkMEBBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the FrameworkMEB class.
+ */
+
+#include <string>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <chrono>
+#include "gtest/gtest.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Utils/SDNV.h"
+#include "Bundle/FrameworkMEB.h"
+#include "Bundle/FrameworkExtension.h"
+
+/**
+ * Generates the metadata of a framework block in the text format of the
+ * first version.
+ */
+static std::string textMetadata(
+    uint8_t fwkId,
+    std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions,
+    nlohmann::json state) {
+  std::stringstream ss;
+  ss << fwkId << std::to_string(static_cast<uint8_t>(extensions.size()));
+  for (auto& ext : extensions) {
+    ss << ext.second->getFwkExtId() << ext.second->getCodeLength()
+       << ext.second->getSwSrcCode();
+  }
+  ss << state;
+  return ss.str();
+}
+
+TEST(FrameworkMEBBenchmark, Format) {
+  std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions;
+  extensions[0] = std::make_shared<FrameworkExtension>(
+      0, "bundle_state[\"discard\"] = false;");
+  extensions[4] = std::make_shared<FrameworkExtension>(
+      4, "return node_state[\"neighbours\"];");
+  nlohmann::json state;
+  for (int i = 0; i < 20; ++i) {
+    state["route"].push_back({{"node", "node" + std::to_string(i)},
+                              {"arrival", 580000000 + i},
+                              {"departure", 580000010 + i}});
+  }
+  state["forwarded"] = true;
+  MetadataExtensionBlock meb(
+      static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB),
+      textMetadata(1, extensions, state));
+  std::string textRaw = meb.toRaw();
+  std::string binaryRaw = FrameworkMEB(1, extensions, state).toRaw();
+  const int iterations = 1000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    ASSERT_EQ(state, FrameworkMEB(textRaw).getBundleState());
+  }
+  auto end = std::chrono::steady_clock::now();
+  double textMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    ASSERT_EQ(state, FrameworkMEB(binaryRaw).getBundleState());
+  }
+  end = std::chrono::steady_clock::now();
+  double binaryMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  std::cout << "[ BENCH    ] Framework MEB text: " << textRaw.size()
+            << " bytes, " << textMs / iterations << " ms per decode"
+            << std::endl;
+  std::cout << "[ BENCH    ] Framework MEB binary: " << binaryRaw.size()
+            << " bytes, " << binaryMs / iterations << " ms per decode"
+            << std::endl;
+  ASSERT_LT(binaryRaw.size(), textRaw.size());
+}
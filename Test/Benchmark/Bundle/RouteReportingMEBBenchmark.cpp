@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE RouteReportingMEBBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the RouteReportingMEB class.
+ */
+
+#include <string>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/BundleTypes.h"
+
+TEST(RouteReportingMEBBenchmark, Size) {
+  RouteReportingMEB rrm = RouteReportingMEB();
+  std::string text;
+  std::time_t t = 580000000;
+  for (int i = 0; i < 200; ++i) {
+    std::string node = "node" + std::to_string(i % 20);
+    rrm.addRouteInformation(node, t, t + 30);
+    text += (i == 0 ? "" : "\n") + node + "," + std::to_string(t) + ","
+        + std::to_string(t + 30);
+    t += 45;
+  }
+  ASSERT_EQ(text, rrm.getRouteReporting());
+  RouteReportingMEB rrm2 = RouteReportingMEB(rrm.toRaw());
+  ASSERT_EQ(text, rrm2.getRouteReporting());
+  std::cout << "[ BENCH    ] Route of 200 hops: text " << text.size()
+            << " bytes, binary " << rrm.getMetadata().size() << " bytes"
+            << std::endl;
+  ASSERT_LT(rrm.getMetadata().size() * 4, text.size());
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE FragmentReassemblerBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the FragmentReassembler class.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Node/BundleProcessor/FragmentReassembler.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "gtest/gtest.h"
+
+/**
+ * Generates a bundle with a replicated and a not replicated block.
+ */
+static std::unique_ptr<Bundle> generateBundle(size_t payloadLength) {
+  std::string payload;
+  for (size_t i = 0; i < payloadLength; ++i) {
+    payload.push_back('a' + i % 26);
+  }
+  std::unique_ptr<Bundle> b(new Bundle("Source", "Destination:1", payload));
+  std::shared_ptr<RouteReportingMEB> replicated(new RouteReportingMEB());
+  replicated->setProcFlag(CanonicalBlockControlFlags::REPLICATE_FRAGMENT);
+  b->addBlock(replicated);
+  std::shared_ptr<RouteReportingMEB> last(new RouteReportingMEB());
+  last->addRouteInformation("node1", 10, 20);
+  b->addBlock(last);
+  return b;
+}
+
+/**
+ * Reassembly benchmark, it prints the time to join a 16MB bundle received in
+ * 4KB fragments in random order.
+ */
+TEST(FragmentReassemblerBenchmark, Reassemble) {
+  std::unique_ptr<Bundle> b = generateBundle(16 * 1024 * 1024);
+  std::string raw = b->toRaw();
+  std::vector<std::unique_ptr<Bundle>> fragments = b->fragment(4096);
+  std::shuffle(fragments.begin(), fragments.end(), std::mt19937(42));
+  FragmentReassembler reassembler;
+  std::unique_ptr<Bundle> whole;
+  auto start = std::chrono::steady_clock::now();
+  for (auto &fragment : fragments) {
+    whole = reassembler.addFragment(*fragment);
+  }
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_NE(nullptr, whole);
+  ASSERT_EQ(raw.size(), whole->toRaw().size());
+  std::cout << "[ BENCH    ] Reassembly of " << fragments.size()
+            << " fragments: "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms" << std::endl;
+}
@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleQueueBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the BundleQueue class.
+ */
+
+#include <dirent.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Node/BundleQueue/BundleContainer.h"
+#include "Node/BundleQueue/BundleQueue.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Utils/Arena.h"
+#include "Utils/Logger.h"
+#include "gtest/gtest.h"
+
+extern std::atomic<uint64_t> g_allocations;
+
+/**
+ * Counts the allocations of parsing, enqueuing, dequeuing and discarding
+ * bundles with and without arena.
+ */
+static uint64_t queueAllocations(const std::string raws[2], int iterations,
+                                 bool useArena) {
+  BundleQueue queue = BundleQueue("/tmp", "/tmp", 100 * 1024 * 1024);
+  uint64_t start = g_allocations;
+  for (int i = 0; i < iterations; ++i) {
+    std::shared_ptr<Arena> arena;
+    if (useArena) {
+      arena = std::make_shared<Arena>();
+    }
+    std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
+        new Bundle(raws[i % 2], arena));
+    b->getBlocks();
+    std::unique_ptr<BundleContainer> bc = std::unique_ptr<BundleContainer>(
+        new BundleContainer(std::move(b)));
+    queue.enqueue(std::move(bc));
+    queue.dequeue();
+  }
+  return (g_allocations - start) / iterations;
+}
+
+TEST(BundleQueueBenchmark, ArenaAllocation) {
+  std::string raws[2];
+  for (int i = 0; i < 2; ++i) {
+    Bundle b("Me", "Someone", "This is a test bundle " + std::to_string(i));
+    b.addBlock(std::make_shared<RoutingSelectionMEB>(0x01));
+    b.addBlock(std::make_shared<ForwardingMEB>("code"));
+    b.addBlock(std::make_shared<RouteReportingMEB>("node", time(NULL),
+                                                   time(NULL)));
+    raws[i] = b.toRaw();
+  }
+  const int iterations = 1000;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  uint64_t heap = queueAllocations(raws, iterations, false);
+  uint64_t arena = queueAllocations(raws, iterations, true);
+  Logger::getInstance()->setLogLevel(logLevel);
+  std::cout << "[ BENCH    ] Allocations per bundle (heap): " << heap
+            << std::endl;
+  std::cout << "[ BENCH    ] Allocations per bundle (arena): " << arena
+            << std::endl;
+  ASSERT_LT(arena, heap);
+}
+
+/**
+ * Returns the resident memory of the process, without the freed memory kept
+ * by the allocator.
+ */
+static size_t residentBytes() {
+  malloc_trim(0);
+  std::ifstream statm("/proc/self/statm");
+  size_t pages, resident;
+  statm >> pages >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Memory benchmark, it fills a queue with received, created and restored
+ * bundles and prints the resident memory used per queued byte.
+ */
+TEST(BundleQueueBenchmark, Memory) {
+  const uint64_t queueByteSize = 64 * 1024 * 1024;
+  const size_t payloadSize = 256 * 1024;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  size_t before = residentBytes();
+  uint64_t queued = 0;
+  {
+    BundleQueue queue("/tmp/", "/tmp/", queueByteSize);
+    for (int i = 0; queued + payloadSize < queueByteSize; ++i) {
+      std::unique_ptr<Bundle> b(new Bundle("Me", "Someone",
+                                           std::string(payloadSize, 'a' + i % 26)));
+      std::unique_ptr<BundleContainer> bc;
+      switch (i % 3) {
+        case 0: {
+          // Received from a neighbour.
+          std::string raw = b->toRaw();
+          b.reset();
+          bc.reset(new BundleContainer(
+              std::unique_ptr<Bundle>(new Bundle(std::move(raw)))));
+          break;
+        }
+        case 1: {
+          // Created into this node.
+          b->toRaw();
+          bc.reset(new BundleContainer(std::move(b)));
+          break;
+        }
+        default: {
+          // Restored from disk.
+          std::string data = BundleContainer(std::move(b)).serialize();
+          bc.reset(new BundleContainer(data));
+          break;
+        }
+      }
+      queued += bc->getBundle().getRawLength();
+      queue.enqueue(std::move(bc));
+    }
+    size_t after = residentBytes();
+    double ratio = static_cast<double>(after - before) / queued;
+    std::cout << "[ BENCH    ] Resident memory of a queue of " << queued
+              << " bytes: " << (after - before) << " bytes, " << ratio
+              << " per queued byte" << std::endl;
+    ASSERT_LT(ratio, 1.25);
+  }
+  Logger::getInstance()->setLogLevel(logLevel);
+}
+
+/**
+ * Drop policy benchmark, it fills a queue with small bundles and prints the
+ * mean time to enqueue a bundle that needs to drop another one.
+ */
+TEST(BundleQueueBenchmark, DropPolicy) {
+  const int queued = 2000;
+  const int iterations = 50;
+  char dropPath[] = "/tmp/adtnDropXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(dropPath));
+  std::string path = std::string(dropPath) + "/";
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  std::vector<std::string> raws;
+  for (int i = 0; i < queued + iterations; ++i) {
+    Bundle b("Me", "Someone", "Bundle " + std::to_string(100000 + i));
+    b.addBlock(std::make_shared<RoutingSelectionMEB>(0x01));
+    b.addBlock(std::make_shared<RouteReportingMEB>("node", time(NULL),
+                                                   time(NULL)));
+    raws.push_back(b.toRaw());
+  }
+  uint64_t queueByteSize = 0;
+  for (int i = 0; i < queued; ++i) {
+    queueByteSize += raws[i].size();
+  }
+  // The drop policy of the queue and the same policy as a custom one, that
+  // sorts all the bundles.
+  for (bool custom : { false, true }) {
+    BundleQueue queue(path, path, queueByteSize);
+    for (int i = 0; i < queued; ++i) {
+      queue.enqueue(std::unique_ptr<BundleContainer>(new BundleContainer(
+          std::unique_ptr<Bundle>(new Bundle(raws[i])))));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = queued; i < queued + iterations; ++i) {
+      std::unique_ptr<BundleContainer> bc(new BundleContainer(
+          std::unique_ptr<Bundle>(new Bundle(raws[i]))));
+      if (custom) {
+        queue.enqueue(std::move(bc), false, compare());
+      } else {
+        queue.enqueue(std::move(bc), false);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "[ BENCH    ] Enqueue with " << (custom ? "custom" : "indexed")
+              << " drop into a queue of " << queued << " bundles: "
+              << std::chrono::duration<double, std::milli>(end - start).count()
+                  / iterations << " ms" << std::endl;
+    ASSERT_GT(static_cast<uint32_t>(queued + iterations), queue.getSize());
+  }
+  Logger::getInstance()->setLogLevel(logLevel);
+  DIR *dir = opendir(dropPath);
+  ASSERT_NE(nullptr, dir);
+  std::vector<std::string> dropped;
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      dropped.push_back(path + entry->d_name);
+    }
+  }
+  closedir(dir);
+  for (auto &file : dropped) {
+    std::remove(file.c_str());
+  }
+  ASSERT_EQ(0, rmdir(dropPath));
+}
+
+/**
+ * Generates a bundle container with the given priority and lifetime.
+ */
+static std::unique_ptr<BundleContainer> priorityBundle(
+    const std::string &payload, PrimaryBlockControlFlags priority,
+    uint64_t lifetime) {
+  std::unique_ptr<Bundle> b(new Bundle("Me", "Someone", payload));
+  b->getPrimaryBlock()->setPrimaryProcFlag(priority);
+  b->getPrimaryBlock()->setLifetime(lifetime);
+  return std::unique_ptr<BundleContainer>(new BundleContainer(std::move(b)));
+}
+
+/**
+ * Priority queue benchmark, it prints the mean time to enqueue and dequeue
+ * a bundle with a queue of different sizes.
+ */
+TEST(BundleQueueBenchmark, PriorityQueue) {
+  const PrimaryBlockControlFlags priorities[] = {
+      PrimaryBlockControlFlags::PRIORITY_BULK,
+      PrimaryBlockControlFlags::PRIORITY_NORMAL,
+      PrimaryBlockControlFlags::PRIORITY_EXPEDITED };
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  for (int queued : { 1000, 10000, 100000 }) {
+    BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024 * 1024, true);
+    std::vector<std::unique_ptr<BundleContainer>> bundles;
+    for (int i = 0; i < queued; ++i) {
+      bundles.push_back(priorityBundle(std::to_string(i), priorities[i % 3],
+                                       1000 + (i * 7919) % 5000));
+      // The information is cached outside the measure.
+      bundles.back()->getInfo();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (auto &bc : bundles) {
+      queue.enqueue(std::move(bc));
+    }
+    uint64_t lastRank = 0;
+    for (int i = 0; i < queued; ++i) {
+      std::unique_ptr<BundleContainer> bc = queue.dequeue();
+      uint64_t rank = 2 - bc->getInfo()->getPriority();
+      ASSERT_LE(lastRank, rank);
+      lastRank = rank;
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "[ BENCH    ] Enqueue and dequeue with " << queued
+              << " bundles: "
+              << std::chrono::duration<double, std::micro>(end - start).count()
+                  / queued << " us per bundle" << std::endl;
+  }
+  Logger::getInstance()->setLogLevel(logLevel);
+}
+
+/**
+ * Generates a bundle container with the given creation time and lifetime.
+ */
+static std::unique_ptr<BundleContainer> policyBundle(
+    const std::string &payload, uint64_t timestamp, uint64_t lifetime) {
+  static uint64_t sequence = 0;
+  std::unique_ptr<Bundle> b(new Bundle("Me", "Someone", payload));
+  b->getPrimaryBlock()->setTimestamp(std::make_pair(timestamp, sequence++));
+  b->getPrimaryBlock()->setLifetime(lifetime);
+  return std::unique_ptr<BundleContainer>(new BundleContainer(std::move(b)));
+}
+
+/**
+ * Posts the bundles from the given number of threads while one thread
+ * dequeues them, and returns the time in milliseconds until all the bundles
+ * are received and until all are dequeued.
+ */
+static std::pair<double, double> postConcurrently(
+    BundleQueue &queue, std::vector<std::unique_ptr<BundleContainer>> &bundles,
+    int producers, bool post) {
+  std::atomic<bool> start(false);
+  std::atomic<int> finished(0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.push_back(std::thread([&, p]() {
+      while (!start) {
+        std::this_thread::yield();
+      }
+      for (size_t i = p; i < bundles.size(); i += producers) {
+        if (post) {
+          queue.post(std::move(bundles[i]));
+        } else {
+          queue.enqueue(std::move(bundles[i]));
+        }
+      }
+      finished++;
+    }));
+  }
+  size_t dequeued = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto received = begin;
+  start = true;
+  while (dequeued < bundles.size()) {
+    if (received == begin && finished == producers) {
+      received = std::chrono::steady_clock::now();
+    }
+    try {
+      queue.wait_for(5);
+      queue.dequeue();
+      dequeued++;
+    } catch (const EmptyBundleQueueException &e) {
+      if (finished == producers) {
+        break;
+      }
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(bundles.size(), dequeued);
+  if (received == begin) {
+    received = end;
+  }
+  return std::make_pair(
+      std::chrono::duration<double, std::milli>(received - begin).count(),
+      std::chrono::duration<double, std::milli>(end - begin).count());
+}
+
+/**
+ * Ingest benchmark, it prints the time to receive the bundles from 64
+ * threads while they are dequeued, posting and enqueuing them.
+ */
+TEST(BundleQueueBenchmark, Ingest) {
+  const int producers = 64;
+  const int total = 64000;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  for (bool post : { false, true }) {
+    std::vector<std::unique_ptr<BundleContainer>> bundles;
+    for (int i = 0; i < total; ++i) {
+      bundles.push_back(priorityBundle(std::to_string(i),
+                                       PrimaryBlockControlFlags::PRIORITY_BULK,
+                                       100));
+      bundles.back()->getInfo();
+    }
+    BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024 * 1024);
+    std::pair<double, double> time = postConcurrently(queue, bundles,
+                                                      producers, post);
+    std::cout << "[ BENCH    ] " << (post ? "Post" : "Enqueue") << " from "
+              << producers << " threads: " << time.first * 1000 / total
+              << " us per bundle received, " << time.second * 1000 / total
+              << " us per bundle dequeued" << std::endl;
+  }
+  Logger::getInstance()->setLogLevel(logLevel);
+}
+
+/**
+ * Generates a bundle container to the given destination, that was last
+ * forwarded to the given nodes.
+ */
+static std::unique_ptr<BundleContainer> contactBundle(
+    const std::string &payload, const std::string &destination,
+    const std::vector<std::string> &nextHops = { }) {
+  std::unique_ptr<BundleContainer> bc(new BundleContainer(
+      std::unique_ptr<Bundle>(new Bundle("Me", destination, payload))));
+  bc->setNextHops(nextHops);
+  return bc;
+}
+
+/**
+ * Contact benchmark, it prints the time to wake the bundles of a contact
+ * with the index, and by checking all the queue.
+ */
+TEST(BundleQueueBenchmark, ScheduleContact) {
+  const int queued = 50000;
+  const int nodes = 1000;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024 * 1024);
+  for (int i = 0; i < queued; ++i) {
+    queue.enqueue(contactBundle(std::to_string(i), "node"
+        + std::to_string(i % nodes) + ":app"));
+  }
+  // Index, the scheduled bundles are processed and enqueued again.
+  auto start = std::chrono::steady_clock::now();
+  uint32_t scheduled = queue.schedule({ "node7" });
+  for (uint32_t i = 0; i < scheduled; ++i) {
+    std::unique_ptr<BundleContainer> bc = queue.dequeueScheduled();
+    queue.resetLast();
+    queue.enqueue(std::move(bc));
+  }
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(static_cast<uint32_t>(queued / nodes), scheduled);
+  double indexed = std::chrono::duration<double, std::milli>(
+      end - start).count();
+  // All the queue, every bundle is checked and enqueued again.
+  start = std::chrono::steady_clock::now();
+  uint32_t matched = 0;
+  for (int i = 0; i < queued; ++i) {
+    std::unique_ptr<BundleContainer> bc = queue.dequeue();
+    if (bc->getInfo()->getDestination() == "node7:app") {
+      matched++;
+    }
+    queue.resetLast();
+    queue.enqueue(std::move(bc));
+  }
+  end = std::chrono::steady_clock::now();
+  ASSERT_EQ(scheduled, matched);
+  Logger::getInstance()->setLogLevel(logLevel);
+  std::cout << "[ BENCH    ] Contact with " << queued << " queued bundles: "
+            << indexed << " ms indexed, "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms checking the queue" << std::endl;
+}
+
+/**
+ * Expiration benchmark, it prints the time to remove the expired bundles
+ * with the wheel, and by checking all the queue.
+ */
+TEST(BundleQueueBenchmark, ExpireBundles) {
+  const int queued = 50000;
+  const int expiring = 500;
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024 * 1024);
+  // A few bundles expire each second.
+  for (int i = 0; i < queued; ++i) {
+    queue.enqueue(policyBundle(std::to_string(i), 1000, i / expiring));
+  }
+  auto start = std::chrono::steady_clock::now();
+  size_t expired = queue.expire(1001).size();
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(static_cast<size_t>(expiring), expired);
+  double wheel = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  // All the queue, every bundle is checked and enqueued again.
+  start = std::chrono::steady_clock::now();
+  expired = 0;
+  for (int i = 0; i < queued - expiring; ++i) {
+    std::unique_ptr<BundleContainer> bc = queue.dequeue();
+    queue.resetLast();
+    if (bc->getInfo()->getDeadline() < 1002) {
+      expired++;
+    } else {
+      queue.enqueue(std::move(bc));
+    }
+  }
+  end = std::chrono::steady_clock::now();
+  ASSERT_EQ(static_cast<size_t>(expiring), expired);
+  Logger::getInstance()->setLogLevel(logLevel);
+  std::cout << "[ BENCH    ] Expiration with " << queued << " queued bundles: "
+            << wheel << " ms with the wheel, "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms checking the queue" << std::endl;
+}
+
+/**
+ * Returns the files of a directory.
+ */
+static std::vector<std::string> listDirectory(const std::string &path) {
+  std::vector<std::string> files;
+  DIR *dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return files;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      files.push_back(path + entry->d_name);
+    }
+  }
+  closedir(dir);
+  return files;
+}
+
+/**
+ * Paging benchmark, it prints the memory of the queued bundles and the time
+ * to enqueue and dequeue a bundle, with and without paging.
+ */
+TEST(BundleQueueBenchmark, Paging) {
+  const int queued = 10000;
+  const uint64_t memoryByteSize = 1024 * 1024;
+  char pagePath[] = "/tmp/adtnPageXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(pagePath));
+  std::string path = std::string(pagePath) + "/";
+  int logLevel = Logger::getInstance()->logLevel();
+  Logger::getInstance()->setLogLevel(0);
+  std::string payload(1024, 'a');
+  for (bool paging : { false, true }) {
+    BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024 * 1024);
+    if (paging) {
+      queue.setPaging(path, memoryByteSize);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < queued; ++i) {
+      queue.enqueue(contactBundle(payload + std::to_string(i), "node1:app"));
+    }
+    uint64_t memory = queue.getMemoryByteSize();
+    for (int i = 0; i < queued; ++i) {
+      queue.dequeue();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (paging) {
+      ASSERT_GE(memoryByteSize, memory);
+    }
+    std::cout << "[ BENCH    ] " << (paging ? "Paging" : "No paging")
+              << " with " << queued << " queued bundles: " << memory
+              << " bytes in memory, "
+              << std::chrono::duration<double, std::micro>(end - start).count()
+                  / queued << " us per bundle" << std::endl;
+  }
+  Logger::getInstance()->setLogLevel(logLevel);
+  for (auto &file : listDirectory(path)) {
+    std::remove(file.c_str());
+  }
+  ASSERT_EQ(0, rmdir(pagePath));
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CRC32CBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the CRC32C class.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "Utils/CRC32C.h"
+#include "gtest/gtest.h"
+
+/**
+ * CRC32C benchmark, it prints the throughput of the processor instructions
+ * and the tables.
+ */
+TEST(CRC32CBenchmark, Checksum) {
+  std::string data(64 * 1024 * 1024, 'a');
+  auto start = std::chrono::steady_clock::now();
+  uint32_t hardware = CRC32C::compute(data.data(), data.size());
+  auto middle = std::chrono::steady_clock::now();
+  uint32_t portable = CRC32C::extendPortable(0, data.data(), data.size());
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(hardware, portable);
+  double hardwareTime = std::chrono::duration<double>(middle - start).count();
+  double portableTime = std::chrono::duration<double>(end - middle).count();
+  std::cout << "[ BENCH    ] CRC32C of 64MB: "
+            << (CRC32C::isHardwareAccelerated() ? "instructions " : "tables ")
+            << 64 / hardwareTime << " MB/s, tables " << 64 / portableTime
+            << " MB/s" << std::endl;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE SDNVBenchmark.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the benchmarks of the SDNV class.
+ */
+
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "Utils/SDNV.h"
+#include "gtest/gtest.h"
+
+/**
+ * Measures the decoding throughput of the single and batch pointer APIs
+ * over a run of primary block like fields.
+ */
+TEST(SDNVBenchmark, Throughput) {
+  const size_t numValues = 1 << 20;
+  std::vector<uint64_t> values(numValues);
+  std::stringstream ss;
+  for (size_t i = 0; i < numValues; ++i) {
+    values[i] = (i * 2654435761u) >> (i % 40);
+    ss << SDNV::encode(values[i]);
+  }
+  std::string coded = ss.str();
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(coded.data());
+  auto start = std::chrono::steady_clock::now();
+  size_t offset = 0;
+  for (size_t i = 0; i < numValues; ++i) {
+    uint64_t value = 0;
+    offset += SDNV::decode(data + offset, data + coded.size(), value);
+    ASSERT_EQ(values[i], value);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double singleMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  std::vector<uint64_t> decoded(numValues);
+  start = std::chrono::steady_clock::now();
+  ASSERT_EQ(coded.size(),
+            SDNV::decode(data, data + coded.size(), decoded.data(),
+                         numValues));
+  end = std::chrono::steady_clock::now();
+  double batchMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  ASSERT_EQ(values, decoded);
+  std::vector<uint8_t> buffer(numValues * SDNV::MAX_LENGTH);
+  start = std::chrono::steady_clock::now();
+  uint8_t *position = buffer.data();
+  for (size_t i = 0; i < numValues; ++i) {
+    position += SDNV::encode(values[i], position,
+                             buffer.data() + buffer.size());
+  }
+  end = std::chrono::steady_clock::now();
+  double encodeMs = std::chrono::duration<double, std::milli>(end - start)
+      .count();
+  ASSERT_EQ(coded.size(), static_cast<size_t>(position - buffer.data()));
+  std::cout << "[ BENCH    ] SDNV decode (single): "
+            << numValues / singleMs / 1000 << " M values/s" << std::endl;
+  std::cout << "[ BENCH    ] SDNV decode (batch): "
+            << numValues / batchMs / 1000 << " M values/s" << std::endl;
+  std::cout << "[ BENCH    ] SDNV encode (buffer): "
+            << numValues / encodeMs / 1000 << " M values/s" << std::endl;
+}
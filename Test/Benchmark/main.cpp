@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE main.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the call to start all the benchmarks, and the count of
+ * the heap allocations that they use.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "gtest/gtest.h"
+#include "Utils/Logger.h"
+#include "Utils/globals.h"
+
+std::atomic<bool> g_stop;
+std::atomic<uint16_t> g_stopped;
+std::atomic<uint16_t> g_startedThread;
+std::mutex g_processorMutex;
+std::condition_variable g_processorConditionVariable;
+std::atomic<uint32_t> g_queueProcessEvents;
+/**
+ * Number of heap allocations done by the benchmark binary.
+ */
+std::atomic<uint64_t> g_allocations(0);
+/**
+ * Number of bytes requested by those heap allocations.
+ */
+std::atomic<uint64_t> g_allocatedBytes(0);
+
+/**
+ * Counts an allocation and returns the memory.
+ */
+static void* allocate(size_t size) {
+  ++g_allocations;
+  g_allocatedBytes += size;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new(size_t size) {
+  return allocate(size);
+}
+
+void* operator new[](size_t size) {
+  return allocate(size);
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+  std::free(p);
+}
+
+GTEST_API_ int main(int argc, char **argv) {
+  g_stop = false;
+  std::cout << "Runing benchmarks" << std::endl;
+  testing::InitGoogleTest(&argc, argv);
+  std::cout << "Starting Logger" << std::endl;
+  Logger::getInstance()->setLoggerConfigAndStart("/tmp/adtn-benchmark.log");
+  Logger::getInstance()->setLogLevel(100);
+  int ret = RUN_ALL_TESTS();
+  delete Logger::getInstance();
+  return ret;
+}
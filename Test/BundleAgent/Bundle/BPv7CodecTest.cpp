@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BPv7CodecTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the BPv7 codec.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Utils/MappedFile.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that a bundle encoded in BPv7 is decoded into the same fields, and
+ * that the encoding is detected.
+ */
+TEST(BPv7CodecTest, RoundTrip) {
+  Bundle b("node1:100", "node2:200", "This is the payload");
+  b.getPrimaryBlock()->setReportTo("node3");
+  b.getPrimaryBlock()->setLifetime(7200);
+  b.getPrimaryBlock()->setPrimaryProcFlag(
+      PrimaryBlockControlFlags::NOT_FRAGMENTED);
+  b.getPrimaryBlock()->setPrimaryProcFlag(
+      PrimaryBlockControlFlags::PRIORITY_EXPEDITED);
+  b.addBlock(std::shared_ptr<ForwardingMEB>(new ForwardingMEB("code")));
+  std::string raw5050 = b.toRaw();
+  std::string rawBPv7 = b.toRaw(BundleEncoding::BPV7);
+  ASSERT_EQ(0x06, raw5050[0]);
+  ASSERT_EQ('\x9F', rawBPv7[0]);
+  ASSERT_EQ('\x89', rawBPv7[1]);
+  ASSERT_EQ('\x07', rawBPv7[2]);
+  ASSERT_EQ('\xFF', rawBPv7.back());
+  ASSERT_EQ(raw5050, b.toRaw(BundleEncoding::RFC5050));
+  ASSERT_NE(std::string::npos, rawBPv7.find("//node2/200"));
+  Bundle decoded(rawBPv7);
+  std::shared_ptr<PrimaryBlock> primary = decoded.getPrimaryBlock();
+  ASSERT_EQ("node1:100", primary->getSource());
+  ASSERT_EQ("node2:200", primary->getDestination());
+  ASSERT_EQ("node3", primary->getReportTo());
+  ASSERT_EQ(b.getPrimaryBlock()->getCustodian(), primary->getCustodian());
+  ASSERT_EQ(7200u, primary->getLifetime());
+  ASSERT_EQ(b.getPrimaryBlock()->getCreationTimestamp(),
+            primary->getCreationTimestamp());
+  ASSERT_TRUE(primary->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::NOT_FRAGMENTED));
+  // BPv7 has no priority.
+  ASSERT_FALSE(primary->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::PRIORITY_EXPEDITED));
+  ASSERT_TRUE(b.getKey() == decoded.getKey());
+  // The payload block is the last one.
+  ASSERT_EQ("This is the payload", decoded.getPayloadBlock()->getPayload());
+  ASSERT_EQ(decoded.getPayloadBlock(), decoded.getBlocks().back());
+  ASSERT_EQ("code", std::static_pointer_cast<ForwardingMEB>(
+      decoded.getBlocks()[1])->getSoftCode());
+  // The BPv7 encoding is generated again byte by byte.
+  ASSERT_EQ(rawBPv7, decoded.toRaw(BundleEncoding::BPV7));
+  Bundle decoded5050(raw5050);
+  ASSERT_EQ(rawBPv7, decoded5050.toRaw(BundleEncoding::BPV7));
+  // The block data is not copied into the segments.
+  std::vector<RawSegment> segments = decoded5050.toRawSegments(
+      BundleEncoding::BPV7);
+  ASSERT_EQ(5u, segments.size());
+  ASSERT_EQ(decoded5050.toRawSegments()[0].buffer, segments[1].buffer);
+}
+
+/**
+ * Check that the bundles with custody are not encoded in BPv7.
+ */
+TEST(BPv7CodecTest, CustodianRefused) {
+  Bundle b("node1:100", "node2:200", "This is the payload");
+  b.getPrimaryBlock()->setCustodian("node4");
+  ASSERT_THROW(b.toRaw(BundleEncoding::BPV7), BundleException);
+  Bundle b1("node1:100", "node2:200", "This is the payload");
+  b1.getPrimaryBlock()->setPrimaryProcFlag(
+      PrimaryBlockControlFlags::CUSTODY_TRANSFER);
+  ASSERT_THROW(b1.toRaw(BundleEncoding::BPV7), BundleException);
+}
+
+/**
+ * Check the endpoint schemes and the fragments.
+ */
+TEST(BPv7CodecTest, EndpointsAndFragments) {
+  Bundle b("ipn:5.1", "node2", std::string(1000, 'a'));
+  std::string rawBPv7 = b.toRaw(BundleEncoding::BPV7);
+  ASSERT_NE(std::string::npos, rawBPv7.find("//node2/"));
+  Bundle decoded(rawBPv7);
+  ASSERT_EQ("ipn:5.1", decoded.getPrimaryBlock()->getSource());
+  ASSERT_EQ("node2", decoded.getPrimaryBlock()->getDestination());
+  ASSERT_EQ("none", decoded.getPrimaryBlock()->getReportTo());
+  ASSERT_EQ(b.toRaw(), decoded.toRaw());
+  std::vector<std::unique_ptr<Bundle>> fragments = b.fragment(400);
+  ASSERT_LT(1u, fragments.size());
+  for (auto &fragment : fragments) {
+    std::string rawFragment = fragment->toRaw(BundleEncoding::BPV7);
+    ASSERT_EQ('\x8B', rawFragment[1]);
+    Bundle decodedFragment(rawFragment);
+    ASSERT_TRUE(fragment->getKey() == decodedFragment.getKey());
+    ASSERT_EQ(fragment->getPrimaryBlock()->getTotalApplicationDataLength(),
+              decodedFragment.getPrimaryBlock()
+                  ->getTotalApplicationDataLength());
+    ASSERT_EQ(fragment->toRaw(), decodedFragment.toRaw());
+  }
+}
+
+/**
+ * Check that the IntegrityMEB is replaced by the CRCs of the blocks, and
+ * that the BPv7 bundles are read from a mapped file.
+ */
+TEST(BPv7CodecTest, CRCsAndFiles) {
+  Bundle b("Source", "Destination", std::string(1000, 'a'));
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  b.addChecksums();
+  std::string rawBPv7 = b.toRaw(BundleEncoding::BPV7);
+  Bundle decoded(rawBPv7);
+  ASSERT_FALSE(decoded.hasChecksums());
+  ASSERT_EQ(3u, decoded.getBlocks().size());
+  std::string damaged = rawBPv7;
+  damaged[damaged.size() - 100] = 'b';
+  ASSERT_THROW(Bundle bad(damaged), BundleCreationException);
+  {
+    std::ofstream file("/tmp/bpv7CodecTest", std::ofstream::binary);
+    file << rawBPv7;
+  }
+  std::shared_ptr<const MappedFile> file = std::make_shared<MappedFile>(
+      "/tmp/bpv7CodecTest");
+  std::remove("/tmp/bpv7CodecTest");
+  Bundle mapped(file);
+  ASSERT_EQ(decoded.toRaw(), mapped.toRaw());
+  ASSERT_EQ(rawBPv7, mapped.toRaw(BundleEncoding::BPV7));
+}
+
+/**
+ * Check a bundle generated by another BPv7 agent, with a CRC-16 in the
+ * primary block and no CRC in the payload block.
+ */
+TEST(BPv7CodecTest, Interoperability) {
+  std::string primary(
+      "\x9F\x89\x07\x00\x01\x82\x01\x6A\x2F\x2F\x64\x65\x73\x74\x2F\x61\x70"
+      "\x70\x82\x01\x66\x2F\x2F\x73\x72\x63\x2F\x82\x01\x00\x82\x19\x03\xE8"
+      "\x00\x1A\x00\x36\xEE\x80\x42\xD0\x55", 43);
+  std::string payload("\x85\x01\x01\x00\x00\x45hello", 11);
+  Bundle b(primary + payload + '\xFF');
+  ASSERT_EQ("src", b.getPrimaryBlock()->getSource());
+  ASSERT_EQ("dest:app", b.getPrimaryBlock()->getDestination());
+  ASSERT_EQ("none", b.getPrimaryBlock()->getReportTo());
+  ASSERT_EQ(1u, b.getPrimaryBlock()->getCreationTimestamp());
+  ASSERT_EQ(3600u, b.getPrimaryBlock()->getLifetime());
+  ASSERT_EQ("hello", b.getPayloadBlock()->getPayload());
+  std::string badCRC = primary;
+  badCRC[primary.size() - 1] = '\x56';
+  ASSERT_THROW(Bundle bad(badCRC + payload + '\xFF'),
+               BundleCreationException);
+  ASSERT_THROW(Bundle bad(primary + payload + payload + '\xFF'),
+               BundleCreationException);
+}
+
+/**
+ * Check that the bad BPv7 bundles are rejected.
+ */
+TEST(BPv7CodecTest, BadBundles) {
+  std::string rawBPv7 = Bundle("Source", "Destination", "Payload").toRaw(
+      BundleEncoding::BPV7);
+  for (size_t i = 1; i < rawBPv7.size(); ++i) {
+    ASSERT_THROW(Bundle(rawBPv7.substr(0, i)), BundleCreationException);
+  }
+  ASSERT_THROW(Bundle(rawBPv7 + '\x00'), BundleCreationException);
+  // Only the version 7 is decoded as BPv7.
+  std::string badVersion = rawBPv7;
+  badVersion[2] = '\x06';
+  ASSERT_THROW(Bundle bad(badVersion), BundleCreationException);
+  // The EID references can not be encoded.
+  std::string raw = PrimaryBlock("Source", "Destination", 0, 0).toRaw()
+      + PayloadBlock("Payload").toRaw()
+      + std::string("\x09\x48\x01\x00\x00\x01x", 7);
+  Bundle b(raw);
+  ASSERT_THROW(b.toRaw(BundleEncoding::BPV7), BundleException);
+}
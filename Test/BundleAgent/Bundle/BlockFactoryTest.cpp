@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BlockFactoryTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the BlockFactory class.
+ */
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Bundle/BlockFactory.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/CanonicalBlock.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/CodeDataCarrierMEB.h"
+#include "Bundle/FrameworkMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Utils/Logger.h"
+#include "gtest/gtest.h"
+
+/**
+ * Metadata extension block defined outside of the library.
+ */
+class TestMEB : public MetadataExtensionBlock {
+ public:
+  static const uint8_t TYPE = 0x7A;
+
+  explicit TestMEB(const std::string &data)
+      : MetadataExtensionBlock(TYPE, data) {
+  }
+
+  TestMEB(const std::shared_ptr<const std::string> &buffer, size_t offset)
+      : MetadataExtensionBlock(buffer, offset) {
+  }
+};
+
+const uint8_t TestMEB::TYPE;
+
+/**
+ * Check that the library blocks are generated with their class.
+ */
+TEST(BlockFactoryTest, LibraryBlocks) {
+  Bundle b("Source", "Destination", "Payload");
+  b.addBlock(std::make_shared<RoutingSelectionMEB>(0x01));
+  b.addBlock(std::make_shared<ForwardingMEB>("code"));
+  b.addBlock(std::make_shared<RouteReportingMEB>("node", time(NULL),
+                                                 time(NULL)));
+  b.addBlock(std::make_shared<CodeDataCarrierMEB>("code", "{\"a\":1}"));
+  b.addBlock(std::make_shared<MetadataExtensionBlock>(0x7B, "unknown"));
+  Bundle b1(b.toRaw());
+  std::vector<std::shared_ptr<Block>> blocks = b1.getBlocks();
+  ASSERT_EQ(7u, blocks.size());
+  ASSERT_TRUE(std::dynamic_pointer_cast<PayloadBlock>(blocks[1]) != nullptr);
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<RoutingSelectionMEB>(blocks[2]) != nullptr);
+  ASSERT_TRUE(std::dynamic_pointer_cast<ForwardingMEB>(blocks[3]) != nullptr);
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<RouteReportingMEB>(blocks[4]) != nullptr);
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<CodeDataCarrierMEB>(blocks[5]) != nullptr);
+  std::shared_ptr<MetadataExtensionBlock> generic = std::dynamic_pointer_cast<
+      MetadataExtensionBlock>(blocks[6]);
+  ASSERT_TRUE(generic != nullptr);
+  ASSERT_EQ(0x7B, generic->getMetadataType());
+  ASSERT_EQ(b.toRaw(), b1.toRaw());
+}
+
+/**
+ * Check that a new metadata type can be registered and removed.
+ */
+TEST(BlockFactoryTest, RegisterMetadataBlock) {
+  Bundle b("Source", "Destination", "Payload");
+  b.addBlock(std::make_shared<TestMEB>("test data"));
+  std::string raw = b.toRaw();
+  BlockFactory::getInstance()->registerMetadataBlock<TestMEB>(TestMEB::TYPE);
+  Bundle b1(raw);
+  std::shared_ptr<Block> block = b1.getBlocks()[2];
+  ASSERT_TRUE(std::dynamic_pointer_cast<TestMEB>(block) != nullptr);
+  ASSERT_EQ("test data",
+            std::static_pointer_cast<TestMEB>(block)->getMetadata());
+  BlockFactory::getInstance()->registerMetadataBlock(TestMEB::TYPE, nullptr);
+  Bundle b2(raw);
+  block = b2.getBlocks()[2];
+  ASSERT_TRUE(std::dynamic_pointer_cast<TestMEB>(block) == nullptr);
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<MetadataExtensionBlock>(block) != nullptr);
+  ASSERT_THROW(
+      BlockFactory::getInstance()->registerCanonicalBlock<CanonicalBlock>(
+          static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK)),
+      std::invalid_argument);
+}
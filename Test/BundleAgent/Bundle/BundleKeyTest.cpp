@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE BundleKeyTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the BundleKey class.
+ */
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleKey.h"
+#include "Bundle/PrimaryBlock.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the key fields, the string form and the interning of the source.
+ */
+TEST(BundleKeyTest, Fields) {
+  BundleKey key("node100", 12345, 2);
+  ASSERT_TRUE(key.isValid());
+  ASSERT_EQ("node100", key.getSource());
+  ASSERT_EQ(12345u, key.getCreationTimestamp());
+  ASSERT_EQ(2u, key.getCreationTimestampSeqNumber());
+  ASSERT_EQ("node100_12345_2", key.toString());
+  BundleKey other("node100", 1, 1);
+  ASSERT_EQ(key.getSourceId(), other.getSourceId());
+  BundleKey third("node101", 12345, 2);
+  ASSERT_NE(key.getSourceId(), third.getSourceId());
+  BundleKey invalid;
+  ASSERT_FALSE(invalid.isValid());
+  ASSERT_EQ("", invalid.toString());
+  ASSERT_NE(invalid, key);
+}
+
+/**
+ * Check the comparison operators and the hash.
+ */
+TEST(BundleKeyTest, Compare) {
+  BundleKey a("node100", 12345, 2);
+  BundleKey b("node100", 12345, 2);
+  BundleKey c("node100", 12345, 3);
+  BundleKey d("node100", 12346, 2);
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(a.hash(), b.hash());
+  ASSERT_NE(a, c);
+  ASSERT_NE(a, d);
+  ASSERT_TRUE(a < c);
+  ASSERT_TRUE(a < d);
+  ASSERT_FALSE(b < a);
+  std::unordered_set<BundleKey> keys;
+  keys.insert(a);
+  keys.insert(b);
+  keys.insert(c);
+  ASSERT_EQ(2u, keys.size());
+}
+
+/**
+ * Check that the bundle key follows the primary block changes.
+ */
+TEST(BundleKeyTest, BundleKey) {
+  Bundle b("Source", "Destination", "Payload");
+  BundleKey key = b.getKey();
+  ASSERT_EQ(b.getId(), key.toString());
+  Bundle b1(b.toRaw());
+  ASSERT_EQ(key, b1.getKey());
+  b1.getPrimaryBlock()->setSource("Other");
+  ASSERT_NE(key, b1.getKey());
+  ASSERT_EQ("Other", b1.getKey().getSource());
+  b1.getPrimaryBlock()->setTimestamp(
+      std::make_pair(key.getCreationTimestamp(),
+                     key.getCreationTimestampSeqNumber() + 1));
+  ASSERT_EQ(key.getCreationTimestampSeqNumber() + 1,
+            b1.getKey().getCreationTimestampSeqNumber());
+}
+
+/**
+ * Check the keys of the fragments.
+ * Each fragment has its own key, with its offset and length, and all of them
+ * share the whole bundle key.
+ */
+TEST(BundleKeyTest, FragmentKey) {
+  BundleKey whole("node100", 12345, 2);
+  BundleKey first("node100", 12345, 2, 0, 1000);
+  BundleKey second("node100", 12345, 2, 1000, 500);
+  BundleKey shorter("node100", 12345, 2, 1000, 200);
+  ASSERT_FALSE(whole.isFragment());
+  ASSERT_TRUE(first.isFragment());
+  ASSERT_EQ(1000u, second.getFragmentOffset());
+  ASSERT_EQ(500u, second.getFragmentLength());
+  ASSERT_EQ(0u, whole.getFragmentLength());
+  ASSERT_NE(whole, first);
+  ASSERT_NE(first, second);
+  ASSERT_NE(second, shorter);
+  ASSERT_TRUE(first < second);
+  ASSERT_TRUE(shorter < second);
+  ASSERT_EQ(whole, first.getWholeBundleKey());
+  ASSERT_EQ(whole, second.getWholeBundleKey());
+  ASSERT_EQ(whole.toString() + "_1000_500", second.toString());
+  std::unordered_set<BundleKey> keys;
+  keys.insert(whole);
+  keys.insert(first);
+  keys.insert(second);
+  keys.insert(shorter);
+  ASSERT_EQ(4u, keys.size());
+}
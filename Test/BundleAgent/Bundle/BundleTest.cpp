@@ -29,15 +29,20 @@
 #include <sstream>
 #include <cstdio>
 #include <utility>
+#include <bitset>
+#include <unistd.h>
 #include "gtest/gtest.h"
 #include "Bundle/Bundle.h"
 
 #include "Bundle/CanonicalBlock.h"
 #include "Bundle/PayloadBlock.h"
 #include "Bundle/PrimaryBlock.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/RouteReportingMEB.h"
 #include "Bundle/BundleTypes.h"
 #include "Utils/SDNV.h"
 #include "Utils/TimestampManager.h"
+#include "Utils/MappedFile.h"
 #include "Bundle/FrameworkMEB.h"
 #include "Bundle/FrameworkExtension.h"
 
@@ -239,3 +244,252 @@ TEST(BundleTest, GetFrameworkExtension) {
   ASSERT_THROW(b2.getFwkExt(fwkId2, fwkExtId), FrameworkNotFoundException);
   ASSERT_THROW(b2.getFwkExt(fwkId2, fwkExtId2), FrameworkNotFoundException);
 }
+
+/**
+ * Check that the canonical blocks are only generated when requested.
+ * A framework block with a bad bundle state does not stop the bundle from
+ * being parsed and forwarded, only from being generated.
+ */
+TEST(BundleTest, LazyBlocks) {
+  Bundle b = Bundle("Source", "Destination", "This is a payload");
+  b.addBlock(std::shared_ptr<MetadataExtensionBlock>(
+      new MetadataExtensionBlock(
+          static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB), "1\"bad")));
+  std::string raw = b.toRaw();
+  Bundle b1 = Bundle(raw);
+  std::vector<BlockIndex> index = b1.getBlockIndex();
+  ASSERT_EQ(static_cast<size_t>(3), index.size());
+  ASSERT_EQ(static_cast<uint8_t>(CanonicalBlockTypes::PAYLOAD_BLOCK),
+            index[1].blockType);
+  ASSERT_EQ(static_cast<uint8_t>(CanonicalBlockTypes::METADATA_EXTENSION_BLOCK),
+            index[2].blockType);
+  ASSERT_EQ(static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB),
+            index[2].metadataType);
+  ASSERT_EQ(raw.size(), index[2].offset + index[2].length);
+  ASSERT_EQ("This is a payload", b1.getPayloadBlock()->getPayload());
+  ASSERT_EQ(raw, b1.toRaw());
+  ASSERT_THROW(b1.getBlocks(), BundleException);
+  ASSERT_THROW(b1.getFwk(1), BundleException);
+  // A valid framework block is generated by getFwk.
+  Bundle b2 = Bundle("Source", "Destination", "This is a payload");
+  b2.addBlock(std::shared_ptr<FrameworkMEB>(new FrameworkMEB(1)));
+  Bundle b3 = Bundle(b2.toRaw());
+  ASSERT_EQ(static_cast<uint8_t>(1), b3.getFwk(1)->getFwkId());
+  ASSERT_THROW(b3.getFwk(2), FrameworkNotFoundException);
+  ASSERT_EQ(b2.toRaw(), b3.toRaw());
+}
+
+/**
+ * Check that toRaw only converts the blocks that have changed.
+ * Converting a parsed bundle without changes must not convert any block,
+ * changing a block or adding a new one must only convert that block.
+ */
+TEST(BundleTest, IncrementalRaw) {
+  Bundle b = Bundle("Source", "Destination", "This is a payload");
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  std::string raw = b.toRaw();
+  ASSERT_EQ(static_cast<uint64_t>(3), b.getConvertedBlocks());
+  ASSERT_EQ(raw, b.toRaw());
+  ASSERT_EQ(static_cast<uint64_t>(3), b.getConvertedBlocks());
+  Bundle b1 = Bundle(raw);
+  ASSERT_EQ(raw, b1.toRaw());
+  b1.getBlocks();
+  ASSERT_EQ(raw, b1.toRaw());
+  ASSERT_EQ(static_cast<uint64_t>(0), b1.getConvertedBlocks());
+  // Change a block.
+  std::static_pointer_cast<RouteReportingMEB>(b1.getBlocks()[2])
+      ->addRouteInformation("node1", 10, 20);
+  std::string raw1 = b1.toRaw();
+  ASSERT_EQ(static_cast<uint64_t>(1), b1.getConvertedBlocks());
+  ASSERT_NE(raw, raw1);
+  ASSERT_EQ(raw1, b1.toRaw());
+  ASSERT_EQ(static_cast<uint64_t>(1), b1.getConvertedBlocks());
+  // Change the primary block.
+  b1.getPrimaryBlock()->setLifetime(10);
+  std::string raw2 = b1.toRaw();
+  ASSERT_EQ(static_cast<uint64_t>(2), b1.getConvertedBlocks());
+  // Add a new block, the previous last block is not converted.
+  std::stringstream ss;
+  ss << static_cast<uint8_t>(2) << SDNV::encode(std::bitset<7>().to_ulong())
+     << SDNV::encode(4) << "data";
+  b1.addBlock(std::shared_ptr<CanonicalBlock>(new CanonicalBlock(ss.str())));
+  std::string raw3 = b1.toRaw();
+  ASSERT_EQ(static_cast<uint64_t>(3), b1.getConvertedBlocks());
+  Bundle b2 = Bundle(raw3);
+  ASSERT_EQ(static_cast<uint64_t>(10), b2.getPrimaryBlock()->getLifetime());
+  ASSERT_EQ("node1,10,20", std::static_pointer_cast<RouteReportingMEB>(
+      b2.getBlocks()[2])->getRouteReporting());
+  ASSERT_EQ(static_cast<size_t>(4), b2.getBlocks().size());
+  ASSERT_EQ(raw3, b2.toRaw());
+  ASSERT_EQ(static_cast<uint64_t>(0), b2.getConvertedBlocks());
+}
+
+/**
+ * Check the segments of a raw bundle.
+ * Joining the segments must give the same raw bundle as toRaw, the unchanged
+ * blocks must be taken from the received buffer and only the changed ones
+ * from their own raw.
+ */
+TEST(BundleTest, RawSegments) {
+  Bundle b = Bundle("Source", "Destination", std::string(4096, 'a'));
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  std::string raw = b.toRaw();
+  Bundle b1 = Bundle(raw);
+  std::vector<RawSegment> segments = b1.toRawSegments();
+  ASSERT_EQ(static_cast<size_t>(1), segments.size());
+  ASSERT_EQ(raw.size(), segments[0].length);
+  std::static_pointer_cast<RouteReportingMEB>(b1.getBlocks()[2])
+      ->addRouteInformation("node1", 10, 20);
+  segments = b1.toRawSegments();
+  // Primary and payload blocks from the buffer, the changed block alone.
+  ASSERT_EQ(static_cast<size_t>(2), segments.size());
+  std::string joined;
+  for (auto &segment : segments) {
+    joined.append(segment.data(), segment.length);
+  }
+  ASSERT_EQ(static_cast<uint64_t>(1), b1.getConvertedBlocks());
+  ASSERT_EQ(joined, b1.toRaw());
+  ASSERT_EQ(static_cast<uint64_t>(1), b1.getConvertedBlocks());
+  ASSERT_EQ("node1,10,20", std::static_pointer_cast<RouteReportingMEB>(
+      Bundle(joined).getBlocks()[2])->getRouteReporting());
+  segments = b1.toRawSegments();
+  ASSERT_EQ(static_cast<size_t>(1), segments.size());
+}
+
+/**
+ * Check that the blocks share the buffer of the bundle instead of keeping
+ * their own copy, and that a changed block stops using it.
+ */
+TEST(BundleTest, SingleBuffer) {
+  Bundle b = Bundle("Source", "Destination", std::string(4096, 'a'));
+  std::string raw = b.toRaw();
+  std::vector<RawSegment> segments = b.toRawSegments();
+  ASSERT_EQ(static_cast<size_t>(1), segments.size());
+  ASSERT_EQ(segments[0].buffer,
+            b.getPayloadBlock()->getPayloadSegment().buffer);
+  Bundle r = Bundle(std::move(raw));
+  segments = r.toRawSegments();
+  ASSERT_EQ(static_cast<size_t>(1), segments.size());
+  ASSERT_EQ(segments[0].buffer,
+            r.getPayloadBlock()->getPayloadSegment().buffer);
+  r.getPayloadBlock()->setProcFlag(CanonicalBlockControlFlags::DISCARD_BLOCK);
+  segments = r.toRawSegments();
+  ASSERT_LT(static_cast<size_t>(1), segments.size());
+  ASSERT_NE(segments[0].buffer,
+            r.getPayloadBlock()->getPayloadSegment().buffer);
+  ASSERT_EQ(std::string(4096, 'a'), r.getPayloadBlock()->getPayload());
+}
+
+/**
+ * Writes the data into an anonymous temporary file and maps it.
+ */
+static std::shared_ptr<const MappedFile> mapData(const std::string &data) {
+  int fd = MappedFile::createTemporary("/tmp/");
+  EXPECT_GE(fd, 0);
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t result = write(fd, data.data() + written, data.size() - written);
+    EXPECT_GT(result, 0);
+    written += result;
+  }
+  std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(
+      fd);
+  close(fd);
+  return file;
+}
+
+/**
+ * Check the mapped file constructor.
+ * The payload must be taken from the file, and the other blocks must work as
+ * if the bundle was parsed from memory.
+ */
+TEST(BundleTest, MappedFileConstructor) {
+  Bundle b = Bundle("Source", "Destination", std::string(4096, 'a'));
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  std::string raw = b.toRaw();
+  std::shared_ptr<const MappedFile> file = mapData(raw);
+  Bundle b1 = Bundle(file);
+  ASSERT_EQ(b.getId(), b1.getId());
+  ASSERT_EQ(raw.size(), b1.getRawLength());
+  std::shared_ptr<PayloadBlock> payload = b1.getPayloadBlock();
+  ASSERT_EQ(4096u, payload->getPayloadLength());
+  RawSegment payloadSegment = payload->getPayloadSegment();
+  ASSERT_EQ(file, payloadSegment.file);
+  ASSERT_EQ(std::string(4096, 'a'), payload->getPayload());
+  std::static_pointer_cast<RouteReportingMEB>(b1.getBlocks()[2])
+      ->addRouteInformation("node1", 10, 20);
+  std::vector<RawSegment> segments = b1.toRawSegments();
+  ASSERT_EQ(static_cast<size_t>(3), segments.size());
+  ASSERT_EQ(file, segments[1].file);
+  std::string joined;
+  for (auto &segment : segments) {
+    joined.append(segment.data(), segment.length);
+  }
+  ASSERT_EQ(joined, b1.toRaw());
+  ASSERT_EQ("node1,10,20", std::static_pointer_cast<RouteReportingMEB>(
+      Bundle(joined).getBlocks()[2])->getRouteReporting());
+  raw[raw.size() - 1] = 0;
+  raw.resize(raw.size() - 2);
+  ASSERT_THROW(Bundle(mapData(raw)), BundleCreationException);
+  ASSERT_THROW(Bundle(mapData("")), BundleCreationException);
+}
+
+/**
+ * Check the fragmentation of a bundle.
+ * The fragments must fit into the given size, cover the whole payload and
+ * only the blocks with the REPLICATE_FRAGMENT flag must be in all of them.
+ */
+TEST(BundleTest, Fragment) {
+  std::string payload;
+  for (int i = 0; i < 10000; ++i) {
+    payload.push_back('a' + i % 26);
+  }
+  Bundle b = Bundle("Source", "Destination:1", payload);
+  std::shared_ptr<RouteReportingMEB> replicated(new RouteReportingMEB());
+  replicated->setProcFlag(CanonicalBlockControlFlags::REPLICATE_FRAGMENT);
+  b.addBlock(replicated);
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  ASSERT_TRUE(b.fragment(b.toRaw().size()).empty());
+  std::vector<std::unique_ptr<Bundle>> fragments = b.fragment(1500);
+  ASSERT_GT(fragments.size(), 1u);
+  std::string joined;
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    Bundle &fragment = *fragments[i];
+    std::string raw = fragment.toRaw();
+    ASSERT_LE(raw.size(), 1500u);
+    std::shared_ptr<PrimaryBlock> pb = fragment.getPrimaryBlock();
+    ASSERT_TRUE(pb->checkPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT));
+    ASSERT_EQ(joined.size(), pb->getFragmentOffset());
+    ASSERT_EQ(payload.size(), pb->getTotalApplicationDataLength());
+    ASSERT_EQ(b.getKey(), fragment.getKey().getWholeBundleKey());
+    ASSERT_EQ("Destination:1", pb->getDestination());
+    ASSERT_EQ(fragment.getPayloadBlock()->getPayload().size(),
+              fragment.getKey().getFragmentLength());
+    joined.append(fragment.getPayloadBlock()->getPayload());
+    Bundle parsed(raw);
+    ASSERT_EQ(fragment.getKey(), parsed.getKey());
+    bool last = i == fragments.size() - 1;
+    ASSERT_EQ(last ? 4u : 3u, parsed.getBlocks().size());
+    ASSERT_TRUE(std::static_pointer_cast<CanonicalBlock>(
+        parsed.getBlocks()[2])->checkProcFlag(
+            CanonicalBlockControlFlags::REPLICATE_FRAGMENT));
+  }
+  ASSERT_EQ(payload, joined);
+  // A fragment of a fragment keeps the offsets of the original payload.
+  Bundle &second = *fragments[1];
+  uint64_t offset = second.getPrimaryBlock()->getFragmentOffset();
+  std::vector<std::unique_ptr<Bundle>> refragments = second.fragment(1000);
+  ASSERT_GT(refragments.size(), 1u);
+  for (auto &fragment : refragments) {
+    ASSERT_EQ(offset, fragment->getPrimaryBlock()->getFragmentOffset());
+    ASSERT_EQ(payload.size(),
+              fragment->getPrimaryBlock()->getTotalApplicationDataLength());
+    std::string data = fragment->getPayloadBlock()->getPayload();
+    ASSERT_EQ(payload.substr(offset, data.size()), data);
+    offset += data.size();
+  }
+  ASSERT_THROW(b.fragment(50), BundleException);
+  b.getPrimaryBlock()->setPrimaryProcFlag(
+      PrimaryBlockControlFlags::NOT_FRAGMENTED);
+  ASSERT_TRUE(b.fragment(1500).empty());
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CompressionMEBTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the Compression MEB.
+ */
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/CompressionMEB.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "gtest/gtest.h"
+
+/**
+ * Generates a JSON telemetry payload.
+ */
+static std::string generateTelemetry(size_t records) {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < records; ++i) {
+    ss << "{\"node\":\"node" << i % 10 << "\",\"time\":" << 1476700000 + i
+       << ",\"temperature\":" << 20 + i % 7 << ".5,\"battery\":"
+       << 90 - i % 13 << "},";
+  }
+  ss << "{}]";
+  return ss.str();
+}
+
+/**
+ * Check the constructors of the block.
+ */
+TEST(CompressionMEBTest, Constructors) {
+  CompressionMEB meb(CompressionAlgorithms::DEFLATE, 300);
+  ASSERT_EQ(static_cast<uint8_t>(MetadataTypes::COMPRESSION_MEB),
+            meb.getMetadataType());
+  CompressionMEB meb1(meb.toRaw());
+  ASSERT_EQ(CompressionAlgorithms::DEFLATE, meb1.getAlgorithm());
+  ASSERT_EQ(300u, meb1.getOriginalLength());
+  ASSERT_EQ(meb.toRaw(), meb1.toRaw());
+}
+
+/**
+ * Check that a compressed bundle is smaller, is parsed with the block and
+ * gives the original bundle when decompressed.
+ */
+TEST(CompressionMEBTest, CompressBundle) {
+  std::string payload = generateTelemetry(1000);
+  Bundle b("Source", "Destination", payload);
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  std::string raw = b.toRaw();
+  ASSERT_EQ(nullptr, b.decompressPayload());
+  std::unique_ptr<Bundle> compressed = b.compressPayload(6);
+  ASSERT_NE(nullptr, compressed);
+  std::string compressedRaw = compressed->toRaw();
+  ASSERT_LT(compressedRaw.size() * 5, raw.size());
+  ASSERT_EQ(b.getKey(), compressed->getKey());
+  ASSERT_EQ(nullptr, compressed->compressPayload(6));
+  Bundle parsed(compressedRaw);
+  auto meb = std::dynamic_pointer_cast<CompressionMEB>(parsed.getBlocks()[1]);
+  ASSERT_NE(nullptr, meb);
+  ASSERT_EQ(payload.size(), meb->getOriginalLength());
+  std::unique_ptr<Bundle> original = parsed.decompressPayload();
+  ASSERT_NE(nullptr, original);
+  ASSERT_EQ(raw, original->toRaw());
+  ASSERT_EQ(payload, original->getPayloadBlock()->getPayload());
+}
+
+/**
+ * Check the payloads that do not compress and the corrupted payloads.
+ */
+TEST(CompressionMEBTest, BadPayloads) {
+  std::string payload;
+  std::mt19937 generator(42);
+  for (int i = 0; i < 1000; ++i) {
+    payload.push_back(static_cast<char>(generator()));
+  }
+  Bundle random("Source", "Destination", payload);
+  ASSERT_EQ(nullptr, random.compressPayload(9));
+  Bundle b("Source", "Destination", generateTelemetry(100));
+  std::string raw = b.compressPayload(6)->toRaw();
+  // Corrupt the end of the compressed payload.
+  raw[raw.size() - 2] ^= 0x55;
+  ASSERT_THROW(Bundle(raw).decompressPayload(), CompressionException);
+}
+
+/**
+ * Check the decompression when the compression block is the last block.
+ */
+TEST(CompressionMEBTest, LastBlock) {
+  std::string payload = generateTelemetry(100);
+  Bundle b("Source", "Destination", payload);
+  std::string compressedPayload = CompressionMEB::compress(
+      CompressionAlgorithms::DEFLATE, payload.data(), payload.size(), 6);
+  Bundle compressed("Source", "Destination", compressedPayload);
+  compressed.addBlock(std::shared_ptr<CompressionMEB>(
+      new CompressionMEB(CompressionAlgorithms::DEFLATE, payload.size())));
+  std::unique_ptr<Bundle> original = Bundle(compressed.toRaw())
+      .decompressPayload();
+  ASSERT_NE(nullptr, original);
+  ASSERT_EQ(2u, Bundle(original->toRaw()).getBlocks().size());
+  ASSERT_EQ(payload, original->getPayloadBlock()->getPayload());
+}
@@ -34,6 +34,8 @@
 #include <utility>
 #include "gtest/gtest.h"
 #include "Bundle/BundleTypes.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Utils/SDNV.h"
 #include "Bundle/FrameworkMEB.h"
 #include "Bundle/FrameworkExtension.h"
 
@@ -55,14 +57,16 @@ TEST(FrameworkMEBTest, FilledConstructor) {
 
   std::stringstream ss;
   for (auto& ext : extensions) {
-    ss << ext.second->getFwkExtId();
-    ss << ext.second->getCodeLength();
+    ss << SDNV::encode(ext.second->getFwkExtId());
+    ss << SDNV::encode(ext.second->getCodeLength());
     ss << ext.second->getSwSrcCode();
   }
+  std::vector<uint8_t> cborState = nlohmann::json::to_cbor(state);
   std::stringstream ss2;
-  ss2 << fwkId <<
-      static_cast<uint16_t>(std::stoi(std::to_string(extensions.size()))) <<
-      ss.str() << state;
+  ss2 << fwkId << static_cast<uint8_t>(0x81)
+      << SDNV::encode(extensions.size()) << ss.str()
+      << SDNV::encode(cborState.size())
+      << std::string(cborState.begin(), cborState.end());
   std::string metadata = ss2.str();
 
   FrameworkMEB fmeb = FrameworkMEB(fwkId, extensions, state);
@@ -266,3 +270,52 @@ TEST(FrameworkMEBTest, GetFwkExt) {
   ASSERT_THROW(fmeb.getFwkExt(fwkId), ExtensionNotFoundException);
 }
 
+/**
+ * Generates the metadata of a framework block in the text format of the
+ * first version.
+ */
+static std::string textMetadata(
+    uint8_t fwkId,
+    std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions,
+    nlohmann::json state) {
+  std::stringstream ss;
+  ss << fwkId << std::to_string(static_cast<uint8_t>(extensions.size()));
+  for (auto& ext : extensions) {
+    ss << ext.second->getFwkExtId() << ext.second->getCodeLength()
+       << ext.second->getSwSrcCode();
+  }
+  ss << state;
+  return ss.str();
+}
+
+TEST(FrameworkMEBTest, TextFormat) {
+  uint8_t fwkId = 1;
+  std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions;
+  extensions[2] = std::make_shared<FrameworkExtension>(2, "code");
+  extensions[4] = std::make_shared<FrameworkExtension>(4, "other code");
+  nlohmann::json state = {{"from", "node1"}, {"hops", 3}};
+  MetadataExtensionBlock meb(
+      static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB),
+      textMetadata(fwkId, extensions, state));
+  FrameworkMEB fmeb = FrameworkMEB(meb.toRaw());
+  ASSERT_EQ(fwkId, fmeb.getFwkId());
+  ASSERT_EQ(state, fmeb.getBundleState());
+  ASSERT_TRUE(testMaps(extensions, fmeb.getFwkExts()));
+  // Once modified it is written in the binary format.
+  std::string raw = fmeb.toRaw();
+  ASSERT_EQ(0x81, static_cast<uint8_t>(fmeb.getMetadata()[1]));
+  FrameworkMEB fmeb2 = FrameworkMEB(raw);
+  ASSERT_EQ(state, fmeb2.getBundleState());
+  ASSERT_TRUE(testMaps(extensions, fmeb2.getFwkExts()));
+}
+
+TEST(FrameworkMEBTest, BadBinaryFormat) {
+  std::map<uint8_t, std::shared_ptr<FrameworkExtension>> extensions;
+  extensions[2] = std::make_shared<FrameworkExtension>(2, "code");
+  FrameworkMEB fmeb = FrameworkMEB(1, extensions, {{"from", "node1"}});
+  std::string metadata = fmeb.getMetadata();
+  MetadataExtensionBlock meb(
+      static_cast<uint8_t>(MetadataTypes::FRAMEWORK_MEB),
+      metadata.substr(0, metadata.size() - 3));
+  ASSERT_THROW(FrameworkMEB(meb.toRaw()), BlockConstructionException);
+}
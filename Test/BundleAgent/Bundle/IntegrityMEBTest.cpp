@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntegrityMEBTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the Integrity MEB.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/IntegrityMEB.h"
+#include "Bundle/MetadataExtensionBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the constructors of the block.
+ */
+TEST(IntegrityMEBTest, Constructors) {
+  IntegrityMEB meb;
+  ASSERT_TRUE(meb.getChecksums().empty());
+  meb.setChecksums({0x01020304, 0xFFFFFFFF});
+  IntegrityMEB meb1(meb.toRaw());
+  ASSERT_EQ(static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB),
+            meb1.getMetadataType());
+  ASSERT_EQ(meb.getChecksums(), meb1.getChecksums());
+  // Two checksums announced and only one present.
+  MetadataExtensionBlock shortBlock(
+      static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB),
+      std::string("\x01\x02\x00\x00\x00\x01", 6));
+  ASSERT_THROW(IntegrityMEB(shortBlock.toRaw()), BlockConstructionException);
+  MetadataExtensionBlock unknownAlgorithm(
+      static_cast<uint8_t>(MetadataTypes::INTEGRITY_MEB),
+      std::string("\x02\x00", 2));
+  ASSERT_THROW(IntegrityMEB(unknownAlgorithm.toRaw()),
+               BlockConstructionException);
+}
+
+/**
+ * Check that the checksums detect the damaged blocks and that they can be
+ * updated after a change.
+ */
+TEST(IntegrityMEBTest, Checksums) {
+  Bundle b("Source", "Destination", std::string(1000, 'a'));
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  ASSERT_TRUE(b.verifyChecksums());
+  b.addChecksums();
+  ASSERT_TRUE(b.verifyChecksums());
+  std::string raw = b.toRaw();
+  Bundle received(raw);
+  ASSERT_EQ(4u, received.getBlockIndex().size());
+  ASSERT_TRUE(received.hasChecksums());
+  ASSERT_TRUE(received.verifyChecksums());
+  ASSERT_FALSE(received.isDirty());
+  // Damage one byte of the payload.
+  std::string damaged = raw;
+  damaged[damaged.size() - 100] = 'b';
+  ASSERT_FALSE(Bundle(damaged).verifyChecksums());
+  // A changed block must be sealed again.
+  std::static_pointer_cast<RouteReportingMEB>(received.getBlocks()[3])
+      ->addRouteInformation("node1", 10, 20);
+  ASSERT_TRUE(received.isDirty());
+  ASSERT_FALSE(received.verifyChecksums());
+  // The change is still pending after the bundle is converted to raw.
+  received.toRaw();
+  ASSERT_TRUE(received.isDirty());
+  received.addChecksums();
+  ASSERT_FALSE(received.isDirty());
+  ASSERT_EQ(4u, received.getBlockIndex().size());
+  Bundle forwarded(received.toRaw());
+  ASSERT_TRUE(forwarded.verifyChecksums());
+  ASSERT_EQ("node1,10,20", std::static_pointer_cast<RouteReportingMEB>(
+      forwarded.getBlocks()[3])->getRouteReporting());
+}
+
+/**
+ * Check that a bundle without checksums is not changed when it is read.
+ */
+TEST(IntegrityMEBTest, Unsealed) {
+  Bundle b("Source", "Destination", std::string(1000, 'a'));
+  b.addBlock(std::shared_ptr<RouteReportingMEB>(new RouteReportingMEB()));
+  std::string raw = b.toRaw();
+  Bundle received(raw);
+  received.getBlocks();
+  ASSERT_FALSE(received.hasChecksums());
+  ASSERT_FALSE(received.isDirty());
+  ASSERT_EQ(raw, received.toRaw());
+  ASSERT_EQ(0u, received.getConvertedBlocks());
+}
+
+/**
+ * Check that the fragments do not carry the checksums of the whole bundle.
+ */
+TEST(IntegrityMEBTest, Fragments) {
+  Bundle b("Source", "Destination", std::string(5000, 'a'));
+  b.addChecksums();
+  std::vector<std::unique_ptr<Bundle>> fragments = b.fragment(1000);
+  ASSERT_GT(fragments.size(), 1u);
+  for (auto &fragment : fragments) {
+    ASSERT_EQ(2u, fragment->getBlockIndex().size());
+    fragment->addChecksums();
+    ASSERT_TRUE(Bundle(fragment->toRaw()).verifyChecksums());
+  }
+}
@@ -25,6 +25,7 @@
 #include <string>
 #include <utility>
 #include "Bundle/PrimaryBlock.h"
+#include "Utils/SDNV.h"
 #include "Utils/TimestampManager.h"
 #include "gtest/gtest.h"
 
@@ -167,3 +168,43 @@ TEST(PrimaryBlockTest, PrimaryBlockConstructionException) {
   ASSERT_THROW(PrimaryBlock(raw.substr(0, 5)),
                BlockConstructionException);
 }
+
+/**
+ * Check the fragment fields.
+ * They must only be in the raw block when the IS_FRAGMENT flag is set.
+ */
+TEST(PrimaryBlockTest, FragmentFields) {
+  std::pair<uint64_t, uint64_t> time = TimestampManager::getInstance()
+      ->getTimestamp();
+  PrimaryBlock pb = PrimaryBlock("Source", "Destination", time.first,
+                                 time.second);
+  std::string raw = pb.toRaw();
+  pb.setFragment(1000, 5000);
+  ASSERT_TRUE(pb.checkPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT));
+  ASSERT_EQ(1000u, pb.getFragmentOffset());
+  ASSERT_EQ(5000u, pb.getTotalApplicationDataLength());
+  ASSERT_TRUE(pb.getKey().isFragment());
+  std::string fragmentRaw = pb.toRaw();
+  ASSERT_GT(fragmentRaw.size(), raw.size());
+  PrimaryBlock pb1 = PrimaryBlock(fragmentRaw);
+  ASSERT_EQ(fragmentRaw, pb1.toRaw());
+  ASSERT_EQ(1000u, pb1.getFragmentOffset());
+  ASSERT_EQ(5000u, pb1.getTotalApplicationDataLength());
+  ASSERT_EQ(pb.getKey(), pb1.getKey());
+  pb1.unsetPrimaryProcFlag(PrimaryBlockControlFlags::IS_FRAGMENT);
+  ASSERT_EQ(0u, pb1.getFragmentOffset());
+  ASSERT_FALSE(pb1.getKey().isFragment());
+  ASSERT_EQ(raw, pb1.toRaw());
+}
+
+/**
+ * Check a dictionary length that would wrap the block bounds.
+ * The block must be rejected instead of reading past the dictionary.
+ */
+TEST(PrimaryBlockTest, DictionaryLengthOverflow) {
+  std::string fields = std::string(11, '\0')
+      + SDNV::encode(0xFFFFFFFFFFFFFFFF) + "dict";
+  std::string raw = std::string(1, '\x06') + SDNV::encode(0)
+      + SDNV::encode(fields.size()) + fields;
+  ASSERT_THROW(PrimaryBlock(raw.substr(0)), BlockConstructionException);
+}
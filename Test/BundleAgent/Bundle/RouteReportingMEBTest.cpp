@@ -27,6 +27,7 @@
 #include <sstream>
 #include "gtest/gtest.h"
 #include "Bundle/RouteReportingMEB.h"
+#include "Bundle/MetadataExtensionBlock.h"
 #include "Bundle/BundleTypes.h"
 
 /**
@@ -129,3 +130,40 @@ TEST(RouteReportingMEBTest, AddRouteInformation) {
   std::string route_t = route1 + "\n" + route2;
   ASSERT_EQ(route_t, rrm.getRouteReporting());
 }
+
+TEST(RouteReportingMEBTest, TextFormat) {
+  std::string route = "node1,1000,1010\nnode2,1020,1025\nnode1,1030,1040";
+  MetadataExtensionBlock meb(
+      static_cast<uint8_t>(MetadataTypes::ROUTE_REPORTING_MEB), route);
+  RouteReportingMEB rrm = RouteReportingMEB(meb.toRaw());
+  ASSERT_EQ(route, rrm.getRouteReporting());
+  ASSERT_EQ(3u, rrm.getNumberOfHops());
+  rrm.addRouteInformation("node3", 1050, 1045);
+  ASSERT_EQ(route + "\nnode3,1050,1045", rrm.getRouteReporting());
+  RouteReportingMEB rrm2 = RouteReportingMEB(rrm.toRaw());
+  ASSERT_EQ(rrm.getRouteReporting(), rrm2.getRouteReporting());
+  ASSERT_LT(rrm.getMetadata().size(), rrm.getRouteReporting().size());
+  MetadataExtensionBlock bad(
+      static_cast<uint8_t>(MetadataTypes::ROUTE_REPORTING_MEB), "node1,10");
+  ASSERT_THROW(RouteReportingMEB(bad.toRaw()), BlockConstructionException);
+}
+
+TEST(RouteReportingMEBTest, MaxHops) {
+  RouteReportingMEB rrm = RouteReportingMEB();
+  rrm.setMaxHops(3);
+  for (int i = 0; i < 10; ++i) {
+    rrm.addRouteInformation("node" + std::to_string(i), 1000 + i * 10,
+                            1005 + i * 10);
+  }
+  ASSERT_EQ(3u, rrm.getNumberOfHops());
+  ASSERT_EQ(7u, rrm.getDroppedHops());
+  std::string route = "node0,1000,1005\nnode8,1080,1085\nnode9,1090,1095";
+  ASSERT_EQ(route, rrm.getRouteReporting());
+  RouteReportingMEB rrm2 = RouteReportingMEB(rrm.toRaw());
+  ASSERT_EQ(route, rrm2.getRouteReporting());
+  ASSERT_EQ(7u, rrm2.getDroppedHops());
+  // The limit travels with the block.
+  rrm2.addRouteInformation("node10", 1100, 1105);
+  ASSERT_EQ(3u, rrm2.getNumberOfHops());
+  ASSERT_EQ(8u, rrm2.getDroppedHops());
+}
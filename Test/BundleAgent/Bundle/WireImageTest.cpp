@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE WireImageTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the WireImage class.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/WireImage.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that the image holds the raw bundle without copying the payload.
+ */
+TEST(WireImageTest, SharesPayload) {
+  std::string payload(64 * 1024, 'a');
+  Bundle b = Bundle(Bundle("Source", "Destination", payload).toRaw());
+  std::shared_ptr<const WireImage> image = b.toWireImage();
+  ASSERT_EQ(b.toRaw().size(), image->getLength());
+  ASSERT_EQ(b.toRaw(), image->toString());
+  ASSERT_EQ(static_cast<size_t>(1), image->getSegments().size());
+  ASSERT_EQ(image->getSegments()[0].buffer,
+            b.getPayloadBlock()->getPayloadSegment().buffer);
+  // Encoding it again does not convert any block.
+  uint64_t converted = b.getConvertedBlocks();
+  std::shared_ptr<const WireImage> image1 = b.toWireImage();
+  ASSERT_EQ(converted, b.getConvertedBlocks());
+  ASSERT_EQ(image->getSegments()[0].buffer, image1->getSegments()[0].buffer);
+}
+
+/**
+ * Check that the image does not change when the bundle changes or is
+ * destroyed.
+ */
+TEST(WireImageTest, Immutable) {
+  std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
+      new Bundle("Source", "Destination", "This is a test payload"));
+  std::shared_ptr<const WireImage> image = b->toWireImage();
+  std::string raw = image->toString();
+  b->getPrimaryBlock()->setLifetime(1234);
+  ASSERT_NE(raw, b->toWireImage()->toString());
+  ASSERT_EQ(raw, image->toString());
+  b.reset();
+  ASSERT_EQ(raw, image->toString());
+  Bundle b1 = Bundle(raw);
+  ASSERT_EQ("This is a test payload", b1.getPayloadBlock()->getPayload());
+}
+
+/**
+ * Check the images of the other versions.
+ */
+TEST(WireImageTest, Versions) {
+  Bundle b = Bundle("Source", "Destination", std::string(4096, 'b'));
+  std::shared_ptr<const WireImage> image = b.toWireImage(BundleEncoding::BPV7);
+  ASSERT_EQ(b.toRaw(BundleEncoding::BPV7), image->toString());
+  Bundle b1 = Bundle(image->toString());
+  ASSERT_EQ(std::string(4096, 'b'), b1.getPayloadBlock()->getPayload());
+  ASSERT_EQ(b.toRaw(), b.toWireImage(BundleEncoding::RFC5050)->toString());
+}
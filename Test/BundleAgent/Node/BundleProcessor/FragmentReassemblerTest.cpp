@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE FragmentReassemblerTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the FragmentReassembler class.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Node/BundleProcessor/FragmentReassembler.h"
+#include "Bundle/Bundle.h"
+#include "Bundle/BundleTypes.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "gtest/gtest.h"
+
+/**
+ * Generates a bundle with a replicated and a not replicated block.
+ */
+static std::unique_ptr<Bundle> generateBundle(size_t payloadLength) {
+  std::string payload;
+  for (size_t i = 0; i < payloadLength; ++i) {
+    payload.push_back('a' + i % 26);
+  }
+  std::unique_ptr<Bundle> b(new Bundle("Source", "Destination:1", payload));
+  std::shared_ptr<RouteReportingMEB> replicated(new RouteReportingMEB());
+  replicated->setProcFlag(CanonicalBlockControlFlags::REPLICATE_FRAGMENT);
+  b->addBlock(replicated);
+  std::shared_ptr<RouteReportingMEB> last(new RouteReportingMEB());
+  last->addRouteInformation("node1", 10, 20);
+  b->addBlock(last);
+  return b;
+}
+
+/**
+ * Check that the fragments, received out of order and repeated, generate
+ * the original bundle.
+ */
+TEST(FragmentReassemblerTest, Reassemble) {
+  std::unique_ptr<Bundle> b = generateBundle(10000);
+  std::string raw = b->toRaw();
+  std::vector<std::unique_ptr<Bundle>> fragments = b->fragment(1500);
+  ASSERT_GT(fragments.size(), 2u);
+  FragmentReassembler reassembler;
+  ASSERT_THROW(reassembler.addFragment(*b), BundleException);
+  std::unique_ptr<Bundle> whole;
+  for (size_t i = fragments.size(); i > 1; --i) {
+    ASSERT_EQ(nullptr, reassembler.addFragment(*fragments[i - 1]));
+    ASSERT_EQ(nullptr, reassembler.addFragment(*fragments[i - 1]));
+  }
+  ASSERT_EQ(1u, reassembler.getPendingBundles());
+  whole = reassembler.addFragment(*fragments[0]);
+  ASSERT_NE(nullptr, whole);
+  ASSERT_EQ(0u, reassembler.getPendingBundles());
+  ASSERT_EQ(raw, whole->toRaw());
+  ASSERT_EQ(b->getKey(), whole->getKey());
+  ASSERT_FALSE(whole->getPrimaryBlock()->checkPrimaryProcFlag(
+      PrimaryBlockControlFlags::IS_FRAGMENT));
+  ASSERT_EQ("node1,10,20", std::static_pointer_cast<RouteReportingMEB>(
+      whole->getBlocks()[3])->getRouteReporting());
+}
+
+/**
+ * Check the reassembly of overlapping fragments, generated by fragmenting
+ * the fragments again, into a file.
+ */
+TEST(FragmentReassemblerTest, ReassembleIntoFile) {
+  std::unique_ptr<Bundle> b = generateBundle(20000);
+  std::string raw = b->toRaw();
+  std::vector<std::unique_ptr<Bundle>> fragments = b->fragment(4000);
+  std::vector<std::unique_ptr<Bundle>> small = fragments[1]->fragment(1000);
+  ASSERT_GT(small.size(), 1u);
+  FragmentReassembler reassembler("/tmp/", 1000);
+  for (auto &fragment : small) {
+    ASSERT_EQ(nullptr, reassembler.addFragment(*fragment));
+  }
+  std::unique_ptr<Bundle> whole;
+  for (auto &fragment : fragments) {
+    ASSERT_EQ(nullptr, whole);
+    whole = reassembler.addFragment(*fragment);
+  }
+  ASSERT_NE(nullptr, whole);
+  ASSERT_NE(nullptr, whole->getPayloadBlock()->getPayloadSegment().file);
+  ASSERT_EQ(raw, whole->toRaw());
+}
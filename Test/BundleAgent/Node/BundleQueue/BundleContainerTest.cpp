@@ -22,16 +22,22 @@
  * This file contains the BundleContainer tests.
  */
 
+#include <unistd.h>
 #include <string>
 #include <memory>
+#include <sstream>
 #include "Node/BundleQueue/BundleContainer.h"
 #include "Bundle/Bundle.h"
+#include "Bundle/BundleInfo.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Utils/MappedFile.h"
 #include "gtest/gtest.h"
 
 TEST(BundleContainerTest, GenerateContainer) {
   std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
       new Bundle("Me", "Someone", "This is a test bundle"));
-  Bundle b1 = *b.get();
+  Bundle b1(b->toRaw());
   BundleContainer bc = BundleContainer(std::move(b));
   ASSERT_EQ(nlohmann::json(), bc.getState());
   ASSERT_EQ(b1.toRaw(), bc.getBundle().toRaw());
@@ -66,6 +72,24 @@ TEST(BundleContainerTest, SerializeAndDeserializeWithChange) {
   ASSERT_EQ(bc.getBundle().toRaw(), sbc->getBundle().toRaw());
 }
 
+TEST(BundleContainerTest, SerializeMappedBundle) {
+  std::string raw = Bundle("Me", "Someone", std::string(100000, 'a')).toRaw();
+  int fd = MappedFile::createTemporary("/tmp/");
+  ASSERT_EQ(static_cast<ssize_t>(raw.size()),
+            write(fd, raw.data(), raw.size()));
+  std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(
+      fd);
+  close(fd);
+  BundleContainer bc = BundleContainer(
+      std::unique_ptr<Bundle>(new Bundle(file)));
+  std::stringstream ss;
+  bc.serialize(ss);
+  ASSERT_EQ(ss.str(), bc.serialize());
+  BundleContainer sbc = BundleContainer(ss.str());
+  ASSERT_EQ(raw, sbc.getBundle().toRaw());
+  ASSERT_EQ(file, bc.getBundle().getPayloadBlock()->getPayloadSegment().file);
+}
+
 TEST(BundleContainerTest, BadSerialized) {
   std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
       new Bundle("Me", "Someone", "This is a test bundle"));
@@ -91,3 +115,35 @@ TEST(BundleContainerTest, BadSerialized) {
   data[8] = '5';
   ASSERT_THROW(new BundleContainer(data), BundleContainerCreationException);
 }
+
+TEST(BundleContainerTest, CachedInfo) {
+  std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
+      new Bundle("Me", "Someone", "This is a test bundle"));
+  size_t size = b->toRaw().size();
+  BundleContainer bc = BundleContainer(std::move(b));
+  std::shared_ptr<const BundleInfo> info = bc.getInfo();
+  ASSERT_EQ(size, info->getSize());
+  ASSERT_EQ("Me", info->getSource());
+  ASSERT_EQ(info, bc.getInfo());
+  // Reading the bundle keeps the information.
+  const Bundle &read = bc.readBundle();
+  ASSERT_EQ(info->getId(), read.getId());
+  ASSERT_EQ(size, read.getRawLength());
+  ASSERT_EQ("This is a test bundle", read.getPayloadBlock()->getPayload());
+  ASSERT_TRUE(read.verifyChecksums());
+  ASSERT_EQ(info, bc.getInfo());
+  // The bundle may change when it is accessed.
+  bc.getBundle().addBlock(std::make_shared<RoutingSelectionMEB>(0x01));
+  size_t newSize = bc.getBundle().toRaw().size();
+  std::shared_ptr<const BundleInfo> info1 = bc.getInfo();
+  ASSERT_NE(info, info1);
+  ASSERT_EQ(newSize, info1->getSize());
+  ASSERT_TRUE(info1->hasMetadataTypeBlock(
+      static_cast<uint8_t>(MetadataTypes::ROUTING_SELECTION_MEB)));
+  ASSERT_EQ(size, info->getSize());
+  BundleContainer bc1 = BundleContainer(std::move(bc));
+  ASSERT_EQ(info1, bc1.getInfo());
+  BundleContainer bc2 = BundleContainer(bc1.serialize());
+  ASSERT_EQ(newSize, bc2.getInfo()->getSize());
+  ASSERT_EQ(info1->getKey(), bc2.getInfo()->getKey());
+}
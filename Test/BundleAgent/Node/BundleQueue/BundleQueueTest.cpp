@@ -22,11 +22,29 @@
  *
  */
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
 #include <string>
+#include <thread>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include "Node/BundleQueue/BundleContainer.h"
 #include "Node/BundleQueue/BundleQueue.h"
 #include "Bundle/Bundle.h"
+#include "Bundle/PayloadBlock.h"
+#include "Bundle/PrimaryBlock.h"
+#include "Bundle/RoutingSelectionMEB.h"
+#include "Bundle/RouteReportingMEB.h"
+#include "Bundle/ForwardingMEB.h"
+#include "Utils/Logger.h"
 #include "gtest/gtest.h"
 
 TEST(BundleQueueTest, DequeueEmptyQueue) {
@@ -320,3 +338,521 @@ TEST(BundleQueueTest, NoDropIfMorePriority) {
   ASSERT_EQ((int)queue.getSize(), 3);
 }
 
+
+/**
+ * Generates a bundle container with the given priority and lifetime.
+ */
+static std::unique_ptr<BundleContainer> priorityBundle(
+    const std::string &payload, PrimaryBlockControlFlags priority,
+    uint64_t lifetime) {
+  std::unique_ptr<Bundle> b(new Bundle("Me", "Someone", payload));
+  b->getPrimaryBlock()->setPrimaryProcFlag(priority);
+  b->getPrimaryBlock()->setLifetime(lifetime);
+  return std::unique_ptr<BundleContainer>(new BundleContainer(std::move(b)));
+}
+
+TEST(BundleQueueTest, PriorityOrder) {
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024, true);
+  queue.enqueue(priorityBundle("bulk", PrimaryBlockControlFlags::PRIORITY_BULK,
+                               100));
+  queue.enqueue(priorityBundle("normal",
+                               PrimaryBlockControlFlags::PRIORITY_NORMAL,
+                               100));
+  queue.enqueue(priorityBundle("expedited late",
+                               PrimaryBlockControlFlags::PRIORITY_EXPEDITED,
+                               200));
+  queue.enqueue(priorityBundle("expedited soon",
+                               PrimaryBlockControlFlags::PRIORITY_EXPEDITED,
+                               50));
+  const char *order[] = { "expedited soon", "expedited late", "normal",
+      "bulk" };
+  for (auto payload : order) {
+    ASSERT_EQ(payload, queue.dequeue()->getBundle().getPayloadBlock()
+              ->getPayload());
+  }
+  ASSERT_EQ(static_cast<uint32_t>(0), queue.getSize());
+  // By default the queue keeps the arrival order.
+  BundleQueue fifo("/tmp/", "/tmp/", 1024 * 1024);
+  fifo.enqueue(priorityBundle("bulk", PrimaryBlockControlFlags::PRIORITY_BULK,
+                              100));
+  fifo.enqueue(priorityBundle("expedited",
+                              PrimaryBlockControlFlags::PRIORITY_EXPEDITED,
+                              50));
+  ASSERT_EQ("bulk", fifo.dequeue()->getBundle().getPayloadBlock()
+            ->getPayload());
+}
+
+TEST(BundleQueueTest, PriorityRestore) {
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024, true);
+  queue.enqueue(priorityBundle("bulk", PrimaryBlockControlFlags::PRIORITY_BULK,
+                               100));
+  queue.enqueue(priorityBundle("expedited",
+                               PrimaryBlockControlFlags::PRIORITY_EXPEDITED,
+                               100));
+  std::unique_ptr<BundleContainer> bc = queue.dequeue();
+  ASSERT_EQ("expedited", bc->getBundle().getPayloadBlock()->getPayload());
+  // A restored bundle waits for the rest of the queue.
+  queue.resetLast();
+  queue.enqueue(std::move(bc));
+  bc = queue.dequeue();
+  ASSERT_EQ("bulk", bc->getBundle().getPayloadBlock()->getPayload());
+  queue.resetLast();
+  queue.enqueue(std::move(bc));
+  // A new bundle goes before the restored ones.
+  queue.enqueue(priorityBundle("normal",
+                               PrimaryBlockControlFlags::PRIORITY_NORMAL,
+                               100));
+  const char *order[] = { "normal", "expedited", "bulk" };
+  for (auto payload : order) {
+    ASSERT_EQ(payload, queue.dequeue()->getBundle().getPayloadBlock()
+              ->getPayload());
+  }
+}
+
+/**
+ * Generates a bundle container with the given creation time and lifetime.
+ */
+static std::unique_ptr<BundleContainer> policyBundle(
+    const std::string &payload, uint64_t timestamp, uint64_t lifetime) {
+  static uint64_t sequence = 0;
+  std::unique_ptr<Bundle> b(new Bundle("Me", "Someone", payload));
+  b->getPrimaryBlock()->setTimestamp(std::make_pair(timestamp, sequence++));
+  b->getPrimaryBlock()->setLifetime(lifetime);
+  return std::unique_ptr<BundleContainer>(new BundleContainer(std::move(b)));
+}
+
+/**
+ * Fills a queue with the given bundles, enqueues a bundle that needs the room
+ * of one of them and returns the payloads that remain, in dequeue order.
+ */
+static std::vector<std::string> dropOne(
+    BundleQueue &queue, std::vector<std::unique_ptr<BundleContainer>> bundles,
+    std::unique_ptr<BundleContainer> bundle) {
+  for (auto &bc : bundles) {
+    queue.enqueue(std::move(bc));
+  }
+  queue.enqueue(std::move(bundle), false);
+  std::vector<std::string> payloads;
+  while (queue.getSize() > 0) {
+    payloads.push_back(queue.dequeue()->getBundle().getPayloadBlock()
+        ->getPayload());
+  }
+  return payloads;
+}
+
+/**
+ * Returns the size of the bundles of the policy tests, the timestamps and
+ * lifetimes of the tests are encoded with the same length.
+ */
+static uint64_t policySize(const std::vector<std::string> &payloads) {
+  uint64_t size = 0;
+  for (auto &payload : payloads) {
+    size += policyBundle(payload, 0, 0)->getInfo()->getSize();
+  }
+  return size;
+}
+
+TEST(BundleQueueTest, DropPolicyOldest) {
+  BundleQueue queue("/tmp/", "/tmp/", policySize({ "a", "b", "c" }));
+  std::vector<std::unique_ptr<BundleContainer>> bundles;
+  bundles.push_back(policyBundle("a", 30, 100));
+  bundles.push_back(policyBundle("b", 10, 100));
+  bundles.push_back(policyBundle("c", 20, 100));
+  std::vector<std::string> expected = { "a", "c", "d" };
+  ASSERT_EQ(expected, dropOne(queue, std::move(bundles),
+                              policyBundle("d", 40, 100)));
+}
+
+TEST(BundleQueueTest, DropPolicyLargest) {
+  BundleQueue queue("/tmp/", "/tmp/",
+                    policySize({ "a", "bigger payload b", "c" }));
+  std::vector<std::unique_ptr<BundleContainer>> bundles;
+  bundles.push_back(policyBundle("a", 10, 100));
+  bundles.push_back(policyBundle("bigger payload b", 20, 100));
+  bundles.push_back(policyBundle("c", 30, 100));
+  for (auto &bc : bundles) {
+    queue.enqueue(std::move(bc));
+  }
+  // The queued bundles are indexed again.
+  queue.setDropPolicy(DropPolicy::LARGEST);
+  std::vector<std::string> expected = { "a", "c", "payload d" };
+  ASSERT_EQ(expected, dropOne(queue, { }, policyBundle("payload d", 40, 100)));
+}
+
+TEST(BundleQueueTest, DropPolicyShortestLifetime) {
+  BundleQueue queue("/tmp/", "/tmp/", policySize({ "a", "b", "c" }));
+  queue.setDropPolicy(DropPolicy::SHORTEST_LIFETIME);
+  std::vector<std::unique_ptr<BundleContainer>> bundles;
+  bundles.push_back(policyBundle("a", 10, 120));
+  bundles.push_back(policyBundle("b", 10, 100));
+  bundles.push_back(policyBundle("c", 10, 110));
+  std::vector<std::string> expected = { "a", "c", "d" };
+  ASSERT_EQ(expected, dropOne(queue, std::move(bundles),
+                              policyBundle("d", 10, 50)));
+}
+
+TEST(BundleQueueTest, DropPolicyMostForwarded) {
+  BundleQueue queue("/tmp/", "/tmp/", policySize({ "a", "b", "c" }));
+  queue.setDropPolicy(DropPolicy::MOST_FORWARDED);
+  std::vector<std::unique_ptr<BundleContainer>> bundles;
+  bundles.push_back(policyBundle("a", 10, 100));
+  bundles.back()->addForwards(1);
+  bundles.push_back(policyBundle("b", 20, 100));
+  bundles.back()->addForwards(5);
+  bundles.push_back(policyBundle("c", 30, 100));
+  std::vector<std::string> expected = { "a", "c", "d" };
+  ASSERT_EQ(expected, dropOne(queue, std::move(bundles),
+                              policyBundle("d", 40, 100)));
+}
+
+TEST(BundleQueueTest, DropPolicyLeastRecentlyUsed) {
+  BundleQueue queue("/tmp/", "/tmp/", policySize({ "a", "b", "c" }));
+  queue.setDropPolicy(DropPolicy::LEAST_RECENTLY_USED);
+  queue.enqueue(policyBundle("a", 10, 100));
+  queue.enqueue(policyBundle("b", 20, 100));
+  queue.enqueue(policyBundle("c", 30, 100));
+  // The processed bundle is enqueued again, so it is the most recent one.
+  std::unique_ptr<BundleContainer> bc = queue.dequeue();
+  queue.resetLast();
+  queue.enqueue(std::move(bc));
+  std::vector<std::string> expected = { "c", "a", "d" };
+  ASSERT_EQ(expected, dropOne(queue, { }, policyBundle("d", 40, 100)));
+}
+
+TEST(BundleQueueTest, DropPolicyNames) {
+  ASSERT_EQ(DropPolicy::OLDEST, BundleQueue::toDropPolicy("oldest"));
+  ASSERT_EQ(DropPolicy::LARGEST, BundleQueue::toDropPolicy("largest"));
+  ASSERT_EQ(DropPolicy::SHORTEST_LIFETIME,
+            BundleQueue::toDropPolicy("lifetime"));
+  ASSERT_EQ(DropPolicy::MOST_FORWARDED,
+            BundleQueue::toDropPolicy("forwarded"));
+  ASSERT_EQ(DropPolicy::LEAST_RECENTLY_USED, BundleQueue::toDropPolicy("lru"));
+  ASSERT_THROW(BundleQueue::toDropPolicy("newest"), std::invalid_argument);
+}
+
+TEST(BundleQueueTest, PostAndDequeue) {
+  std::unique_ptr<BundleContainer> bc = policyBundle("a", 10, 100);
+  uint64_t size = bc->getInfo()->getSize();
+  BundleQueue queue("/tmp/", "/tmp/", size * 2);
+  std::unique_ptr<Bundle> b(new Bundle(bc->getBundle().toRaw()));
+  queue.post(std::move(bc));
+  // The bundle is counted before being ordered.
+  ASSERT_EQ(1u, queue.getSize());
+  queue.post(policyBundle("b", 20, 100));
+  ASSERT_THROW(queue.post(policyBundle("c", 30, 100)),
+               DroppedBundleQueueException);
+  ASSERT_EQ(2u, queue.getSize());
+  ASSERT_EQ("a", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  queue.resetLast();
+  // The same bundle again is trashed when ordered.
+  queue.post(std::unique_ptr<BundleContainer>(
+      new BundleContainer(std::move(b))));
+  queue.enqueue(policyBundle("c", 30, 100), false);
+  ASSERT_EQ(2u, queue.getSize());
+  ASSERT_EQ("b", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ("c", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(0u, queue.getSize());
+  ASSERT_THROW(queue.dequeue(), EmptyBundleQueueException);
+}
+
+/**
+ * Posts the bundles from the given number of threads while one thread
+ * dequeues them, and returns the time in milliseconds until all the bundles
+ * are received and until all are dequeued.
+ */
+static std::pair<double, double> postConcurrently(
+    BundleQueue &queue, std::vector<std::unique_ptr<BundleContainer>> &bundles,
+    int producers, bool post) {
+  std::atomic<bool> start(false);
+  std::atomic<int> finished(0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.push_back(std::thread([&, p]() {
+      while (!start) {
+        std::this_thread::yield();
+      }
+      for (size_t i = p; i < bundles.size(); i += producers) {
+        if (post) {
+          queue.post(std::move(bundles[i]));
+        } else {
+          queue.enqueue(std::move(bundles[i]));
+        }
+      }
+      finished++;
+    }));
+  }
+  size_t dequeued = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto received = begin;
+  start = true;
+  while (dequeued < bundles.size()) {
+    if (received == begin && finished == producers) {
+      received = std::chrono::steady_clock::now();
+    }
+    try {
+      queue.wait_for(5);
+      queue.dequeue();
+      dequeued++;
+    } catch (const EmptyBundleQueueException &e) {
+      if (finished == producers) {
+        break;
+      }
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(bundles.size(), dequeued);
+  if (received == begin) {
+    received = end;
+  }
+  return std::make_pair(
+      std::chrono::duration<double, std::milli>(received - begin).count(),
+      std::chrono::duration<double, std::milli>(end - begin).count());
+}
+
+/**
+ * Check that no bundle is lost and that the counters are right with many
+ * receivers.
+ */
+TEST(BundleQueueTest, PostStress) {
+  std::vector<std::unique_ptr<BundleContainer>> bundles;
+  uint64_t size = 0;
+  for (int i = 0; i < 20000; ++i) {
+    bundles.push_back(priorityBundle(std::to_string(i),
+                                     PrimaryBlockControlFlags::PRIORITY_BULK,
+                                     100));
+    size += bundles.back()->getInfo()->getSize();
+  }
+  BundleQueue queue("/tmp/", "/tmp/", size, false, 64);
+  postConcurrently(queue, bundles, 16, true);
+  ASSERT_EQ(0u, queue.getSize());
+  // All the room is free again.
+  for (auto &bc : bundles) {
+    ASSERT_EQ(nullptr, bc);
+  }
+  ASSERT_NO_THROW(queue.post(priorityBundle(
+      std::string(size - 200, 'a'), PrimaryBlockControlFlags::PRIORITY_BULK,
+      100)));
+  ASSERT_EQ(1u, queue.getSize());
+}
+
+/**
+ * Generates a bundle container to the given destination, that was last
+ * forwarded to the given nodes.
+ */
+static std::unique_ptr<BundleContainer> contactBundle(
+    const std::string &payload, const std::string &destination,
+    const std::vector<std::string> &nextHops = { }) {
+  std::unique_ptr<BundleContainer> bc(new BundleContainer(
+      std::unique_ptr<Bundle>(new Bundle("Me", destination, payload))));
+  bc->setNextHops(nextHops);
+  return bc;
+}
+
+TEST(BundleQueueTest, ScheduleContact) {
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024);
+  queue.enqueue(contactBundle("a", "node2:app"));
+  queue.enqueue(contactBundle("b", "node3:app", { "node2", "node4" }));
+  queue.enqueue(contactBundle("c", "group:1"));
+  queue.enqueue(contactBundle("d", "node3"));
+  ASSERT_THROW(queue.dequeueScheduled(), EmptyBundleQueueException);
+  ASSERT_EQ(0u, queue.schedule({ "node5" }));
+  // By node id, and by the last next hops.
+  ASSERT_EQ(2u, queue.schedule({ "node2" }));
+  // By endpoint, the bundles already scheduled are not counted again.
+  ASSERT_EQ(1u, queue.schedule({ "node4", "group:1" }));
+  const char *order[] = { "a", "b", "c" };
+  for (auto payload : order) {
+    ASSERT_EQ(payload, queue.dequeueScheduled()->getBundle().getPayloadBlock()
+        ->getPayload());
+  }
+  ASSERT_THROW(queue.dequeueScheduled(), EmptyBundleQueueException);
+  ASSERT_EQ(1u, queue.getSize());
+  ASSERT_EQ(1u, queue.schedule({ "node3" }));
+  // A scheduled bundle dequeued in a normal pass is not scheduled anymore.
+  ASSERT_EQ("d", queue.dequeue()->getBundle().getPayloadBlock()
+      ->getPayload());
+  ASSERT_THROW(queue.dequeueScheduled(), EmptyBundleQueueException);
+}
+
+/**
+ * Check that the expired bundles are removed from the queue.
+ */
+TEST(BundleQueueTest, ExpireBundles) {
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024);
+  queue.enqueue(policyBundle("a", 100, 50));
+  queue.enqueue(policyBundle("b", 100, 10));
+  queue.enqueue(policyBundle("c", 120, 10));
+  queue.post(policyBundle("d", 90, 10));
+  queue.enqueue(policyBundle("e", 100, 100000));
+  ASSERT_TRUE(queue.expire(100).empty());
+  std::vector<std::unique_ptr<BundleContainer>> expired = queue.expire(111);
+  // In order of expiration.
+  ASSERT_EQ(2u, expired.size());
+  ASSERT_EQ("d", expired[0]->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ("b", expired[1]->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(3u, queue.getSize());
+  // A dequeued bundle expires after it is enqueued again.
+  queue.wait_for(1);
+  std::unique_ptr<BundleContainer> bc = queue.dequeue();
+  ASSERT_EQ("a", bc->getBundle().getPayloadBlock()->getPayload());
+  queue.resetLast();
+  queue.enqueue(std::move(bc));
+  ASSERT_TRUE(queue.expire(130).empty());
+  expired = queue.expire(151);
+  ASSERT_EQ(2u, expired.size());
+  ASSERT_EQ("c", expired[0]->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ("a", expired[1]->getBundle().getPayloadBlock()->getPayload());
+  // The expired bundles are not notified anymore.
+  queue.wait_for(1);
+  ASSERT_EQ("e", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_THROW(queue.wait_for(1), EmptyBundleQueueException);
+  ASSERT_EQ(0u, queue.getSize());
+}
+
+/**
+ * Returns the files of a directory.
+ */
+static std::vector<std::string> listDirectory(const std::string &path) {
+  std::vector<std::string> files;
+  DIR *dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return files;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      files.push_back(path + entry->d_name);
+    }
+  }
+  closedir(dir);
+  return files;
+}
+
+/**
+ * Check that the bundles that do not fit in memory are paged out, and that
+ * they are loaded back as they were.
+ */
+TEST(BundleQueueTest, Paging) {
+  char pagePath[] = "/tmp/adtnPageXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(pagePath));
+  std::string path = std::string(pagePath) + "/";
+  BundleQueue queue("/tmp/", "/tmp/", 1024 * 1024);
+  uint64_t size = contactBundle("0", "node1:app")->getInfo()->getSize();
+  queue.setPaging(path, 2 * size);
+  for (int i = 0; i < 5; ++i) {
+    std::unique_ptr<BundleContainer> bc = contactBundle(
+        std::to_string(i), i % 2 == 0 ? "node1:app" : "node2:app",
+        { "hop" + std::to_string(i) });
+    bc->addForwards(i);
+    bc->getState()["index"] = i;
+    queue.enqueue(std::move(bc));
+  }
+  // The first two bundles are kept in memory.
+  ASSERT_EQ(5u, queue.getSize());
+  ASSERT_EQ(2 * size, queue.getMemoryByteSize());
+  ASSERT_EQ(3u, listDirectory(path).size());
+  ASSERT_EQ("0", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(size, queue.getMemoryByteSize());
+  // The contact loads its paged out bundle, it fits in memory.
+  ASSERT_EQ(2u, queue.schedule({ "node2" }));
+  ASSERT_EQ(2 * size, queue.getMemoryByteSize());
+  ASSERT_EQ("1", queue.dequeueScheduled()->getBundle().getPayloadBlock()
+      ->getPayload());
+  std::unique_ptr<BundleContainer> bc = queue.dequeueScheduled();
+  ASSERT_EQ("3", bc->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(3u, bc->getForwards());
+  ASSERT_EQ(std::vector<std::string>({ "hop3" }), bc->getNextHops());
+  ASSERT_EQ(0u, queue.getMemoryByteSize());
+  // The rest are loaded when dequeued.
+  for (int i : { 2, 4 }) {
+    bc = queue.dequeue();
+    ASSERT_EQ(std::to_string(i), bc->getBundle().getPayloadBlock()
+        ->getPayload());
+    ASSERT_EQ(static_cast<uint32_t>(i), bc->getForwards());
+    ASSERT_EQ(std::vector<std::string>({ "hop" + std::to_string(i) }),
+              bc->getNextHops());
+    ASSERT_EQ(i, bc->getState()["index"]);
+    ASSERT_EQ(0u, queue.getMemoryByteSize());
+  }
+  ASSERT_EQ(0u, queue.getSize());
+  // A paged out bundle that can not be loaded is lost.
+  queue.enqueue(contactBundle("5", "node1:app"));
+  queue.enqueue(contactBundle("6", "node1:app"));
+  queue.enqueue(contactBundle("7", "node1:app"));
+  for (auto &file : listDirectory(path)) {
+    std::remove(file.c_str());
+  }
+  ASSERT_EQ("5", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ("6", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_THROW(queue.dequeue(), EmptyBundleQueueException);
+  ASSERT_EQ(0u, queue.getSize());
+  ASSERT_EQ(0, rmdir(pagePath));
+}
+
+/**
+ * Returns the inode of a file, 0 if it does not exist.
+ */
+static ino_t getInode(const std::string &file) {
+  struct stat status;
+  return stat(file.c_str(), &status) == 0 ? status.st_ino : 0;
+}
+
+/**
+ * Check that the persisted bundles are not written again when paged out, and
+ * that the paged out bundles are moved, not loaded, when they are dropped or
+ * expired.
+ */
+TEST(BundleQueueTest, PagingDropAndExpire) {
+  char pagePath[] = "/tmp/adtnPageXXXXXX";
+  char dropPath[] = "/tmp/adtnDropXXXXXX";
+  char trashPath[] = "/tmp/adtnTrashXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(pagePath));
+  ASSERT_NE(nullptr, mkdtemp(dropPath));
+  ASSERT_NE(nullptr, mkdtemp(trashPath));
+  std::string path = std::string(pagePath) + "/";
+  std::string drop = std::string(dropPath) + "/";
+  std::string trash = std::string(trashPath) + "/";
+  uint64_t size = policyBundle("x", 100, 10)->getInfo()->getSize();
+  BundleQueue queue(trash, drop, 3 * size);
+  queue.setPaging(path, size);
+  queue.setDropPolicy(DropPolicy::SHORTEST_LIFETIME);
+  std::unique_ptr<BundleContainer> bc = policyBundle("a", 100, 50);
+  queue.saveBundleToDisk(path, *bc);
+  queue.enqueue(std::move(bc));
+  bc = policyBundle("b", 100, 10);
+  queue.saveBundleToDisk(path, *bc);
+  std::string pageFile = path + bc->getInfo()->getId() + ".bundle";
+  ino_t inode = getInode(pageFile);
+  ASSERT_NE(0u, inode);
+  queue.enqueue(std::move(bc));
+  // The persisted bundle is paged out without writing it again.
+  ASSERT_EQ(size, queue.getMemoryByteSize());
+  ASSERT_EQ(inode, getInode(pageFile));
+  bc = policyBundle("c", 100, 100);
+  std::string expiredFile = path + bc->getInfo()->getId() + ".bundle";
+  queue.enqueue(std::move(bc));
+  ASSERT_NE(0u, getInode(expiredFile));
+  // The dropped paged out bundle is moved to the drop path.
+  queue.enqueue(policyBundle("d", 100, 120), false);
+  ASSERT_EQ(0u, getInode(pageFile));
+  ASSERT_EQ(1u, listDirectory(drop).size());
+  ASSERT_EQ(3u, queue.getSize());
+  // The expired paged out bundle is moved to the trash path.
+  std::vector<std::unique_ptr<BundleContainer>> expired = queue.expire(201);
+  ASSERT_EQ(1u, expired.size());
+  ASSERT_EQ("a", expired[0]->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(0u, getInode(expiredFile));
+  ASSERT_EQ(1u, listDirectory(trash).size());
+  ASSERT_EQ("d", queue.dequeue()->getBundle().getPayloadBlock()->getPayload());
+  ASSERT_EQ(0u, queue.getSize());
+  for (auto &directory : { path, drop, trash }) {
+    for (auto &file : listDirectory(directory)) {
+      std::remove(file.c_str());
+    }
+  }
+  ASSERT_EQ(0, rmdir(pagePath));
+  ASSERT_EQ(0, rmdir(dropPath));
+  ASSERT_EQ(0, rmdir(trashPath));
+}
@@ -38,7 +38,7 @@ TEST(RouteReportingBCTest, FilledConstructor) {
   time(&t2);
   std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
         new Bundle("node1", "Someone", "This is a test bundle"));
-  Bundle b1 = *b.get();
+  Bundle b1(b->toRaw());
   RouteReportingBC rrbc = RouteReportingBC("node1", t1, t2, std::move(b));
 
   ASSERT_EQ("node1", rrbc.getNodeId());
@@ -55,7 +55,7 @@ TEST(RouteReportingBCTest, RawConstructor) {
   time(&t2);
   std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
       new Bundle("node1", "Someone", "This is a test bundle"));
-  Bundle b1 = *b.get();
+  Bundle b1(b->toRaw());
   RouteReportingBC rrbc = RouteReportingBC("node1", t1, t2, std::move(b));
   std::string rrbc_serialized = rrbc.serialize();
 
@@ -68,6 +68,22 @@ TEST(RouteReportingBCTest, RawConstructor) {
   // ASSERT_EQ(rrbc.toString(), rrbc2.toString());
 }
 
+TEST(RouteReportingBCTest, RawWithNewLines) {
+  time_t t1 = 1000;
+  time_t t2 = 2000;
+  std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
+      new Bundle("node1", "Someone", "First line\nSecond line\n"));
+  std::string raw = b->toRaw();
+  RouteReportingBC rrbc = RouteReportingBC("node1", t1, t2, std::move(b));
+  std::string rrbc_serialized = rrbc.serialize();
+
+  // The times are after the last new lines, not after the first one.
+  RouteReportingBC rrbc2 = RouteReportingBC(rrbc_serialized);
+  ASSERT_EQ(raw, rrbc2.getBundle().toRaw());
+  ASSERT_EQ(t1, rrbc2.getArrivalTime());
+  ASSERT_EQ(t2, rrbc2.getDepartureTime());
+}
+
 TEST(RouteReportingBCTest, toStringMethod) {
   time_t t1;
   time(&t1);
@@ -75,7 +91,7 @@ TEST(RouteReportingBCTest, toStringMethod) {
   time(&t2);
   std::unique_ptr<Bundle> b = std::unique_ptr<Bundle>(
       new Bundle("node1", "Someone", "This is a test bundle"));
-  Bundle b1 = *b.get();
+  Bundle b1(b->toRaw());
   RouteReportingBC rrbc = RouteReportingBC("node1", t1, t2, std::move(b));
 
   std::string rrbc_string = "From: null\nBundle: \n" +
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE ArenaTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the Arena class.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bundle/Bundle.h"
+#include "Bundle/PayloadBlock.h"
+#include "Utils/Arena.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the alignment and the growth of the arena.
+ */
+TEST(ArenaTest, Allocate) {
+  Arena arena(128);
+  ASSERT_EQ(0u, arena.getReservedBytes());
+  void *a = arena.allocate(3, 1);
+  void *b = arena.allocate(8, 8);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 8);
+  ASSERT_NE(a, b);
+  ASSERT_EQ(11u, arena.getAllocatedBytes());
+  size_t reserved = arena.getReservedBytes();
+  ASSERT_GE(reserved, 128u);
+  void *big = arena.allocate(1000, 16);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(big) % 16);
+  ASSERT_GT(arena.getReservedBytes(), reserved + 1000);
+}
+
+/**
+ * Check that the standard containers can use the arena.
+ */
+TEST(ArenaTest, Allocator) {
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  std::vector<int, ArenaAllocator<int>> values{ArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(i);
+  }
+  ASSERT_EQ(999, values.back());
+  ASSERT_GE(arena.use_count(), 2);
+  std::shared_ptr<std::string> s = makeShared<std::string>(arena, "test");
+  ASSERT_EQ("test", *s);
+  ASSERT_GE(arena->getAllocatedBytes(), 1000 * sizeof(int));
+}
+
+/**
+ * Check that the blocks keep the arena alive when the bundle is destroyed.
+ */
+TEST(ArenaTest, BundleArena) {
+  std::string raw = Bundle("Source", "Destination", "Payload").toRaw();
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  std::weak_ptr<Arena> weakArena = arena;
+  std::shared_ptr<PayloadBlock> payload;
+  {
+    Bundle b(raw, arena);
+    arena.reset();
+    ASSERT_EQ(raw, b.toRaw());
+    payload = b.getPayloadBlock();
+    ASSERT_GT(weakArena.lock()->getAllocatedBytes(), 0u);
+  }
+  ASSERT_FALSE(weakArena.expired());
+  ASSERT_EQ("Payload", payload->getPayload());
+  payload.reset();
+  ASSERT_TRUE(weakArena.expired());
+}
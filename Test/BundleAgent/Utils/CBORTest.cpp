@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CBORTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the CBOR functions.
+ */
+
+#include <stdexcept>
+#include <string>
+#include "Utils/CBOR.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the encoding of the heads with the values of the RFC 8949.
+ */
+TEST(CBORTest, EncodeHead) {
+  std::string buffer;
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 0);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 23);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 24);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 1000);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 1000000);
+  CBOR::appendHead(buffer, CBOR::UNSIGNED_INTEGER, 1000000000000);
+  CBOR::appendHead(buffer, CBOR::TEXT_STRING, 1);
+  CBOR::appendHead(buffer, CBOR::ARRAY, 3);
+  ASSERT_EQ(std::string("\x00\x17\x18\x18\x19\x03\xE8\x1A\x00\x0F\x42\x40"
+                        "\x1B\x00\x00\x00\xE8\xD4\xA5\x10\x00\x61\x83", 23),
+            buffer);
+  ASSERT_EQ(1u, CBOR::getHeadLength(23));
+  ASSERT_EQ(2u, CBOR::getHeadLength(255));
+  ASSERT_EQ(3u, CBOR::getHeadLength(256));
+  ASSERT_EQ(5u, CBOR::getHeadLength(0xFFFFFFFF));
+  ASSERT_EQ(9u, CBOR::getHeadLength(0x100000000));
+}
+
+/**
+ * Check the decoding of the heads and the errors.
+ */
+TEST(CBORTest, DecodeHead) {
+  const uint64_t values[] = { 0, 23, 24, 255, 256, 65535, 65536, 0xFFFFFFFF,
+      0x100000000, 0xFFFFFFFFFFFFFFFF };
+  for (auto value : values) {
+    std::string buffer;
+    CBOR::appendHead(buffer, CBOR::BYTE_STRING, value);
+    const uint8_t *data = reinterpret_cast<const uint8_t*>(buffer.data());
+    const uint8_t *end = data + buffer.size();
+    uint8_t type;
+    uint64_t decoded;
+    ASSERT_EQ(buffer.size(), CBOR::decodeHead(data, end, type, decoded));
+    ASSERT_EQ(CBOR::BYTE_STRING, type);
+    ASSERT_EQ(value, decoded);
+    ASSERT_EQ(value, CBOR::decodeHead(data, end, CBOR::BYTE_STRING));
+    ASSERT_EQ(end, data);
+    if (buffer.size() > 1) {
+      data = reinterpret_cast<const uint8_t*>(buffer.data());
+      ASSERT_THROW(CBOR::decodeHead(data, end - 1, type, decoded),
+                   std::out_of_range);
+    }
+  }
+  std::string buffer = "\x9F\x18";
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(buffer.data());
+  uint8_t type;
+  uint64_t value;
+  ASSERT_THROW(CBOR::decodeHead(data, data + 1, type, value),
+               std::invalid_argument);
+  ASSERT_THROW(CBOR::decodeHead(data, data, type, value), std::out_of_range);
+  ASSERT_THROW(CBOR::decodeHead(data + 1, data + 2, type, value),
+               std::out_of_range);
+  buffer = "\x61";
+  data = reinterpret_cast<const uint8_t*>(buffer.data());
+  ASSERT_THROW(CBOR::decodeHead(data, data + 1, CBOR::UNSIGNED_INTEGER),
+               std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE CRC32CTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the CRC32C functions.
+ */
+
+#include <random>
+#include <string>
+#include "Utils/CRC32C.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the known values of the CRC32C.
+ */
+TEST(CRC32CTest, KnownValues) {
+  std::string check = "123456789";
+  ASSERT_EQ(0xE3069283u, CRC32C::compute(check.data(), check.size()));
+  ASSERT_EQ(0xE3069283u, CRC32C::extendPortable(0, check.data(),
+                                                check.size()));
+  std::string zeros(32, '\0');
+  ASSERT_EQ(0x8A9136AAu, CRC32C::compute(zeros.data(), zeros.size()));
+  std::string ones(32, '\xFF');
+  ASSERT_EQ(0x62A8AB43u, CRC32C::compute(ones.data(), ones.size()));
+  ASSERT_EQ(0u, CRC32C::compute(nullptr, 0));
+}
+
+/**
+ * Check that the CRC can be computed in pieces, and that the processor
+ * instructions and the tables give the same values for every alignment.
+ */
+TEST(CRC32CTest, Extend) {
+  std::mt19937 generator(7);
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data.push_back(static_cast<char>(generator()));
+  }
+  uint32_t crc = CRC32C::compute(data.data(), data.size());
+  for (size_t split = 0; split < 20; ++split) {
+    uint32_t first = CRC32C::compute(data.data(), split);
+    ASSERT_EQ(crc, CRC32C::extend(first, data.data() + split,
+                                  data.size() - split));
+  }
+  for (size_t start = 0; start < 16; ++start) {
+    for (size_t length = 0; length < 40; ++length) {
+      ASSERT_EQ(CRC32C::extendPortable(0, data.data() + start, length),
+                CRC32C::compute(data.data() + start, length));
+    }
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE IntervalIndexTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the IntervalIndex class.
+ */
+
+#include "Utils/IntervalIndex.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that the ranges are merged and the covered length is right.
+ */
+TEST(IntervalIndexTest, Insert) {
+  IntervalIndex index;
+  ASSERT_EQ(0u, index.getCoveredLength());
+  ASSERT_FALSE(index.contains(0, 1));
+  ASSERT_EQ(10u, index.insert(10, 20));
+  ASSERT_EQ(10u, index.insert(30, 40));
+  ASSERT_EQ(2u, index.getNumberOfIntervals());
+  // Repeated and overlapping ranges only add the new positions.
+  ASSERT_EQ(0u, index.insert(12, 18));
+  ASSERT_EQ(5u, index.insert(15, 25));
+  ASSERT_EQ(2u, index.getNumberOfIntervals());
+  ASSERT_TRUE(index.contains(10, 25));
+  ASSERT_FALSE(index.contains(10, 26));
+  // Touching ranges are merged.
+  ASSERT_EQ(5u, index.insert(25, 30));
+  ASSERT_EQ(1u, index.getNumberOfIntervals());
+  ASSERT_TRUE(index.contains(10, 40));
+  ASSERT_EQ(30u, index.getCoveredLength());
+  ASSERT_EQ(20u, index.insert(0, 50));
+  ASSERT_EQ(1u, index.getNumberOfIntervals());
+  ASSERT_EQ(50u, index.getCoveredLength());
+  ASSERT_EQ(0u, index.insert(5, 5));
+}
+
+/**
+ * Check the covered length with many reversed ranges.
+ */
+TEST(IntervalIndexTest, ManyRanges) {
+  IntervalIndex index;
+  for (uint64_t i = 1000; i > 0; --i) {
+    index.insert((i - 1) * 10, (i - 1) * 10 + 5);
+  }
+  ASSERT_EQ(1000u, index.getNumberOfIntervals());
+  ASSERT_EQ(5000u, index.getCoveredLength());
+  for (uint64_t i = 0; i < 1000; ++i) {
+    index.insert(i * 10 + 5, i * 10 + 10);
+  }
+  ASSERT_EQ(1u, index.getNumberOfIntervals());
+  ASSERT_TRUE(index.contains(0, 10000));
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE MappedFileTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the MappedFile class.
+ */
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "Utils/MappedFile.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that a file is mapped and stays mapped after being removed.
+ */
+TEST(MappedFileTest, MapPath) {
+  std::string content(10000, 'a');
+  content += "end";
+  {
+    std::ofstream file("/tmp/mappedFileTest", std::ofstream::binary);
+    file << content;
+  }
+  MappedFile mapped("/tmp/mappedFileTest");
+  std::remove("/tmp/mappedFileTest");
+  ASSERT_EQ(content.size(), mapped.size());
+  ASSERT_EQ(content, std::string(mapped.data(), mapped.size()));
+  ASSERT_THROW(MappedFile("/tmp/mappedFileTest"), MappedFileException);
+}
+
+/**
+ * Check that the temporary files can be mapped and are not left in the
+ * directory.
+ */
+TEST(MappedFileTest, Temporary) {
+  int fd = MappedFile::createTemporary("/tmp/");
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(4, write(fd, "test", 4));
+  MappedFile mapped(fd);
+  close(fd);
+  ASSERT_EQ("test", std::string(mapped.data(), mapped.size()));
+  ASSERT_EQ(-1, MappedFile::createTemporary("/nonexistent/"));
+  fd = MappedFile::createTemporary("/tmp/");
+  MappedFile empty(fd);
+  close(fd);
+  ASSERT_EQ(0u, empty.size());
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE MpscRingTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the MpscRing class.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Utils/MpscRing.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the order of the values and the full and empty ring.
+ */
+TEST(MpscRingTest, PushPop) {
+  MpscRing<int> ring(3);
+  ASSERT_EQ(4u, ring.getCapacity());
+  int value;
+  ASSERT_FALSE(ring.pop(value));
+  // Several rounds over the cells.
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(ring.push(round * 10 + i));
+    }
+    ASSERT_FALSE(ring.push(100));
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(ring.pop(value));
+      ASSERT_EQ(round * 10 + i, value);
+    }
+    ASSERT_FALSE(ring.pop(value));
+  }
+}
+
+/**
+ * Check that no value is lost or reordered with many producers.
+ */
+TEST(MpscRingTest, Stress) {
+  const int producers = 8;
+  const uint64_t values = 200000;
+  MpscRing<uint64_t> ring(256);
+  std::atomic<bool> start(false);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.push_back(std::thread([&ring, &start, p, values]() {
+      while (!start) {
+        std::this_thread::yield();
+      }
+      for (uint64_t i = 0; i < values; ++i) {
+        uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+        while (!ring.push(value)) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+  start = true;
+  std::vector<uint64_t> next(producers, 0);
+  uint64_t received = 0;
+  while (received < producers * values) {
+    uint64_t value;
+    if (ring.pop(value)) {
+      uint64_t p = (value >> 32) % producers;
+      // The values of a producer arrive in order.
+      EXPECT_EQ(next[p], value & 0xFFFFFFFF);
+      next[p]++;
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  uint64_t value;
+  ASSERT_FALSE(ring.pop(value));
+}
@@ -24,6 +24,8 @@
 
 #include <string>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 #include "Utils/SDNV.h"
 #include "gtest/gtest.h"
 
@@ -133,3 +135,74 @@ TEST(SDNVTest, EncodeDecodeStringTest) {
     coded = coded.substr(size);
   }
 }
+
+/**
+ * Check the pointer encoder and decoder.
+ * Encode a value into a caller buffer and decode it from there,
+ * the returned lengths and the decoded value must match the original.
+ */
+TEST(SDNVTest, PointerEncodeDecodeTest) {
+  uint64_t values[6] = { 0, 127, 15789, 9123456, 4294967295,
+      UINT64_MAX };
+  uint8_t buffer[SDNV::MAX_LENGTH];
+  for (int i = 0; i < 6; ++i) {
+    size_t length = SDNV::encode(values[i], buffer,
+                                 buffer + SDNV::MAX_LENGTH);
+    ASSERT_EQ(SDNV::getLength(values[i]), length);
+    ASSERT_EQ(SDNV::encode(values[i]),
+              std::string(reinterpret_cast<char*>(buffer), length));
+    uint64_t value = 0;
+    ASSERT_EQ(length, SDNV::decode(buffer, buffer + length, value));
+    ASSERT_EQ(values[i], value);
+  }
+}
+
+/**
+ * Check the batch decoder.
+ * Encode consecutive values and decode all of them in one call.
+ */
+TEST(SDNVTest, BatchDecodeTest) {
+  uint64_t values[5] = { 127, 15788, 45321, 9456789, 4123645897 };
+  std::stringstream ss;
+  for (int i = 0; i < 5; ++i) {
+    ss << SDNV::encode(values[i]);
+  }
+  std::string coded = ss.str();
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(coded.data());
+  uint64_t decoded[5];
+  ASSERT_EQ(coded.size(),
+            SDNV::decode(data, data + coded.size(), decoded, 5));
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(values[i], decoded[i]);
+  }
+}
+
+/**
+ * Check that truncated or too small buffers are reported.
+ */
+TEST(SDNVTest, OutOfBufferTest) {
+  std::string coded = SDNV::encode(9123456);
+  const uint8_t *data = reinterpret_cast<const uint8_t*>(coded.data());
+  uint64_t value = 0;
+  ASSERT_THROW(SDNV::decode(data, data + coded.size() - 1, value),
+               std::out_of_range);
+  ASSERT_THROW(SDNV::decode(coded.substr(0, 2)), std::out_of_range);
+  std::string tooLong(SDNV::MAX_LENGTH + 1, static_cast<char>(0x80));
+  ASSERT_THROW(SDNV::decode(tooLong), std::out_of_range);
+  uint8_t buffer[2];
+  ASSERT_THROW(SDNV::encode(9123456, buffer, buffer + 2), std::out_of_range);
+}
+
+/**
+ * Check that SDNVs holding more than 64 bits are rejected.
+ */
+TEST(SDNVTest, OverflowTest) {
+  std::string coded = SDNV::encode(0xFFFFFFFFFFFFFFFF);
+  ASSERT_EQ(SDNV::MAX_LENGTH, coded.size());
+  ASSERT_EQ(0xFFFFFFFFFFFFFFFF, SDNV::decode(coded));
+  coded[0] = static_cast<char>(0x83);
+  ASSERT_THROW(SDNV::decode(coded), std::out_of_range);
+  std::string wide(SDNV::MAX_LENGTH - 1, static_cast<char>(0xFF));
+  wide += static_cast<char>(0x7F);
+  ASSERT_THROW(SDNV::decode(wide), std::out_of_range);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE SeenFilterTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the SeenFilter class.
+ */
+
+#include <cstdio>
+#include <string>
+#include "Utils/SeenFilter.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that the keys are remembered during the window and then forgotten.
+ */
+TEST(SeenFilterTest, Window) {
+  SeenFilter filter(60, 1000);
+  ASSERT_FALSE(filter.contains("node1 100 1", 1000));
+  filter.insert("node1 100 1", 1000);
+  ASSERT_TRUE(filter.contains("node1 100 1", 1000));
+  ASSERT_FALSE(filter.contains("node1 100 2", 1000));
+  filter.insert("node1 100 2", 1059);
+  // The first generation is the previous one now.
+  filter.insert("node1 100 3", 1061);
+  ASSERT_TRUE(filter.contains("node1 100 1", 1061));
+  ASSERT_TRUE(filter.contains("node1 100 2", 1110));
+  // After two windows the first generation is cleared.
+  ASSERT_TRUE(filter.contains("node1 100 3", 1121));
+  ASSERT_FALSE(filter.contains("node1 100 1", 1121));
+  ASSERT_FALSE(filter.contains("node1 100 2", 1121));
+  // A long silence forgets everything.
+  ASSERT_FALSE(filter.contains("node1 100 3", 5000));
+}
+
+/**
+ * Check that the memory does not grow with the keys, and the false
+ * positive rate.
+ */
+TEST(SeenFilterTest, Capacity) {
+  const int capacity = 10000;
+  SeenFilter filter(600, capacity);
+  uint64_t byteSize = filter.getByteSize();
+  ASSERT_GE(byteSize, static_cast<uint64_t>(capacity * 2.5));
+  for (int i = 0; i < capacity; ++i) {
+    filter.insert("node1 " + std::to_string(i) + " 0", 1000);
+  }
+  for (int i = 0; i < capacity; ++i) {
+    ASSERT_TRUE(filter.contains("node1 " + std::to_string(i) + " 0", 1000));
+  }
+  int falsePositives = 0;
+  for (int i = 0; i < capacity; ++i) {
+    if (filter.contains("node2 " + std::to_string(i) + " 0", 1000)) {
+      falsePositives++;
+    }
+  }
+  ASSERT_LT(falsePositives, capacity / 50);
+  // A full generation is rotated, the keys of two generations are kept.
+  for (int i = 0; i < 2 * capacity; ++i) {
+    filter.insert("node3 " + std::to_string(i) + " 0", 1000);
+  }
+  ASSERT_EQ(byteSize, filter.getByteSize());
+  ASSERT_TRUE(filter.contains("node3 " + std::to_string(2 * capacity - 1)
+                              + " 0", 1000));
+  falsePositives = 0;
+  for (int i = 0; i < capacity; ++i) {
+    if (filter.contains("node1 " + std::to_string(i) + " 0", 1000)) {
+      falsePositives++;
+    }
+  }
+  ASSERT_LT(falsePositives, capacity / 25);
+}
+
+/**
+ * Check that the filter is restored from a file.
+ */
+TEST(SeenFilterTest, Persistence) {
+  std::string path = "/tmp/SeenFilterTest.filter";
+  SeenFilter filter(60, 1000);
+  filter.insert("node1 100 1", 1000);
+  filter.insert("node1 100 2", 1070);
+  ASSERT_TRUE(filter.save(path));
+  SeenFilter restored(60, 1000);
+  ASSERT_TRUE(restored.load(path));
+  ASSERT_TRUE(restored.contains("node1 100 1", 1070));
+  ASSERT_TRUE(restored.contains("node1 100 2", 1070));
+  ASSERT_FALSE(restored.contains("node1 100 3", 1070));
+  // The windows keep going after the restart.
+  ASSERT_FALSE(restored.contains("node1 100 1", 1140));
+  // A filter with other parameters is not loaded.
+  SeenFilter other(60, 2000);
+  ASSERT_FALSE(other.load(path));
+  ASSERT_FALSE(other.contains("node1 100 1", 1070));
+  ASSERT_FALSE(other.load("/tmp/SeenFilterTestMissing.filter"));
+  std::remove(path.c_str());
+}
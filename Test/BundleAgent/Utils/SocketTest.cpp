@@ -0,0 +1,70 @@
+/*
+* Copyright (c) 2018 SeNDA
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+*/
+/**
+ * FILE SocketTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Jan 11, 2018
+ * VERSION 1
+ * This file contains the test of the Socket Class.
+ */
+
+#include <arpa/inet.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Utils/Socket.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check the send of a list of buffers.
+ * A length prefix, a small header and a large body are sent in one call,
+ * the receiver must get them in order as a single stream.
+ */
+TEST(SocketTest, SendBuffers) {
+  Socket server = Socket();
+  ASSERT_TRUE(server.setReuseAddress());
+  ASSERT_TRUE(server.bind("127.0.0.1", 40123));
+  ASSERT_TRUE(server.listen(1));
+  std::string header = "header";
+  std::string body(8 * 1024 * 1024, 'b');
+  body[0] = 'c';
+  body[body.size() - 1] = 'd';
+  uint32_t length = htonl(header.size() + body.size());
+  std::thread sender([&]() {
+    Socket client = Socket();
+    ASSERT_TRUE(client.connect("127.0.0.1", 40123));
+    std::vector<ConstBuffer> buffers;
+    buffers.push_back(
+        ConstBuffer(reinterpret_cast<const char*>(&length), sizeof(length)));
+    buffers.push_back(ConstBuffer(header.data(), header.size()));
+    buffers.push_back(ConstBuffer(body.data(), 0));
+    buffers.push_back(ConstBuffer(body.data(), body.size()));
+    EXPECT_TRUE(client << buffers);
+    client.close();
+  });
+  Socket s = Socket(-1);
+  ASSERT_TRUE(server.accept(5, s));
+  uint32_t receivedLength = 0;
+  ASSERT_TRUE(s >> receivedLength);
+  ASSERT_EQ(header.size() + body.size(), receivedLength);
+  std::string received;
+  ASSERT_TRUE(s >> StringWithSize(received, receivedLength));
+  ASSERT_EQ(header + body, received);
+  sender.join();
+  s.close();
+  server.close();
+}
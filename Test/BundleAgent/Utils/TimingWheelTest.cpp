@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016 SeNDA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+/**
+ * FILE TimingWheelTest.cpp
+ * AUTHOR Blackcatn13
+ * DATE Oct 17, 2026
+ * VERSION 1
+ * This file contains the test of the TimingWheel class.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "Utils/TimingWheel.h"
+#include "gtest/gtest.h"
+
+/**
+ * Check that the values expire after their deadline, at any level.
+ */
+TEST(TimingWheelTest, Expire) {
+  TimingWheel<int> wheel(1000);
+  wheel.add(1000, 1);
+  wheel.add(1010, 2);
+  wheel.add(1000 + 70, 3);
+  wheel.add(1000 + 5000, 4);
+  wheel.add(1000 + 300000, 5);
+  wheel.add(1000 + 20000000, 6);
+  ASSERT_EQ(6u, wheel.getSize());
+  std::vector<int> expired;
+  wheel.advance(1000, expired);
+  ASSERT_TRUE(expired.empty());
+  wheel.advance(1001, expired);
+  ASSERT_EQ(std::vector<int>({ 1 }), expired);
+  expired.clear();
+  wheel.advance(1010, expired);
+  ASSERT_TRUE(expired.empty());
+  wheel.advance(1011, expired);
+  ASSERT_EQ(std::vector<int>({ 2 }), expired);
+  expired.clear();
+  wheel.advance(1000 + 5000, expired);
+  ASSERT_EQ(std::vector<int>({ 3 }), expired);
+  expired.clear();
+  wheel.advance(1000 + 5001, expired);
+  ASSERT_EQ(std::vector<int>({ 4 }), expired);
+  expired.clear();
+  wheel.advance(1000 + 20000000, expired);
+  ASSERT_EQ(std::vector<int>({ 5 }), expired);
+  expired.clear();
+  wheel.advance(1000 + 20000001, expired);
+  ASSERT_EQ(std::vector<int>({ 6 }), expired);
+  ASSERT_EQ(0u, wheel.getSize());
+  // A value that has already expired is returned at the next advance.
+  expired.clear();
+  wheel.add(50, 7);
+  wheel.advance(1000 + 20000001, expired);
+  ASSERT_EQ(std::vector<int>({ 7 }), expired);
+}
+
+/**
+ * Check that the removed values do not expire.
+ */
+TEST(TimingWheelTest, Remove) {
+  TimingWheel<int> wheel(0);
+  TimingWheel<int>::Handle first = wheel.add(100, 1);
+  wheel.add(100, 2);
+  TimingWheel<int>::Handle far = wheel.add(100000000, 3);
+  wheel.remove(first);
+  wheel.remove(far);
+  ASSERT_EQ(1u, wheel.getSize());
+  std::vector<int> expired;
+  wheel.advance(200000000, expired);
+  ASSERT_EQ(std::vector<int>({ 2 }), expired);
+  ASSERT_EQ(0u, wheel.getSize());
+}
+
+/**
+ * Check the wheel against a sorted map, with random deadlines and advances.
+ */
+TEST(TimingWheelTest, Random) {
+  std::mt19937_64 random(13);
+  const uint64_t start = 800000000;
+  TimingWheel<int> wheel(0);
+  std::multimap<uint64_t, int> deadlines;
+  std::map<int, std::pair<uint64_t, TimingWheel<int>::Handle>> handles;
+  uint64_t now = start;
+  std::vector<int> expired;
+  wheel.advance(now, expired);
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t span = 1ULL << (random() % 28);
+    uint64_t deadline = now - 10 + random() % span;
+    handles[i] = std::make_pair(deadline, wheel.add(deadline, i));
+    deadlines.emplace(deadline, i);
+    if (random() % 4 == 0) {
+      // Remove a value that has not expired.
+      auto it = handles.lower_bound(random() % (i + 1));
+      if (it != handles.end()) {
+        auto range = deadlines.equal_range(it->second.first);
+        for (auto d = range.first; d != range.second; ++d) {
+          if (d->second == it->first) {
+            deadlines.erase(d);
+            break;
+          }
+        }
+        wheel.remove(it->second.second);
+        handles.erase(it);
+      }
+    }
+    if (random() % 8 == 0) {
+      now += random() % (1ULL << (random() % 26));
+      expired.clear();
+      wheel.advance(now, expired);
+      std::vector<int> expected;
+      while (!deadlines.empty() && deadlines.begin()->first < now) {
+        expected.push_back(deadlines.begin()->second);
+        handles.erase(deadlines.begin()->second);
+        deadlines.erase(deadlines.begin());
+      }
+      std::sort(expired.begin(), expired.end());
+      std::sort(expected.begin(), expected.end());
+      ASSERT_EQ(expected, expired);
+      ASSERT_EQ(deadlines.size(), wheel.getSize());
+    }
+  }
+}